@@ -0,0 +1,91 @@
+#include "Strazzle/StringArena.h"
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+// A request worth of fields, (offset, length) into one buffer
+static std::pair<std::string, std::vector<std::pair<std::size_t, std::size_t>>> MakeRequest(std::size_t field_c) {
+    std::string                                      buffer;
+    std::vector<std::pair<std::size_t, std::size_t>> fields;
+
+    for(std::size_t i = 0; i < field_c; i++) {
+        std::size_t len = 8 + (i * 13) % 120;
+
+        fields.push_back({buffer.size(), len});
+
+        buffer.append(len, static_cast<char>('a' + i % 26));
+    }
+
+    return {buffer, fields};
+}
+
+static void BM_RequestMalloc(benchmark::State& state) {
+    auto [buffer, fields] = MakeRequest(state.range(0));
+
+    for(auto _ : state) {
+        std::vector<Strazzle::String> strs;
+
+        strs.reserve(fields.size());
+
+        for(auto [off, len] : fields) {
+            strs.emplace_back(buffer.data() + off, len);
+        }
+
+        benchmark::DoNotOptimize(strs.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * fields.size());
+}
+BENCHMARK(BM_RequestMalloc)->Arg(64)->Arg(1024);
+
+static void BM_RequestArena(benchmark::State& state) {
+    auto [buffer, fields] = MakeRequest(state.range(0));
+
+    Strazzle::StringArena arena;
+
+    for(auto _ : state) {
+        std::vector<Strazzle::ArenaString> strs;
+
+        strs.reserve(fields.size());
+
+        for(auto [off, len] : fields) {
+            strs.emplace_back(buffer.data() + off, len, Strazzle::ArenaAllocator(arena));
+        }
+
+        benchmark::DoNotOptimize(strs.data());
+
+        strs.clear();
+
+        arena.Reset();
+    }
+
+    state.SetItemsProcessed(state.iterations() * fields.size());
+}
+BENCHMARK(BM_RequestArena)->Arg(64)->Arg(1024);
+
+static void BM_RequestArenaBatch(benchmark::State& state) {
+    auto [buffer, fields] = MakeRequest(state.range(0));
+
+    std::vector<std::pair<const char*, std::size_t>> pairs;
+
+    for(auto [off, len] : fields) {
+        pairs.push_back({buffer.data() + off, len});
+    }
+
+    Strazzle::StringArena arena;
+
+    for(auto _ : state) {
+        std::vector<Strazzle::ArenaString> strs = arena.MakeStrings(pairs);
+
+        benchmark::DoNotOptimize(strs.data());
+
+        strs.clear();
+
+        arena.Reset();
+    }
+
+    state.SetItemsProcessed(state.iterations() * fields.size());
+}
+BENCHMARK(BM_RequestArenaBatch)->Arg(64)->Arg(1024);
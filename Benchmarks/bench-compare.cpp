@@ -0,0 +1,110 @@
+#include "Strazzle/String.h"
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Two equal strings of size bytes except for the last byte, so the whole string has to be compared
+ */
+static std::pair<std::string, std::string> MakePair(std::size_t size) {
+    std::string a(size, 'k');
+    std::string b(size, 'k');
+
+    b.back() = 'l';
+
+    return {a, b};
+}
+
+static void BM_StringCompare(benchmark::State& state) {
+    auto [a, b] = MakePair(state.range(0));
+
+    Strazzle::String str_a;
+    Strazzle::String str_b;
+
+    str_a.AppendRaw(a.data(), a.size());
+    str_b.AppendRaw(b.data(), b.size());
+
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(str_a.Compare(str_b));
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StringCompare)->Arg(8)->Arg(15)->Arg(64)->Arg(1024)->Arg(1 << 20);
+
+static void BM_StdStringCompare(benchmark::State& state) {
+    auto [a, b] = MakePair(state.range(0));
+
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(a.compare(b));
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StdStringCompare)->Arg(8)->Arg(15)->Arg(64)->Arg(1024)->Arg(1 << 20);
+
+static void BM_StringEqualsDifferentLength(benchmark::State& state) {
+    Strazzle::String str_a(std::string(state.range(0), 'k').c_str());
+    Strazzle::String str_b(std::string(state.range(0) + 1, 'k').c_str());
+
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(str_a == str_b);
+    }
+}
+BENCHMARK(BM_StringEqualsDifferentLength)->Arg(8)->Arg(1 << 20);
+
+// Sorting short keys, most of the time goes to the comparisons
+static std::vector<std::string> MakeKeys(std::size_t count, std::size_t max_len) {
+    std::mt19937             rng(1);
+    std::vector<std::string> keys;
+
+    for(std::size_t k = 0; k < count; k++) {
+        std::string key(1 + rng() % max_len, 'a');
+
+        for(char& c : key) {
+            c = 'a' + rng() % 4;
+        }
+
+        keys.push_back(key);
+    }
+
+    return keys;
+}
+
+static void BM_StringSort(benchmark::State& state) {
+    std::vector<Strazzle::String> keys;
+
+    for(const std::string& key : MakeKeys(4096, state.range(0))) {
+        keys.emplace_back(key.c_str());
+    }
+
+    for(auto _ : state) {
+        state.PauseTiming();
+        std::vector<Strazzle::String> copy(keys);
+        state.ResumeTiming();
+
+        std::sort(copy.begin(), copy.end());
+
+        benchmark::DoNotOptimize(copy.data());
+    }
+}
+BENCHMARK(BM_StringSort)->Arg(15)->Arg(64);
+
+static void BM_StdStringSort(benchmark::State& state) {
+    std::vector<std::string> keys = MakeKeys(4096, state.range(0));
+
+    for(auto _ : state) {
+        state.PauseTiming();
+        std::vector<std::string> copy(keys);
+        state.ResumeTiming();
+
+        std::sort(copy.begin(), copy.end());
+
+        benchmark::DoNotOptimize(copy.data());
+    }
+}
+BENCHMARK(BM_StdStringSort)->Arg(15)->Arg(64);
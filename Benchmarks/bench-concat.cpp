@@ -0,0 +1,76 @@
+#include "Strazzle/String.h"
+
+#include <benchmark/benchmark.h>
+#include <string>
+
+namespace {
+// Counts the heap buffers the strings allocate or grow
+struct CountingAllocator : Strazzle::MallocAllocator {
+    static inline std::size_t allocations = 0;
+
+    char* Allocate(std::size_t size) {
+        allocations = allocations + 1;
+
+        return Strazzle::MallocAllocator::Allocate(size);
+    }
+
+    char* Reallocate(char* p, std::size_t old_size, std::size_t new_size) {
+        allocations = allocations + 1;
+
+        return Strazzle::MallocAllocator::Reallocate(p, old_size, new_size);
+    }
+};
+
+using CountingString = Strazzle::BasicString<CountingAllocator>;
+} // namespace
+
+// Builds a 16 fragment response line with a chain of Append calls, the buffer grows one power of two at a time
+static void BM_ResponseAppend(benchmark::State& state) {
+    CountingString method("GET"), path("/api/v1/orders/00000017/items"), status("200"), body("{\"items\":[1,2,3,4,5,6,7,8]}");
+
+    CountingAllocator::allocations = 0;
+
+    for(auto _ : state) {
+        CountingString line;
+
+        line.Append(method).Append(" ").Append(path).Append(" HTTP/1.1 ").Append(status).Append(" OK\r\n");
+        line.Append("Content-Type: application/json\r\n").Append("Content-Length: 27\r\n").Append("Connection: keep-alive\r\n");
+        line.Append("Cache-Control: no-cache\r\n").Append("X-Request-Id: 7f3a9c\r\n").Append("\r\n").Append(body);
+
+        benchmark::DoNotOptimize(line.Data());
+    }
+
+    state.counters["allocations"] = benchmark::Counter(CountingAllocator::allocations, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_ResponseAppend);
+
+// Same line with operator+, the length is summed first so the buffer is allocated once
+static void BM_ResponseConcat(benchmark::State& state) {
+    CountingString method("GET"), path("/api/v1/orders/00000017/items"), status("200"), body("{\"items\":[1,2,3,4,5,6,7,8]}");
+
+    CountingAllocator::allocations = 0;
+
+    for(auto _ : state) {
+        CountingString line = method + " " + path + " HTTP/1.1 " + status + " OK\r\n" + "Content-Type: application/json\r\n" +
+                              "Content-Length: 27\r\n" + "Connection: keep-alive\r\n" + "Cache-Control: no-cache\r\n" +
+                              "X-Request-Id: 7f3a9c\r\n" + "\r\n" + body;
+
+        benchmark::DoNotOptimize(line.Data());
+    }
+
+    state.counters["allocations"] = benchmark::Counter(CountingAllocator::allocations, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_ResponseConcat);
+
+static void BM_ResponseStdConcat(benchmark::State& state) {
+    std::string method("GET"), path("/api/v1/orders/00000017/items"), status("200"), body("{\"items\":[1,2,3,4,5,6,7,8]}");
+
+    for(auto _ : state) {
+        std::string line = method + " " + path + " HTTP/1.1 " + status + " OK\r\n" + "Content-Type: application/json\r\n" +
+                           "Content-Length: 27\r\n" + "Connection: keep-alive\r\n" + "Cache-Control: no-cache\r\n" +
+                           "X-Request-Id: 7f3a9c\r\n" + "\r\n" + body;
+
+        benchmark::DoNotOptimize(line.data());
+    }
+}
+BENCHMARK(BM_ResponseStdConcat);
@@ -0,0 +1,65 @@
+#include "Strazzle/String.h"
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+
+// Fans one payload out to 16 consumers that only read it
+template<typename StringType>
+static void BM_FanOut(benchmark::State& state) {
+    StringType payload(std::string(state.range(0), 'f').c_str());
+
+    std::vector<StringType> consumers(16);
+
+    for(auto _ : state) {
+        for(StringType& consumer : consumers) {
+            consumer = payload;
+        }
+
+        benchmark::DoNotOptimize(consumers.back().Data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * consumers.size());
+}
+BENCHMARK(BM_FanOut<Strazzle::String>)->Arg(256)->Arg(4096)->Arg(1 << 16);
+BENCHMARK(BM_FanOut<Strazzle::CowString>)->Arg(256)->Arg(4096)->Arg(1 << 16);
+
+// Fans one payload out to 16 consumers that each modify their copy, copy-on-write only delays the copy
+template<typename StringType>
+static void BM_FanOutMutate(benchmark::State& state) {
+    StringType payload(std::string(state.range(0), 'f').c_str());
+
+    std::vector<StringType> consumers(16);
+
+    for(auto _ : state) {
+        for(StringType& consumer : consumers) {
+            consumer = payload;
+
+            consumer.Append("!");
+        }
+
+        benchmark::DoNotOptimize(consumers.back().Data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * consumers.size());
+}
+BENCHMARK(BM_FanOutMutate<Strazzle::String>)->Arg(256)->Arg(4096)->Arg(1 << 16);
+BENCHMARK(BM_FanOutMutate<Strazzle::CowString>)->Arg(256)->Arg(4096)->Arg(1 << 16);
+
+// Appends to a string that is never shared, what the reference count check costs every mutation
+template<typename StringType>
+static void BM_AppendUnshared(benchmark::State& state) {
+    for(auto _ : state) {
+        StringType str;
+
+        for(std::size_t i = 0; i < 1024; i++) {
+            str.Append("abcdefgh");
+        }
+
+        benchmark::DoNotOptimize(str.Data());
+    }
+
+    state.SetBytesProcessed(state.iterations() * 1024 * 8);
+}
+BENCHMARK(BM_AppendUnshared<Strazzle::String>);
+BENCHMARK(BM_AppendUnshared<Strazzle::CowString>);
@@ -0,0 +1,67 @@
+#include "Strazzle/EditBatch.h"
+
+#include <benchmark/benchmark.h>
+#include <string>
+
+/**
+ * @brief A 64KB template with the given number of evenly spread {{placeholder}}s
+ */
+static std::string MakeTemplate(std::size_t placeholders) {
+    std::string payload(1 << 16, 't');
+
+    std::size_t step = payload.size() / placeholders;
+
+    for(std::size_t k = 0; k < placeholders; k++) {
+        payload.replace(k * step, 15, "{{placeholder}}");
+    }
+
+    return payload;
+}
+
+// Substitutes every placeholder with Erase and Insert, each edit moves the tail of the payload
+static void BM_SubstituteInPlace(benchmark::State& state) {
+    std::string payload = MakeTemplate(state.range(0));
+
+    std::size_t step = payload.size() / state.range(0);
+
+    for(auto _ : state) {
+        Strazzle::String str(payload.c_str());
+
+        // Back to front so the offsets of the remaining placeholders don't move
+        for(std::size_t k = state.range(0); k > 0; k--) {
+            str.Erase((k - 1) * step, 15);
+            str.Insert("value-42", (k - 1) * step);
+        }
+
+        benchmark::DoNotOptimize(str.Data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SubstituteInPlace)->Arg(16)->Arg(256)->Arg(2048);
+
+// Same substitutions collected in an EditBatch and applied in one pass
+static void BM_SubstituteBatch(benchmark::State& state) {
+    std::string payload = MakeTemplate(state.range(0));
+
+    std::size_t step = payload.size() / state.range(0);
+
+    Strazzle::EditBatch batch;
+
+    for(auto _ : state) {
+        Strazzle::String str(payload.c_str());
+
+        batch.Clear();
+
+        for(std::size_t k = 0; k < static_cast<std::size_t>(state.range(0)); k++) {
+            batch.Replace(k * step, 15, "value-42");
+        }
+
+        batch.Apply(str);
+
+        benchmark::DoNotOptimize(str.Data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SubstituteBatch)->Arg(16)->Arg(256)->Arg(2048);
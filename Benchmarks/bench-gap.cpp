@@ -0,0 +1,58 @@
+#include "Strazzle/GapString.h"
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <string>
+
+// Types 4096 chars one at a time into the middle of a 64KB document with a backspace every 8 chars, the text is read every 512 edits
+template<typename StringType>
+static void BM_Typing(benchmark::State& state) {
+    std::string doc(1 << 16, 'd');
+
+    for(auto _ : state) {
+        StringType str(doc.c_str());
+
+        std::size_t cursor = doc.size() / 2;
+
+        for(std::size_t k = 0; k < 4096; k++) {
+            if(k % 8 == 7) {
+                cursor = cursor - 1;
+
+                str.Erase(cursor, 1);
+            } else {
+                str.InsertRaw("k", cursor, 1);
+
+                cursor = cursor + 1;
+            }
+
+            if(k % 512 == 511) benchmark::DoNotOptimize(str.Cstr());
+        }
+
+        benchmark::DoNotOptimize(str.Cstr());
+    }
+
+    state.SetItemsProcessed(state.iterations() * 4096);
+}
+BENCHMARK(BM_Typing<Strazzle::String>);
+BENCHMARK(BM_Typing<Strazzle::GapString>);
+
+// Inserts at random positions, the gap string stays contiguous and should cost the same as a String
+template<typename StringType>
+static void BM_RandomInserts(benchmark::State& state) {
+    std::string doc(1 << 16, 'd');
+
+    for(auto _ : state) {
+        StringType   str(doc.c_str());
+        std::mt19937 rng(11);
+
+        for(std::size_t k = 0; k < 1024; k++) {
+            str.InsertRaw("random", rng() % str.Len(), 6);
+        }
+
+        benchmark::DoNotOptimize(str.Cstr());
+    }
+
+    state.SetItemsProcessed(state.iterations() * 1024);
+}
+BENCHMARK(BM_RandomInserts<Strazzle::String>);
+BENCHMARK(BM_RandomInserts<Strazzle::GapString>);
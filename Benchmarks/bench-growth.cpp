@@ -0,0 +1,36 @@
+#include "Strazzle/String.h"
+
+#include <benchmark/benchmark.h>
+#include <string>
+
+// Allocator without Reallocate, every growth step is a malloc + memcpy + free
+struct CopyingAllocator {
+    char* Allocate(std::size_t size) {
+        return static_cast<char*>(malloc(size));
+    }
+
+    void Deallocate(char* p, [[maybe_unused]] std::size_t size) {
+        free(p);
+    }
+};
+
+template<typename Allocator>
+static void BM_AppendGrowth(benchmark::State& state) {
+    std::string chunk(4096 - 1, 'a');
+
+    std::size_t target = state.range(0);
+
+    for(auto _ : state) {
+        Strazzle::BasicString<Allocator> str;
+
+        while(str.Len() < target) {
+            str.Append(chunk.c_str());
+        }
+
+        benchmark::DoNotOptimize(str.Cstr());
+    }
+
+    state.SetBytesProcessed(state.iterations() * target);
+}
+BENCHMARK(BM_AppendGrowth<CopyingAllocator>)->Arg(1 << 20)->Arg(1 << 24)->Arg(1 << 28)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_AppendGrowth<Strazzle::MallocAllocator>)->Arg(1 << 20)->Arg(1 << 24)->Arg(1 << 28)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,92 @@
+#include "Strazzle/String.h"
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+static void BM_StringHash(benchmark::State& state) {
+    std::string bytes(state.range(0), 'h');
+
+    Strazzle::String str;
+
+    str.AppendRaw(bytes.data(), bytes.size());
+
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(str.Hash());
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StringHash)->Arg(4)->Arg(15)->Arg(32)->Arg(64)->Arg(1024)->Arg(1 << 20);
+
+static void BM_StdHash(benchmark::State& state) {
+    std::string str(state.range(0), 'h');
+
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(std::hash<std::string_view>()(str));
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StdHash)->Arg(4)->Arg(15)->Arg(32)->Arg(64)->Arg(1024)->Arg(1 << 20);
+
+static std::vector<std::string> MakeKeys(std::size_t count, std::size_t len) {
+    std::mt19937             rng(3);
+    std::vector<std::string> keys;
+
+    for(std::size_t k = 0; k < count; k++) {
+        std::string key(len, 'a');
+
+        for(char& c : key) {
+            c = 'a' + rng() % 26;
+        }
+
+        keys.push_back(key);
+    }
+
+    return keys;
+}
+
+// Lookups in a hash table of 64k keys, a hit per lookup
+static void BM_StringMapLookup(benchmark::State& state) {
+    std::vector<std::string> keys = MakeKeys(1 << 16, state.range(0));
+
+    std::unordered_map<Strazzle::String, int> map;
+    std::vector<Strazzle::String>             lookups;
+
+    for(const std::string& key : keys) {
+        map.emplace(Strazzle::String(key.c_str()), 0);
+        lookups.emplace_back(key.c_str());
+    }
+
+    std::size_t i = 0;
+
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(map.find(lookups[i & 0xFFFF]));
+
+        i = i + 1;
+    }
+}
+BENCHMARK(BM_StringMapLookup)->Arg(12)->Arg(48);
+
+static void BM_StdStringMapLookup(benchmark::State& state) {
+    std::vector<std::string> keys = MakeKeys(1 << 16, state.range(0));
+
+    std::unordered_map<std::string, int> map;
+
+    for(const std::string& key : keys) {
+        map.emplace(key, 0);
+    }
+
+    std::size_t i = 0;
+
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(map.find(keys[i & 0xFFFF]));
+
+        i = i + 1;
+    }
+}
+BENCHMARK(BM_StdStringMapLookup)->Arg(12)->Arg(48);
@@ -0,0 +1,56 @@
+#include "Strazzle/InplaceString.h"
+
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <string>
+
+// Builds a 34 byte key from three protocol fields, too long for the SSO buffer of a String
+template<typename StringType>
+static void BM_BuildKey(benchmark::State& state) {
+    for(auto _ : state) {
+        StringType key;
+
+        key.Append("tenant-0042:");
+        key.Append("order-00000017:");
+        key.Append("status");
+
+        benchmark::DoNotOptimize(key.Cstr());
+    }
+}
+BENCHMARK(BM_BuildKey<Strazzle::InplaceString<48>>);
+BENCHMARK(BM_BuildKey<Strazzle::String>);
+
+static void BM_BuildStdKey(benchmark::State& state) {
+    for(auto _ : state) {
+        std::string key;
+
+        key.append("tenant-0042:");
+        key.append("order-00000017:");
+        key.append("status");
+
+        benchmark::DoNotOptimize(key.c_str());
+    }
+}
+BENCHMARK(BM_BuildStdKey);
+
+// Passes keys through a ring of slots like a lock-free queue would, an InplaceString is copied with a single memcpy
+static void BM_RingCopy(benchmark::State& state) {
+    Strazzle::InplaceString<48> key("tenant-0042:order-00000017:status");
+
+    alignas(64) static char ring[64][sizeof(key)];
+
+    std::size_t i = 0;
+
+    for(auto _ : state) {
+        std::memcpy(ring[i & 63], &key, sizeof(key));
+
+        Strazzle::InplaceString<48> out;
+
+        std::memcpy(&out, ring[i & 63], sizeof(out));
+
+        benchmark::DoNotOptimize(out.Cstr());
+
+        i = i + 1;
+    }
+}
+BENCHMARK(BM_RingCopy);
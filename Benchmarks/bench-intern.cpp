@@ -0,0 +1,75 @@
+#include "Strazzle/StringInterner.h"
+
+#include <benchmark/benchmark.h>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Low cardinality labels (like header names), interned over and over
+static std::vector<std::string> MakeLabels() {
+    std::vector<std::string> labels;
+
+    for(std::size_t i = 0; i < 256; i++) {
+        labels.push_back("x-label-" + std::to_string(i));
+    }
+
+    return labels;
+}
+
+static Strazzle::StringInterner& GetInterner() {
+    static Strazzle::StringInterner interner;
+
+    return interner;
+}
+
+static void BM_InternerIntern(benchmark::State& state) {
+    static const std::vector<std::string> labels = MakeLabels();
+
+    Strazzle::StringInterner& interner = GetInterner();
+
+    std::size_t i = state.thread_index();
+
+    for(auto _ : state) {
+        const std::string& label = labels[i & 0xFF];
+
+        benchmark::DoNotOptimize(interner.Intern(label.data(), label.size()));
+
+        i = i + 1;
+    }
+}
+BENCHMARK(BM_InternerIntern)->Threads(1)->Threads(2)->Threads(4)->UseRealTime();
+
+// What the interner replaces, one map behind one mutex
+static void BM_MutexMapIntern(benchmark::State& state) {
+    static const std::vector<std::string> labels = MakeLabels();
+
+    static std::mutex                                mutex;
+    static std::unordered_map<std::string, uint32_t> map;
+
+    std::size_t i = state.thread_index();
+
+    for(auto _ : state) {
+        const std::string& label = labels[i & 0xFF];
+
+        std::lock_guard lock(mutex);
+
+        benchmark::DoNotOptimize(map.try_emplace(label, static_cast<uint32_t>(map.size())).first->second);
+
+        i = i + 1;
+    }
+}
+BENCHMARK(BM_MutexMapIntern)->Threads(1)->Threads(2)->Threads(4)->UseRealTime();
+
+// Equality of interned strings is an integer compare
+static void BM_AtomEquals(benchmark::State& state) {
+    Strazzle::StringInterner& interner = GetInterner();
+
+    Strazzle::Atom a = interner.Intern("content-type-with-a-long-name");
+    Strazzle::Atom b = interner.Intern("content-type-with-a-long-nama");
+
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(a == b);
+    }
+}
+BENCHMARK(BM_AtomEquals);
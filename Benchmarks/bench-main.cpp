@@ -0,0 +1,14 @@
+#include <benchmark/benchmark.h>
+
+int main(int argc, char** argv) {
+    // Initialize Google Benchmark
+    ::benchmark::Initialize(&argc, argv);
+
+    if(::benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+
+    // Run all the benchmarks
+    ::benchmark::RunSpecifiedBenchmarks();
+    ::benchmark::Shutdown();
+
+    return 0;
+}
@@ -0,0 +1,115 @@
+#include "Strazzle/MultiMatcher.h"
+#include "Strazzle/String.h"
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Random lower case keywords of 4 to 12 chars
+ */
+static std::vector<std::string> MakeKeywords(std::size_t count) {
+    std::mt19937             rng(42);
+    std::vector<std::string> keywords;
+
+    for(std::size_t k = 0; k < count; k++) {
+        std::string keyword(4 + rng() % 9, 'a');
+
+        for(char& c : keyword) {
+            c = 'a' + rng() % 26;
+        }
+
+        keywords.push_back(keyword);
+    }
+
+    return keywords;
+}
+
+/**
+ * @brief A log line of random words that contains a keyword every few hundred bytes
+ */
+static Strazzle::String MakeLine(std::size_t size, const std::vector<std::string>& keywords) {
+    std::mt19937     rng(7);
+    Strazzle::String line;
+
+    while(line.Len() < size) {
+        if(rng() % 40 == 0) {
+            line.Append(keywords[rng() % keywords.size()].c_str());
+        } else {
+            for(std::size_t i = 3 + rng() % 6; i > 0; i--) {
+                line.Append(std::string(1, 'a' + rng() % 26).c_str());
+            }
+        }
+
+        line.Append(" ");
+    }
+
+    return line;
+}
+
+static void BM_MultiMatcher(benchmark::State& state) {
+    std::vector<std::string> keywords = MakeKeywords(state.range(0));
+
+    std::vector<std::pair<const char*, std::size_t>> patterns;
+
+    for(const std::string& keyword : keywords) {
+        patterns.emplace_back(keyword.data(), keyword.size());
+    }
+
+    Strazzle::MultiMatcher matcher(patterns);
+
+    Strazzle::String line = MakeLine(state.range(1), keywords);
+
+    for(auto _ : state) {
+        std::size_t matches = 0;
+
+        matcher.ForEachMatch(line, [&](const Strazzle::MultiMatcher::Match&) {
+            matches = matches + 1;
+
+            return true;
+        });
+
+        benchmark::DoNotOptimize(matches);
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(1));
+}
+BENCHMARK(BM_MultiMatcher)->ArgsProduct({{16, 256, 4096}, {256, 1 << 16}});
+
+// N single pattern searches, what the matcher replaces
+static void BM_FindEachKeyword(benchmark::State& state) {
+    std::vector<std::string> keywords = MakeKeywords(state.range(0));
+
+    Strazzle::String line = MakeLine(state.range(1), keywords);
+
+    for(auto _ : state) {
+        std::size_t matches = 0;
+
+        for(const std::string& keyword : keywords) {
+            matches = matches + line.Count(keyword.c_str());
+        }
+
+        benchmark::DoNotOptimize(matches);
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(1));
+}
+BENCHMARK(BM_FindEachKeyword)->ArgsProduct({{16, 256, 4096}, {256, 1 << 16}});
+
+// Few keywords with rare first chars, the scan skips between candidates with the SIMD prefilter
+static void BM_MultiMatcherPrefilter(benchmark::State& state) {
+    Strazzle::MultiMatcher matcher{"ERROR", "FATAL", "WARN"};
+
+    // The line is lower case, so the whole line is scanned
+    std::vector<std::string> keywords = {"error"};
+
+    Strazzle::String line = MakeLine(state.range(0), keywords);
+
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(matcher.Contains(line));
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MultiMatcherPrefilter)->Arg(256)->Arg(1 << 16);
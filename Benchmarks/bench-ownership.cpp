@@ -0,0 +1,89 @@
+#include "Strazzle/String.h"
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+
+static Strazzle::String MakeString(const std::string& src) {
+    Strazzle::String str(src.c_str());
+
+    return str;
+}
+
+static void BM_ReturnByValue(benchmark::State& state) {
+    std::string src(state.range(0), 'a');
+
+    for(auto _ : state) {
+        Strazzle::String str = MakeString(src);
+
+        benchmark::DoNotOptimize(str.Cstr());
+    }
+}
+BENCHMARK(BM_ReturnByValue)->Arg(8)->Arg(64)->Arg(1024)->Arg(64 * 1024);
+
+static void BM_MoveAssign(benchmark::State& state) {
+    std::string src(state.range(0), 'a');
+
+    Strazzle::String a(src.c_str());
+    Strazzle::String b;
+
+    for(auto _ : state) {
+        b = std::move(a);
+        a = std::move(b);
+
+        benchmark::DoNotOptimize(a.Cstr());
+    }
+}
+BENCHMARK(BM_MoveAssign)->Arg(8)->Arg(64)->Arg(1024)->Arg(64 * 1024);
+
+static void BM_VectorPushBack(benchmark::State& state) {
+    std::string src(state.range(0), 'a');
+
+    for(auto _ : state) {
+        std::vector<Strazzle::String> vec;
+
+        for(int i = 0; i < 1024; i++) {
+            vec.push_back(Strazzle::String(src.c_str()));
+        }
+
+        benchmark::DoNotOptimize(vec.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * 1024);
+}
+BENCHMARK(BM_VectorPushBack)->Arg(8)->Arg(64)->Arg(1024);
+
+static void BM_SubstrLvalue(benchmark::State& state) {
+    std::string src(state.range(0), 'a');
+
+    for(auto _ : state) {
+        Strazzle::String str(src.c_str());
+
+        Strazzle::String sub = str.Substr(1).Substr(1);
+
+        benchmark::DoNotOptimize(sub.Cstr());
+    }
+}
+BENCHMARK(BM_SubstrLvalue)->Arg(64)->Arg(1024)->Arg(64 * 1024);
+
+static void BM_SubstrRvalueChain(benchmark::State& state) {
+    std::string src(state.range(0), 'a');
+
+    for(auto _ : state) {
+        Strazzle::String sub = Strazzle::String(src.c_str()).Substr(1).Substr(1);
+
+        benchmark::DoNotOptimize(sub.Cstr());
+    }
+}
+BENCHMARK(BM_SubstrRvalueChain)->Arg(64)->Arg(1024)->Arg(64 * 1024);
+
+static void BM_AppendRvalueChain(benchmark::State& state) {
+    std::string src(state.range(0), 'a');
+
+    for(auto _ : state) {
+        Strazzle::String str = Strazzle::String(src.c_str()).Append("foo").Append("bar").Append(src.c_str());
+
+        benchmark::DoNotOptimize(str.Cstr());
+    }
+}
+BENCHMARK(BM_AppendRvalueChain)->Arg(8)->Arg(64)->Arg(1024);
@@ -0,0 +1,87 @@
+#include "Strazzle/PieceTable.h"
+
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <random>
+#include <string>
+
+/**
+ * @brief Path of a 64MB file shared by the benchmarks, created on first use
+ */
+static const char* BigFile() {
+    static const char* path = [] {
+        const char* p = "/tmp/strazzle-bench-piecetable.txt";
+
+        FILE*       file = fopen(p, "wb");
+        std::string line(1023, 'l');
+
+        line.push_back('\n');
+
+        for(std::size_t k = 0; k < (1 << 16); k++) {
+            fwrite(line.data(), 1, line.size(), file);
+        }
+
+        fclose(file);
+
+        return p;
+    }();
+
+    return path;
+}
+
+// Opens the file as a piece table, only the mapping is set up
+static void BM_OpenPieceTable(benchmark::State& state) {
+    const char* path = BigFile();
+
+    for(auto _ : state) {
+        Strazzle::PieceTable table(path);
+
+        benchmark::DoNotOptimize(table.Len());
+    }
+}
+BENCHMARK(BM_OpenPieceTable);
+
+// Loads the file into a String in 64KB chunks, the buffer grows one power of two at a time
+static void BM_LoadString(benchmark::State& state) {
+    const char* path = BigFile();
+
+    static char buffer[1 << 16];
+
+    for(auto _ : state) {
+        Strazzle::String str;
+
+        FILE* file = fopen(path, "rb");
+
+        for(std::size_t n; (n = fread(buffer, 1, sizeof(buffer), file)) != 0;) {
+            str.AppendRaw(buffer, n);
+        }
+
+        fclose(file);
+
+        benchmark::DoNotOptimize(str.Data());
+    }
+}
+BENCHMARK(BM_LoadString)->Unit(benchmark::kMillisecond);
+
+// Makes state.range(0) random inserts and erasures in the opened file
+static void BM_EditPieceTable(benchmark::State& state) {
+    const char* path = BigFile();
+
+    for(auto _ : state) {
+        Strazzle::PieceTable table(path);
+        std::mt19937         rng(13);
+
+        for(int64_t k = 0; k < state.range(0); k++) {
+            if(k % 2 == 0) {
+                table.Insert("edit", rng() % table.Len());
+            } else {
+                table.Erase(rng() % table.Len(), 16);
+            }
+        }
+
+        benchmark::DoNotOptimize(table.Len());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EditPieceTable)->Arg(64)->Arg(1024);
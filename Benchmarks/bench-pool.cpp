@@ -0,0 +1,60 @@
+#include "Strazzle/StringPool.h"
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+
+template<typename StringType>
+static void BM_Churn(benchmark::State& state) {
+    // 32-512 byte strings, all of them end up as LARGE_STRING
+    std::vector<std::string> sources;
+
+    for(std::size_t len = 32; len <= 512; len = len * 2) {
+        sources.push_back(std::string(len - 1, 'a'));
+    }
+
+    std::vector<StringType> live(64);
+
+    std::size_t i = 0;
+
+    for(auto _ : state) {
+        live[i % live.size()] = StringType(sources[i % sources.size()].c_str());
+
+        benchmark::DoNotOptimize(live[i % live.size()].Cstr());
+
+        i++;
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Churn<Strazzle::String>)->Threads(1)->Threads(4);
+BENCHMARK(BM_Churn<Strazzle::PooledString>)->Threads(1)->Threads(4);
+
+static void BM_PoolHitRate(benchmark::State& state) {
+    std::vector<Strazzle::PooledString> live(256);
+
+    std::size_t i = 0;
+
+    Strazzle::StringPool::Stats before = Strazzle::StringPool::GetStats();
+
+    for(auto _ : state) {
+        Strazzle::PooledString str;
+
+        str.Resize(32 + (i * 37) % 480);
+
+        live[i % live.size()] = std::move(str);
+
+        i++;
+    }
+
+    Strazzle::StringPool::Stats after = Strazzle::StringPool::GetStats();
+
+    Strazzle::StringPool::Stats delta;
+
+    delta.cache_hits  = after.cache_hits - before.cache_hits;
+    delta.shared_hits = after.shared_hits - before.shared_hits;
+    delta.misses      = after.misses - before.misses;
+
+    state.counters["hit_rate"] = delta.HitRate();
+}
+BENCHMARK(BM_PoolHitRate);
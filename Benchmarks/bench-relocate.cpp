@@ -0,0 +1,40 @@
+#include "Strazzle/String.h"
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+
+// Same string without the relocation trait, std::vector falls back to a move and a destructor call per element
+struct MovedString : Strazzle::String {
+    using Strazzle::String::BasicString;
+};
+
+// Grows a full vector of strings of 0-47 bytes, only the reallocation is timed
+template<typename StringType>
+static void BM_VectorGrowth(benchmark::State& state) {
+    std::size_t count = state.range(0);
+
+    std::vector<StringType> strs;
+
+    for(auto _ : state) {
+        state.PauseTiming();
+        strs = std::vector<StringType>();
+        strs.reserve(count);
+
+        for(std::size_t i = 0; i < count; i++) {
+            strs.emplace_back(std::string(i % 48, 'r').c_str());
+        }
+        state.ResumeTiming();
+
+        strs.reserve(count * 2);
+
+        benchmark::DoNotOptimize(strs.data());
+    }
+
+    state.counters["object_bytes"] = sizeof(StringType);
+
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_VectorGrowth<Strazzle::String>)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK(BM_VectorGrowth<MovedString>)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK(BM_VectorGrowth<std::string>)->Arg(1 << 10)->Arg(1 << 16);
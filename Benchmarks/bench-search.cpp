@@ -0,0 +1,146 @@
+#include "Strazzle/String.h"
+
+#include <benchmark/benchmark.h>
+#include <string>
+
+// Haystacks from the SSO size up to a gigabyte, needles from 1 to 64 bytes
+static void SearchArgs(benchmark::internal::Benchmark* bench) {
+    for(int64_t size : {int64_t(16), int64_t(256), int64_t(4096), int64_t(1) << 16, int64_t(1) << 20, int64_t(1) << 24, int64_t(1) << 30}) {
+        for(int64_t needle_size : {1, 2, 4, 8, 16, 32, 64}) {
+            if(needle_size <= size) bench->Args({size, needle_size});
+        }
+    }
+}
+
+/**
+ * @brief Text that contains the first and last char of the needle every 7 bytes but the needle only at its very end
+ */
+static std::string MakeHaystack(std::size_t size, const std::string& needle) {
+    std::string haystack(size, 'a');
+
+    for(std::size_t i = 0; i < size; i += 7) {
+        haystack[i] = 'b';
+    }
+
+    haystack.replace(size - needle.size(), needle.size(), needle);
+
+    return haystack;
+}
+
+static std::string MakeNeedle(std::size_t size) {
+    std::string needle(size, 'c');
+
+    needle.front() = 'b';
+    needle.back()  = 'b';
+
+    return size == 1 ? std::string("c") : needle;
+}
+
+static void BM_StringFind(benchmark::State& state) {
+    std::string needle   = MakeNeedle(state.range(1));
+    std::string haystack = MakeHaystack(state.range(0), needle);
+
+    Strazzle::String str;
+
+    str.AppendRaw(haystack.data(), haystack.size());
+
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(str.Find(needle.c_str()));
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StringFind)->Apply(SearchArgs);
+
+static void BM_StdStringFind(benchmark::State& state) {
+    std::string needle   = MakeNeedle(state.range(1));
+    std::string haystack = MakeHaystack(state.range(0), needle);
+
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(haystack.find(needle));
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StdStringFind)->Apply(SearchArgs);
+
+static void BM_StringRFind(benchmark::State& state) {
+    std::string needle   = MakeNeedle(state.range(1));
+    std::string haystack = MakeHaystack(state.range(0), needle);
+
+    // Put the only match at the front so the whole haystack is scanned backwards
+    haystack.replace(haystack.size() - needle.size(), needle.size(), std::string(needle.size(), 'a'));
+    haystack.replace(0, needle.size(), needle);
+
+    Strazzle::String str;
+
+    str.AppendRaw(haystack.data(), haystack.size());
+
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(str.RFind(needle.c_str()));
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StringRFind)->Apply(SearchArgs);
+
+static void BM_StringCount(benchmark::State& state) {
+    std::string needle   = MakeNeedle(state.range(1));
+    std::string haystack = MakeHaystack(state.range(0), needle);
+
+    Strazzle::String str;
+
+    str.AppendRaw(haystack.data(), haystack.size());
+
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(str.Count(needle.c_str()));
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StringCount)->Apply(SearchArgs);
+
+// The kernels of every instruction set, independent of the one picked for this cpu
+
+template<std::size_t (*Kernel)(const char*, std::size_t, const char*, std::size_t)>
+static void BM_FindKernel(benchmark::State& state) {
+    std::string needle   = MakeNeedle(std::max<int64_t>(state.range(1), 2));
+    std::string haystack = MakeHaystack(state.range(0), needle);
+
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(Kernel(haystack.data(), haystack.size(), needle.data(), needle.size()));
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+static void KernelArgs(benchmark::internal::Benchmark* bench) {
+    for(int64_t size : {int64_t(256), int64_t(1) << 16, int64_t(1) << 24}) {
+        bench->Args({size, 8});
+    }
+}
+
+BENCHMARK(BM_FindKernel<Strazzle::_FindScalar>)->Apply(KernelArgs);
+#ifdef STRAZZLE_SEARCH_X86
+BENCHMARK(BM_FindKernel<Strazzle::_FindSse2>)->Apply(KernelArgs);
+
+static void BM_FindKernelAvx2(benchmark::State& state) {
+    if(!__builtin_cpu_supports("avx2")) {
+        state.SkipWithError("avx2 is not supported");
+        return;
+    }
+
+    BM_FindKernel<Strazzle::_FindAvx2>(state);
+}
+BENCHMARK(BM_FindKernelAvx2)->Apply(KernelArgs);
+
+static void BM_FindKernelAvx512(benchmark::State& state) {
+    if(!__builtin_cpu_supports("avx512bw")) {
+        state.SkipWithError("avx512bw is not supported");
+        return;
+    }
+
+    BM_FindKernel<Strazzle::_FindAvx512>(state);
+}
+BENCHMARK(BM_FindKernelAvx512)->Apply(KernelArgs);
+#endif
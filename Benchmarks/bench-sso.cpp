@@ -0,0 +1,103 @@
+#include "Strazzle/String.h"
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+// Counts the heap buffers the strings allocate
+struct CountingAllocator : Strazzle::MallocAllocator {
+    static inline std::size_t allocations = 0;
+    static inline std::size_t bytes       = 0;
+
+    char* Allocate(std::size_t size) {
+        allocations = allocations + 1;
+        bytes       = bytes + size;
+
+        return Strazzle::MallocAllocator::Allocate(size);
+    }
+};
+
+// Length distributions, the argument of the benchmarks
+enum Distribution : int64_t { SHORT_KEYS = 0, IDENTIFIERS = 1, MIXED = 2 };
+} // namespace
+
+/**
+ * @brief 4096 strings with lengths drawn from a distribution
+ *        SHORT_KEYS: 4-15 bytes, IDENTIFIERS: 20-40 bytes, MIXED: 70% 4-15, 25% 16-48 and 5% 64-256 bytes
+ */
+static std::vector<std::string> MakeStrings(int64_t distribution) {
+    std::mt19937             rng(7);
+    std::vector<std::string> strs;
+
+    for(std::size_t k = 0; k < 4096; k++) {
+        std::size_t len;
+
+        switch(distribution) {
+            case Distribution::SHORT_KEYS:
+                len = 4 + rng() % 12;
+                break;
+            case Distribution::IDENTIFIERS:
+                len = 20 + rng() % 21;
+                break;
+            default: {
+                std::size_t p = rng() % 100;
+
+                len = p < 70 ? 4 + rng() % 12 : p < 95 ? 16 + rng() % 33 : 64 + rng() % 193;
+                break;
+            }
+        }
+
+        strs.push_back(std::string(len, 'a' + k % 26));
+    }
+
+    return strs;
+}
+
+/**
+ * @brief Builds and destroys the strings of a distribution with an SSO buffer of N bytes
+ *        Reports the size of a string object, the heap allocations per string, the allocations avoided compared to the default
+ *        Strazzle::SSO_SIZE and the total bytes per string (object and heap buffer)
+ */
+template<std::size_t N>
+static void BM_SSOSweep(benchmark::State& state) {
+    std::vector<std::string> sources = MakeStrings(state.range(0));
+
+    std::vector<Strazzle::BasicString<CountingAllocator, N>> strs;
+
+    strs.reserve(sources.size());
+
+    std::size_t default_allocations = 0;
+
+    for(const std::string& source : sources) {
+        if(source.size() + 1 > Strazzle::SSO_SIZE) default_allocations = default_allocations + 1;
+    }
+
+    CountingAllocator::allocations = 0;
+    CountingAllocator::bytes       = 0;
+
+    for(auto _ : state) {
+        for(const std::string& source : sources) {
+            strs.emplace_back().AppendRaw(source.data(), source.size());
+        }
+
+        benchmark::DoNotOptimize(strs.data());
+
+        strs.clear();
+    }
+
+    double strings = static_cast<double>(state.iterations() * sources.size());
+
+    state.counters["object_bytes"]        = sizeof(Strazzle::BasicString<CountingAllocator, N>);
+    state.counters["allocs_per_str"]      = CountingAllocator::allocations / strings;
+    state.counters["allocs_avoided"]      = (default_allocations * state.iterations() - static_cast<double>(CountingAllocator::allocations)) / strings;
+    state.counters["total_bytes_per_str"] = sizeof(Strazzle::BasicString<CountingAllocator, N>) + CountingAllocator::bytes / strings;
+
+    state.SetItemsProcessed(state.iterations() * sources.size());
+}
+BENCHMARK(BM_SSOSweep<24>)->Arg(Distribution::SHORT_KEYS)->Arg(Distribution::IDENTIFIERS)->Arg(Distribution::MIXED);
+BENCHMARK(BM_SSOSweep<32>)->Arg(Distribution::SHORT_KEYS)->Arg(Distribution::IDENTIFIERS)->Arg(Distribution::MIXED);
+BENCHMARK(BM_SSOSweep<40>)->Arg(Distribution::SHORT_KEYS)->Arg(Distribution::IDENTIFIERS)->Arg(Distribution::MIXED);
+BENCHMARK(BM_SSOSweep<48>)->Arg(Distribution::SHORT_KEYS)->Arg(Distribution::IDENTIFIERS)->Arg(Distribution::MIXED);
+BENCHMARK(BM_SSOSweep<64>)->Arg(Distribution::SHORT_KEYS)->Arg(Distribution::IDENTIFIERS)->Arg(Distribution::MIXED);
@@ -0,0 +1,246 @@
+#include "Strazzle/String.h"
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+// Heap allocations (including growth) made by either string type
+std::size_t allocations = 0;
+
+// Counts the heap buffers of a Strazzle::String
+struct CountingAllocator : Strazzle::MallocAllocator {
+    char* Allocate(std::size_t size) {
+        allocations = allocations + 1;
+
+        return Strazzle::MallocAllocator::Allocate(size);
+    }
+
+    char* Reallocate(char* p, std::size_t old_size, std::size_t new_size) {
+        allocations = allocations + 1;
+
+        return Strazzle::MallocAllocator::Reallocate(p, old_size, new_size);
+    }
+};
+
+// Counts the heap buffers of a std::string
+template<typename T>
+struct CountingStdAllocator : std::allocator<T> {
+    template<typename U>
+    struct rebind {
+        using other = CountingStdAllocator<U>;
+    };
+
+    CountingStdAllocator() = default;
+
+    template<typename U>
+    CountingStdAllocator(const CountingStdAllocator<U>&) {
+    }
+
+    T* allocate(std::size_t n) {
+        allocations = allocations + 1;
+
+        return std::allocator<T>::allocate(n);
+    }
+};
+
+using StrazzleString = Strazzle::BasicString<CountingAllocator>;
+using StdString      = std::basic_string<char, std::char_traits<char>, CountingStdAllocator<char>>;
+
+// Length distributions, the argument of the benchmarks
+enum Distribution : int64_t { SHORT = 0, MEDIUM = 1, LONG = 2, MIXED = 3 };
+
+// Operations of the suite
+enum class Op { CONSTRUCT, APPEND, INSERT, ERASE, RESIZE, SUBSTR, RESERVE, MODE_TRANSITION };
+
+// Strings per batch, every batch is rebuilt untimed before the operation runs on all of its strings
+const std::size_t BATCH = 1024;
+
+// Bytes of the operand of Append and Insert
+const char PIECE[] = "0123456789abcdefghijklmnopqrstuv";
+} // namespace
+
+/**
+ * @brief BATCH strings with lengths drawn from a distribution
+ *        SHORT: 4-15 bytes, MEDIUM: 16-64 bytes, LONG: 256-4096 bytes, MIXED: 70% SHORT, 25% MEDIUM and 5% LONG
+ */
+static std::vector<std::string> MakeSources(int64_t distribution) {
+    std::mt19937             rng(17);
+    std::vector<std::string> sources;
+
+    for(std::size_t k = 0; k < BATCH; k++) {
+        std::size_t p = rng() % 100;
+
+        if(distribution != Distribution::MIXED) p = distribution == Distribution::SHORT ? 0 : distribution == Distribution::MEDIUM ? 70 : 95;
+
+        std::size_t len = p < 70 ? 4 + rng() % 12 : p < 95 ? 16 + rng() % 49 : 256 + rng() % 3841;
+
+        sources.push_back(std::string(len, 'a' + k % 26));
+    }
+
+    return sources;
+}
+
+/**
+ * @brief Runs an operation on one string, both string types get the same arguments
+ */
+template<Op OP>
+static void Run(StrazzleString& str, const std::string& source) {
+    std::size_t len = str.Len();
+
+    if constexpr(OP == Op::CONSTRUCT) {
+        StrazzleString copy(source.c_str());
+
+        benchmark::DoNotOptimize(copy.Data());
+    } else if constexpr(OP == Op::APPEND) {
+        str.AppendRaw(PIECE, 16);
+    } else if constexpr(OP == Op::INSERT) {
+        str.InsertRaw(PIECE, len / 2, 8);
+    } else if constexpr(OP == Op::ERASE) {
+        str.Erase(len / 4, 4);
+    } else if constexpr(OP == Op::RESIZE) {
+        str.Resize(len * 2);
+    } else if constexpr(OP == Op::SUBSTR) {
+        StrazzleString sub = str.Substr(len / 4, len / 2);
+
+        benchmark::DoNotOptimize(sub.Data());
+    } else if constexpr(OP == Op::RESERVE) {
+        str.Reserve(len * 4);
+    } else if constexpr(OP == Op::MODE_TRANSITION) {
+        // Grows past the SSO buffer and shrinks back, a String goes from SMALL_STRING to LARGE_STRING and back
+        str.AppendRaw(PIECE, 32);
+        str.Resize(len);
+    }
+
+    benchmark::DoNotOptimize(str.Data());
+}
+
+template<Op OP>
+static void Run(StdString& str, const std::string& source) {
+    std::size_t len = str.size();
+
+    if constexpr(OP == Op::CONSTRUCT) {
+        StdString copy(source.c_str());
+
+        benchmark::DoNotOptimize(copy.data());
+    } else if constexpr(OP == Op::APPEND) {
+        str.append(PIECE, 16);
+    } else if constexpr(OP == Op::INSERT) {
+        str.insert(len / 2, PIECE, 8);
+    } else if constexpr(OP == Op::ERASE) {
+        str.erase(len / 4, 4);
+    } else if constexpr(OP == Op::RESIZE) {
+        str.resize(len * 2, ' ');
+    } else if constexpr(OP == Op::SUBSTR) {
+        StdString sub = str.substr(len / 4, len / 2);
+
+        benchmark::DoNotOptimize(sub.data());
+    } else if constexpr(OP == Op::RESERVE) {
+        str.reserve(len * 4);
+    } else if constexpr(OP == Op::MODE_TRANSITION) {
+        str.append(PIECE, 32);
+        str.resize(len);
+        str.shrink_to_fit();
+    }
+
+    benchmark::DoNotOptimize(str.data());
+}
+
+/**
+ * @brief Rebuilds a batch of strings from the sources
+ */
+template<typename StringType>
+static void Rebuild(std::vector<StringType>& strs, const std::vector<std::string>& sources) {
+    strs.clear();
+
+    for(const std::string& source : sources) {
+        strs.emplace_back(source.c_str());
+    }
+}
+
+/**
+ * @brief Runs an operation on batches of strings of a distribution
+ *        Reports the throughput, the heap allocations per operation and the p50 and p99 latency of a single operation. The
+ *        latencies are sampled in a separate untimed pass, every operation is timed on its own minus the overhead of the clock
+ */
+template<typename StringType, Op OP>
+static void BM_String(benchmark::State& state) {
+    std::vector<std::string> sources = MakeSources(state.range(0));
+    std::vector<StringType>  strs;
+
+    std::size_t op_allocations = 0;
+
+    for(auto _ : state) {
+        state.PauseTiming();
+        Rebuild(strs, sources);
+
+        std::size_t before = allocations;
+        state.ResumeTiming();
+
+        for(std::size_t k = 0; k < BATCH; k++) {
+            Run<OP>(strs[k], sources[k]);
+        }
+
+        op_allocations = op_allocations + allocations - before;
+    }
+
+    // Overhead of reading the clock twice
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<double> overhead;
+
+    for(std::size_t k = 0; k < BATCH; k++) {
+        auto start = Clock::now();
+        auto end   = Clock::now();
+
+        overhead.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+    }
+
+    std::nth_element(overhead.begin(), overhead.begin() + BATCH / 2, overhead.end());
+
+    // Latency of every operation of 4 batches
+    std::vector<double> latencies;
+
+    for(std::size_t batch = 0; batch < 4; batch++) {
+        Rebuild(strs, sources);
+
+        for(std::size_t k = 0; k < BATCH; k++) {
+            auto start = Clock::now();
+
+            Run<OP>(strs[k], sources[k]);
+
+            auto end = Clock::now();
+
+            latencies.push_back(std::max(std::chrono::duration<double, std::nano>(end - start).count() - overhead[BATCH / 2], 0.0));
+        }
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+
+    state.counters["p50_ns"]        = latencies[latencies.size() / 2];
+    state.counters["p99_ns"]        = latencies[latencies.size() * 99 / 100];
+    state.counters["allocs_per_op"] = static_cast<double>(op_allocations) / (state.iterations() * BATCH);
+
+    state.SetItemsProcessed(state.iterations() * BATCH);
+}
+
+BENCHMARK(BM_String<StrazzleString, Op::CONSTRUCT>)->ArgName("dist")->DenseRange(Distribution::SHORT, Distribution::MIXED);
+BENCHMARK(BM_String<StdString, Op::CONSTRUCT>)->ArgName("dist")->DenseRange(Distribution::SHORT, Distribution::MIXED);
+BENCHMARK(BM_String<StrazzleString, Op::APPEND>)->ArgName("dist")->DenseRange(Distribution::SHORT, Distribution::MIXED);
+BENCHMARK(BM_String<StdString, Op::APPEND>)->ArgName("dist")->DenseRange(Distribution::SHORT, Distribution::MIXED);
+BENCHMARK(BM_String<StrazzleString, Op::INSERT>)->ArgName("dist")->DenseRange(Distribution::SHORT, Distribution::MIXED);
+BENCHMARK(BM_String<StdString, Op::INSERT>)->ArgName("dist")->DenseRange(Distribution::SHORT, Distribution::MIXED);
+BENCHMARK(BM_String<StrazzleString, Op::ERASE>)->ArgName("dist")->DenseRange(Distribution::SHORT, Distribution::MIXED);
+BENCHMARK(BM_String<StdString, Op::ERASE>)->ArgName("dist")->DenseRange(Distribution::SHORT, Distribution::MIXED);
+BENCHMARK(BM_String<StrazzleString, Op::RESIZE>)->ArgName("dist")->DenseRange(Distribution::SHORT, Distribution::MIXED);
+BENCHMARK(BM_String<StdString, Op::RESIZE>)->ArgName("dist")->DenseRange(Distribution::SHORT, Distribution::MIXED);
+BENCHMARK(BM_String<StrazzleString, Op::SUBSTR>)->ArgName("dist")->DenseRange(Distribution::SHORT, Distribution::MIXED);
+BENCHMARK(BM_String<StdString, Op::SUBSTR>)->ArgName("dist")->DenseRange(Distribution::SHORT, Distribution::MIXED);
+BENCHMARK(BM_String<StrazzleString, Op::RESERVE>)->ArgName("dist")->DenseRange(Distribution::SHORT, Distribution::MIXED);
+BENCHMARK(BM_String<StdString, Op::RESERVE>)->ArgName("dist")->DenseRange(Distribution::SHORT, Distribution::MIXED);
+BENCHMARK(BM_String<StrazzleString, Op::MODE_TRANSITION>)->ArgName("dist")->DenseRange(Distribution::SHORT, Distribution::MIXED);
+BENCHMARK(BM_String<StdString, Op::MODE_TRANSITION>)->ArgName("dist")->DenseRange(Distribution::SHORT, Distribution::MIXED);
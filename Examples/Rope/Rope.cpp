@@ -0,0 +1,25 @@
+#define STRAZZLE_DEBUG_ALL_PUBLIC
+#ifndef NDEBUG
+    #define NDEBUG
+#endif
+
+#include "Strazzle/Rope.h"
+
+#include <iostream>
+#include <string>
+
+int main() {
+    Strazzle::String foo("00001111\n");
+
+    Strazzle::Rope bar(foo);
+
+    bar.Insert("ABCDEFG", 4);
+
+    Strazzle::Rope::Reference bar_ref = bar.RefSubstr(2, 8);
+
+    bar.Append(Strazzle::Rope(bar_ref));
+
+    bar.Append("\n");
+
+    printf(bar.ToString().Cstr());
+}
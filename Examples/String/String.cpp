@@ -1,5 +1,7 @@
 #define STRAZZLE_DEBUG_ALL_PUBLIC
-#define NDEBUG
+#ifndef NDEBUG
+    #define NDEBUG
+#endif
 
 #include "Strazzle/String.h"
 
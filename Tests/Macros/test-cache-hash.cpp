@@ -0,0 +1,97 @@
+#include "Strazzle/EditBatch.h"
+#include "Strazzle/String.h"
+
+#include <functional>
+#include <gtest/gtest.h>
+#include <string>
+#include <utility>
+
+/**
+ * @brief Caches the hash of str, runs the mutation and checks that the hash is the one of the new bytes
+ */
+template<typename Mutation>
+static void ExpectHashCleared(const char* init, Mutation mutation) {
+    Strazzle::String str(init);
+
+    std::size_t before = str.Hash();
+
+    mutation(str);
+
+    EXPECT_NE(str.Hash(), before) << init << " became " << str.Cstr();
+    EXPECT_EQ(str.Hash(), Strazzle::_Hash(str.Data(), str.Len())) << init << " became " << str.Cstr();
+
+    // The strings are equal even though one has a cached hash and the other doesn't have one yet
+    Strazzle::String copy;
+
+    copy.AppendRaw(str.Data(), str.Len());
+
+    EXPECT_EQ(str, copy);
+}
+
+// A SMALL_STRING and a LARGE_STRING for every mutation
+static const char* INITS[] = {"abc", "0123456789abcdef0123456789abcdef0123456789"};
+
+TEST(CachedHash, CachedValueIsTheHash) {
+    Strazzle::String str("abc");
+
+    EXPECT_EQ(str.Hash(), Strazzle::_Hash("abc", 3));
+    EXPECT_EQ(str.Hash(), Strazzle::_Hash("abc", 3));
+}
+
+TEST(CachedHash, AppendClears) {
+    for(const char* init : INITS) {
+        ExpectHashCleared(init, [](Strazzle::String& str) { str.Append("x"); });
+        ExpectHashCleared(init, [](Strazzle::String& str) { str.AppendRaw("y\0", 2); });
+        ExpectHashCleared(init, [](Strazzle::String& str) { str.Append(Strazzle::String("long enough to move to the heap")); });
+        ExpectHashCleared(init, [](Strazzle::String& str) { str.Append(str + "-" + str); });
+    }
+}
+
+TEST(CachedHash, InsertEraseResizeClear) {
+    for(const char* init : INITS) {
+        ExpectHashCleared(init, [](Strazzle::String& str) { str.Insert("x", 1); });
+        ExpectHashCleared(init, [](Strazzle::String& str) { str.Erase(1, 1); });
+        ExpectHashCleared(init, [](Strazzle::String& str) { str.Resize(2); });
+        ExpectHashCleared(init, [](Strazzle::String& str) { str.Resize(60, 'z'); });
+        ExpectHashCleared(init, [](Strazzle::String& str) { str.Resize(61, "fill"); });
+    }
+}
+
+TEST(CachedHash, SubstrAndAssignmentClear) {
+    for(const char* init : INITS) {
+        ExpectHashCleared(init, [](Strazzle::String& str) { str = std::move(str).Substr(1); });
+        ExpectHashCleared(init, [](Strazzle::String& str) { str = Strazzle::String("other"); });
+        ExpectHashCleared(init, [](Strazzle::String& str) {
+            Strazzle::String other("another string that is long enough for the heap");
+
+            str = other;
+        });
+        ExpectHashCleared(init, [](Strazzle::String& str) { Strazzle::EditBatch().Insert("x", 0).Erase(2, 1).Apply(str); });
+    }
+}
+
+TEST(CachedHash, MoveCarriesHash) {
+    Strazzle::String str("0123456789abcdef0123456789abcdef");
+
+    std::size_t hash = str.Hash();
+
+    Strazzle::String moved(std::move(str));
+
+    EXPECT_EQ(moved.Hash(), hash);
+    EXPECT_EQ(str.Hash(), Strazzle::_Hash("", 0));
+}
+
+TEST(CachedHash, UnequalCachedHashes) {
+    Strazzle::String a("abcdef");
+    Strazzle::String b("abcdeg");
+
+    a.Hash();
+    b.Hash();
+
+    EXPECT_NE(a, b);
+
+    b.Resize(5);
+    b.Append("f");
+
+    EXPECT_EQ(a, b);
+}
@@ -0,0 +1,99 @@
+#include "Strazzle/EditBatch.h"
+#include "Strazzle/String.h"
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+/**
+ * @brief Takes a reference into the start of str, runs the modification and checks that the reference is stale afterwards
+ *        even though it is still within the bounds of the string
+ */
+template<typename Modification>
+static void ExpectInvalidated(const char* init, Modification modification) {
+    Strazzle::String str(init);
+
+    Strazzle::String::Reference ref = str.RefSubstr(0, 2);
+
+    ASSERT_TRUE(ref.Valid());
+
+    modification(str);
+
+    ASSERT_GE(str.Len(), 2) << init;
+
+    EXPECT_FALSE(ref.Valid()) << init << " became " << str.Cstr();
+    EXPECT_THROW(ref.Data(), std::logic_error) << init << " became " << str.Cstr();
+    EXPECT_THROW(ref.Find('a'), std::logic_error) << init << " became " << str.Cstr();
+
+    // A new reference is valid again
+    EXPECT_TRUE(str.RefSubstr(0, 2).Valid());
+}
+
+/**
+ * @brief Takes a reference into str, runs the modification and checks that the reference still reads the same bytes
+ */
+template<typename Modification>
+static void ExpectStillValid(const char* init, Modification modification) {
+    Strazzle::String str(init);
+
+    Strazzle::String::Reference ref = str.RefSubstr(1, 2);
+
+    modification(str);
+
+    EXPECT_TRUE(ref.Valid()) << init << " became " << str.Cstr();
+    EXPECT_EQ(std::string(ref.Data(), ref.Len()), std::string(init + 1, 2)) << init << " became " << str.Cstr();
+}
+
+// A SMALL_STRING and a LARGE_STRING for every modification
+static const char* INITS[] = {"abcdef", "abcdef0123456789abcdef0123456789abcdef0123456789"};
+
+TEST(CheckReferences, EraseInsertResizeInvalidate) {
+    for(const char* init : INITS) {
+        ExpectInvalidated(init, [](Strazzle::String& str) { str.Erase(3, 1); });
+        ExpectInvalidated(init, [](Strazzle::String& str) { str.Erase(0, 1); });
+        ExpectInvalidated(init, [](Strazzle::String& str) { str.Insert("x", 0); });
+        ExpectInvalidated(init, [](Strazzle::String& str) { str.Insert("long enough to move the string to the heap", 4); });
+        ExpectInvalidated(init, [](Strazzle::String& str) { str.Resize(3); });
+        ExpectInvalidated(init, [](Strazzle::String& str) { str.Resize(4, "fill"); });
+    }
+}
+
+TEST(CheckReferences, AssignmentInvalidates) {
+    for(const char* init : INITS) {
+        ExpectInvalidated(init, [](Strazzle::String& str) {
+            Strazzle::String other("other string");
+
+            str = other;
+        });
+        ExpectInvalidated(init, [](Strazzle::String& str) { str = Strazzle::String("another string that is long enough for the heap"); });
+        ExpectInvalidated(init, [](Strazzle::String& str) { str = std::move(str).Substr(1); });
+        ExpectInvalidated(init, [](Strazzle::String& str) { Strazzle::EditBatch().Insert("x", 0).Apply(str); });
+    }
+}
+
+TEST(CheckReferences, MovedFromInvalidates) {
+    Strazzle::String str("abcdef0123456789abcdef0123456789");
+
+    Strazzle::String::Reference ref = str.RefSubstr(0, 0);
+
+    Strazzle::String moved(std::move(str));
+
+    EXPECT_FALSE(ref.Valid());
+    EXPECT_THROW(ref.Data(), std::logic_error);
+}
+
+TEST(CheckReferences, AppendKeepsReferences) {
+    for(const char* init : INITS) {
+        ExpectStillValid(init, [](Strazzle::String& str) { str.Append("x"); });
+        ExpectStillValid(init, [](Strazzle::String& str) { str.AppendRaw("y\0", 2); });
+
+        // Moves a SMALL_STRING to the heap and reallocates a LARGE_STRING, the reference follows by index
+        ExpectStillValid(init, [](Strazzle::String& str) { str.Append(std::string(500, 'z').c_str()); });
+        ExpectStillValid(init, [](Strazzle::String& str) { str.Append(str + "-" + str); });
+
+        // Growing fills behind the current bytes like an append
+        ExpectStillValid(init, [](Strazzle::String& str) { str.Resize(100, 'g'); });
+        ExpectStillValid(init, [](Strazzle::String& str) { str.Reserve(1000); });
+    }
+}
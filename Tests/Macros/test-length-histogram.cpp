@@ -0,0 +1,169 @@
+#include "Strazzle/LengthHistogram.h"
+#include "Strazzle/String.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Difference of the buckets between two snapshots
+ */
+static Strazzle::LengthHistogram Delta(const Strazzle::LengthHistogram& before, const Strazzle::LengthHistogram& after) {
+    Strazzle::LengthHistogram delta;
+
+    for(std::size_t k = 0; k < Strazzle::HISTOGRAM_BUCKETS; k++) {
+        delta.counts[k] = after.counts[k] - before.counts[k];
+    }
+
+    return delta;
+}
+
+/**
+ * @brief Makes a string of len bytes and destroys it
+ */
+static void DestroyString(std::size_t len) {
+    Strazzle::String str;
+
+    str.Resize(len, 'x');
+}
+
+/**
+ * @brief Get the growth site of a tag, nullptr if nothing grew under it
+ */
+static const Strazzle::GrowthSite* FindGrowthSite(const std::vector<Strazzle::GrowthSite>& sites, const char* tag) {
+    for(const Strazzle::GrowthSite& site : sites) {
+        if(site.tag == tag) return &site;
+    }
+
+    return nullptr;
+}
+
+TEST(LengthHistogram, Buckets) {
+    EXPECT_EQ(Strazzle::_LengthBucket(1), 1);
+    EXPECT_EQ(Strazzle::_LengthBucket(63), 63);
+    EXPECT_EQ(Strazzle::_LengthBucket(64), 64);
+    EXPECT_EQ(Strazzle::_LengthBucket(127), 64);
+    EXPECT_EQ(Strazzle::_LengthBucket(128), 65);
+    EXPECT_EQ(Strazzle::_LengthBucket(SIZE_MAX), Strazzle::HISTOGRAM_BUCKETS - 1);
+
+    // Every length is in the range of its bucket
+    for(std::size_t len : {1UL, 23UL, 63UL, 64UL, 100UL, 1000UL, 1UL << 40, SIZE_MAX}) {
+        std::size_t k = Strazzle::_LengthBucket(len);
+
+        EXPECT_LE(Strazzle::LengthHistogram::BucketMin(k), len);
+        EXPECT_GE(Strazzle::LengthHistogram::BucketMax(k), len);
+    }
+
+    EXPECT_EQ(Strazzle::LengthHistogram::BucketMax(Strazzle::HISTOGRAM_BUCKETS - 1), SIZE_MAX);
+}
+
+TEST(LengthHistogram, CountsDestroyedStrings) {
+    Strazzle::LengthHistogram before = Strazzle::GetLengthHistogram();
+
+    for(std::size_t len : {5, 5, 63, 64, 100, 1000}) {
+        DestroyString(len);
+    }
+
+    // Empty and moved-from strings are not counted
+    {
+        Strazzle::String empty;
+        Strazzle::String str("moved");
+        Strazzle::String moved(std::move(str));
+    }
+
+    // The histograms of threads that exited are kept
+    std::thread([] { DestroyString(5); }).join();
+
+    Strazzle::LengthHistogram delta = Delta(before, Strazzle::GetLengthHistogram());
+
+    EXPECT_EQ(delta.counts[0], 0);
+    EXPECT_EQ(delta.counts[5], 4);
+    EXPECT_EQ(delta.counts[63], 1);
+    EXPECT_EQ(delta.counts[64], 2);
+    EXPECT_EQ(delta.counts[Strazzle::_LengthBucket(1000)], 1);
+    EXPECT_EQ(delta.Total(), 8);
+}
+
+TEST(LengthHistogram, Recommendation) {
+    Strazzle::LengthHistogram histogram;
+
+    EXPECT_EQ(histogram.Coverage(24), 1.0);
+
+    histogram.counts[10] = 80;
+    histogram.counts[30] = 15;
+    histogram.counts[Strazzle::_LengthBucket(1000)] = 5;
+
+    EXPECT_DOUBLE_EQ(histogram.Coverage(24), 0.8);
+    EXPECT_DOUBLE_EQ(histogram.Coverage(32), 0.95);
+    EXPECT_EQ(histogram.RecommendSsoSize(0.9), 32);
+    EXPECT_EQ(histogram.RecommendSsoSize(0.8), 24);
+
+    // The long strings never fit
+    EXPECT_EQ(histogram.RecommendSsoSize(0.99), 0);
+}
+
+TEST(LengthHistogram, GrowthSites) {
+    const char* loop    = "append loop";
+    const char* reserve = "reserved loop";
+
+    // Grows from the SSO buffer through many exponents, one byte at a time
+    for(int k = 0; k < 3; k++) {
+        Strazzle::ProfileScope scope(loop);
+
+        Strazzle::String str;
+
+        for(std::size_t i = 0; i < 1000; i++) {
+            str.Append("x");
+        }
+    }
+
+    // The same string with a reservation never grows
+    {
+        Strazzle::ProfileScope scope(reserve);
+
+        Strazzle::String str;
+
+        str.Reserve(1000);
+
+        for(std::size_t i = 0; i < 1000; i++) {
+            str.Append("x");
+        }
+    }
+
+    std::vector<Strazzle::GrowthSite> sites = Strazzle::GetGrowthSites();
+
+    const Strazzle::GrowthSite* site = FindGrowthSite(sites, loop);
+
+    ASSERT_NE(site, nullptr);
+    EXPECT_EQ(site->address, nullptr);
+    EXPECT_EQ(site->strings, 3);
+    EXPECT_GE(site->growths, 3);
+    EXPECT_EQ(site->growths % 3, 0);
+    EXPECT_GT(site->max_bytes, 1000);
+    EXPECT_LE(site->max_bytes, 2048);
+
+    EXPECT_EQ(FindGrowthSite(sites, reserve), nullptr);
+}
+
+TEST(LengthHistogram, Report) {
+    DestroyString(100);
+
+    char*       text = nullptr;
+    std::size_t size = 0;
+    FILE*       file = open_memstream(&text, &size);
+
+    Strazzle::DumpLengthReport(file);
+
+    fclose(file);
+
+    std::string report(text, size);
+
+    free(text);
+
+    EXPECT_NE(report.find("64-127"), std::string::npos) << report;
+    EXPECT_NE(report.find("The default SSO size of 24 keeps"), std::string::npos) << report;
+}
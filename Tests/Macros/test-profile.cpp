@@ -0,0 +1,140 @@
+#include "Strazzle/Profiler.h"
+#include "Strazzle/String.h"
+
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <vector>
+
+// Long enough for a LARGE_STRING
+static const char* LONG_STRING = "a string that is far too long for the SSO buffer of the string, so the constructor allocates";
+
+// A LARGE_STRING made before the profiled calls
+static const Strazzle::String LARGE(LONG_STRING);
+
+/**
+ * @brief Samples every allocation from now on and drops the sites recorded so far
+ *        The countdown of the thread is cut short, otherwise the rate is only picked up at the next sample
+ */
+static void SampleEverything() {
+    Strazzle::SetProfileSampleRate(1);
+
+    Strazzle::_ProfileCountdown() = 1;
+
+    Strazzle::ResetProfile();
+}
+
+/**
+ * @brief Get the site whose return address lies in the code of function, nullptr if there is none
+ *        The helpers below are a few instructions long, so the return address of their string call is right behind their start
+ */
+static const Strazzle::ProfileSite* FindSiteIn(const std::vector<Strazzle::ProfileSite>& sites, void (*function)()) {
+    uintptr_t start = reinterpret_cast<uintptr_t>(function);
+
+    for(const Strazzle::ProfileSite& site : sites) {
+        uintptr_t address = reinterpret_cast<uintptr_t>(site.address);
+
+        if(site.tag == nullptr && address > start && address < start + 256) return &site;
+    }
+
+    return nullptr;
+}
+
+[[gnu::noinline]] static void ConstructLarge() {
+    Strazzle::String str(LONG_STRING);
+}
+
+[[gnu::noinline]] static void AppendString() {
+    Strazzle::String str("short");
+
+    str.Append(LARGE);
+}
+
+[[gnu::noinline]] static void AppendLarge() {
+    Strazzle::String str("short");
+
+    str.Append(LONG_STRING);
+}
+
+TEST(Profile, SiteIsTheCallOfTheUser) {
+    SampleEverything();
+
+    ConstructLarge();
+    ConstructLarge();
+    AppendLarge();
+
+    std::vector<Strazzle::ProfileSite> sites = Strazzle::GetProfile();
+
+    const Strazzle::ProfileSite* construct = FindSiteIn(sites, ConstructLarge);
+    const Strazzle::ProfileSite* append    = FindSiteIn(sites, AppendLarge);
+
+    // Each string call is its own site and not the one of the function the string code would be inlined into
+    ASSERT_NE(construct, nullptr);
+    ASSERT_NE(append, nullptr);
+    EXPECT_NE(construct, append);
+
+    EXPECT_EQ(construct->allocations, 2);
+    EXPECT_EQ(construct->freed, 2);
+    EXPECT_EQ(append->allocations, 1);
+
+    // The SMALL_STRING -> LARGE_STRING transition of the append
+    EXPECT_EQ(append->mode_changes, 1);
+}
+
+TEST(Profile, NestedCallsKeepTheOuterSite) {
+    SampleEverything();
+
+    AppendString();
+
+    std::vector<Strazzle::ProfileSite> sites = Strazzle::GetProfile();
+
+    // The growth is made by the AppendRaw that Append calls, it belongs to the Append of the user
+    ASSERT_EQ(sites.size(), 1);
+    EXPECT_EQ(FindSiteIn(sites, AppendString), &sites[0]);
+    EXPECT_EQ(sites[0].allocations, 1);
+}
+
+TEST(Profile, ScopeTagsAllocations) {
+    SampleEverything();
+
+    {
+        Strazzle::ProfileScope scope("outer");
+
+        ConstructLarge();
+
+        {
+            Strazzle::ProfileScope inner("inner");
+
+            ConstructLarge();
+            ConstructLarge();
+        }
+
+        ConstructLarge();
+    }
+
+    std::vector<Strazzle::ProfileSite> sites = Strazzle::GetProfile();
+
+    ASSERT_EQ(sites.size(), 2);
+
+    for(const Strazzle::ProfileSite& site : sites) {
+        ASSERT_NE(site.tag, nullptr);
+
+        EXPECT_EQ(site.address, nullptr);
+        EXPECT_EQ(site.allocations, 2);
+        EXPECT_EQ(site.bytes, sites[0].bytes);
+        EXPECT_EQ(site.freed, 2);
+    }
+
+    EXPECT_NE(sites[0].tag, sites[1].tag);
+}
+
+TEST(Profile, RateZeroStopsSampling) {
+    SampleEverything();
+
+    Strazzle::SetProfileSampleRate(0);
+
+    for(int k = 0; k < 100; k++) {
+        ConstructLarge();
+    }
+
+    EXPECT_TRUE(Strazzle::GetProfile().empty());
+}
@@ -0,0 +1,119 @@
+#include "Strazzle/String.h"
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+
+/**
+ * @brief Difference of the counters between two snapshots
+ */
+static Strazzle::StringStats Delta(const Strazzle::StringStats& before, const Strazzle::StringStats& after) {
+    Strazzle::StringStats delta;
+
+    delta.allocations    = after.allocations - before.allocations;
+    delta.deallocations  = after.deallocations - before.deallocations;
+    delta.reallocations  = after.reallocations - before.reallocations;
+    delta.bytes_copied   = after.bytes_copied - before.bytes_copied;
+    delta.bytes_moved    = after.bytes_moved - before.bytes_moved;
+    delta.small_to_large = after.small_to_large - before.small_to_large;
+    delta.large_to_small = after.large_to_small - before.large_to_small;
+    delta.reserve_hits   = after.reserve_hits - before.reserve_hits;
+
+    return delta;
+}
+
+TEST(StringStats, KnownSequence) {
+    Strazzle::StringStats before = Strazzle::GetStringStats();
+
+    {
+        // 3 bytes copied into the SSO buffer
+        Strazzle::String str("abc");
+
+        // To a 64 byte heap buffer: the 3 bytes and the terminator are copied over, then the 40 new bytes
+        str.Append(std::string(40, 'x').c_str());
+
+        // Grown to 256 bytes by realloc
+        str.Append(std::string(100, 'y').c_str());
+
+        // The 133 bytes behind the erased ones move to the front
+        str.Erase(0, 10);
+
+        // Back to the SSO buffer, which keeps 23 bytes, and the heap buffer is freed
+        str.Resize(5);
+
+        // To a 256 byte heap buffer again: the 5 bytes and the terminator are copied over
+        str.Reserve(200);
+
+        // Fits the reservation, no reallocation
+        str.Append(std::string(10, 'z').c_str());
+
+        EXPECT_EQ(str.Len(), 15);
+    }
+
+    Strazzle::StringStats delta = Delta(before, Strazzle::GetStringStats());
+
+    EXPECT_EQ(delta.allocations, 2);
+    EXPECT_EQ(delta.deallocations, 2);
+    EXPECT_EQ(delta.reallocations, 1);
+    EXPECT_EQ(delta.bytes_copied, 3 + 4 + 40 + 100 + 23 + 6 + 10);
+    EXPECT_EQ(delta.bytes_moved, 133);
+    EXPECT_EQ(delta.small_to_large, 2);
+    EXPECT_EQ(delta.large_to_small, 1);
+    EXPECT_EQ(delta.reserve_hits, 1);
+}
+
+TEST(StringStats, InsertAndSubstr) {
+    Strazzle::String str("0123456789");
+
+    Strazzle::StringStats before = Strazzle::GetStringStats();
+
+    // The 6 bytes behind the position move, the 2 new ones are copied
+    str.Insert("ab", 4);
+
+    // The 5 bytes of the substr move to the front of the buffer of the temporary
+    Strazzle::String substr = std::move(str).Substr(3, 5);
+
+    Strazzle::StringStats delta = Delta(before, Strazzle::GetStringStats());
+
+    EXPECT_EQ(substr, "3ab45");
+    EXPECT_EQ(delta.bytes_copied, 2);
+    EXPECT_EQ(delta.bytes_moved, 6 + 5);
+    EXPECT_EQ(delta.allocations, 0);
+}
+
+TEST(StringStats, ThreadsAreSummed) {
+    Strazzle::StringStats before = Strazzle::GetStringStats();
+
+    // The counters of threads that exited are kept
+    for(int t = 0; t < 4; t++) {
+        std::thread([] {
+            Strazzle::String str(std::string(100, 't').c_str());
+        }).join();
+    }
+
+    Strazzle::StringStats delta = Delta(before, Strazzle::GetStringStats());
+
+    EXPECT_EQ(delta.allocations, 4);
+    EXPECT_EQ(delta.deallocations, 4);
+    EXPECT_EQ(delta.small_to_large, 4);
+    EXPECT_EQ(delta.bytes_copied, 4 * (1 + 100));
+}
+
+TEST(StringStats, ForEachNamesEveryCounter) {
+    Strazzle::StringStats stats;
+
+    stats.reserve_hits = 7;
+
+    std::size_t count = 0;
+    std::size_t hits  = 0;
+
+    stats.ForEach([&](const char* name, std::size_t value) {
+        count = count + 1;
+
+        if(strcmp(name, "reserve_hits") == 0) hits = value;
+    });
+
+    EXPECT_EQ(count, static_cast<std::size_t>(Strazzle::Stat::COUNT));
+    EXPECT_EQ(hits, 7);
+}
@@ -0,0 +1,134 @@
+#include "Strazzle/StringArena.h"
+#include "Strazzle/StringPool.h"
+
+#include <algorithm>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+TEST(PooledString, ReserveKeepsTerminator) {
+    // Leaves a buffer of the size class Reserve grows into in the pool, full of bytes that aren't a terminator
+    {
+        Strazzle::PooledString garbage;
+
+        garbage.Resize(255, 'x');
+    }
+
+    Strazzle::PooledString str;
+
+    str.Resize(40, 'a');
+    str.Reserve(200);
+
+    EXPECT_EQ(strlen(str.Cstr()), 40);
+    EXPECT_EQ(str, std::string(40, 'a').c_str());
+}
+
+TEST(PooledString, GrowKeepsBytes) {
+    Strazzle::PooledString str;
+
+    for(int k = 0; k < 100; k++) {
+        str.Append("0123456789");
+    }
+
+    EXPECT_EQ(str.Len(), 1000);
+    EXPECT_EQ(strlen(str.Cstr()), 1000);
+    EXPECT_EQ(str.Find("90123"), 9);
+}
+
+TEST(PooledString, ShrinkToSmallKeepsPrefix) {
+    Strazzle::PooledString str(std::string(300, 'b').c_str());
+
+    str.Resize(5);
+
+    EXPECT_EQ(str, "bbbbb");
+    EXPECT_EQ(strlen(str.Cstr()), 5);
+}
+
+TEST(ArenaString, ReserveKeepsTerminator) {
+    Strazzle::StringArena arena;
+
+    Strazzle::ArenaString str(arena);
+    Strazzle::ArenaString other(arena);
+
+    str.Resize(40, 'a');
+
+    // Another buffer behind str, so the arena can't grow str in place and has to copy
+    other.Resize(40, 'b');
+
+    str.Reserve(200);
+
+    EXPECT_EQ(strlen(str.Cstr()), 40);
+    EXPECT_EQ(strlen(other.Cstr()), 40);
+}
+
+TEST(ArenaString, MakeStringsBatch) {
+    // Small blocks, so a batch that isn't reserved up front spans several of them
+    Strazzle::StringArena arena(256);
+
+    // Most of the first block is taken already
+    Strazzle::ArenaString before(arena);
+
+    before.Resize(150, 'p');
+
+    std::string medium(100, 'm');
+    std::string large(300, 'l');
+    std::string boundary(Strazzle::SSO_SIZE, 'b');
+
+    // SSO sized inputs, including the longest one, and LARGE inputs, one of them binary
+    std::vector<std::pair<const char*, std::size_t>> inputs = {{"short", 5}, {boundary.c_str(), Strazzle::SSO_SIZE - 1}, {"", 0},
+        {boundary.c_str(), Strazzle::SSO_SIZE}, {medium.c_str(), medium.size()}, {"bin\0ary", 7}, {large.c_str(), large.size()}};
+
+    std::size_t used  = arena.Used();
+    std::size_t total = 0;
+
+    for(const auto& [str, len] : inputs) {
+        if(len + 1 > Strazzle::SSO_SIZE) total = total + Strazzle::_ExpToNum(Strazzle::_GetExponent(len + 1));
+    }
+
+    std::vector<Strazzle::ArenaString> strs = arena.MakeStrings(inputs);
+
+    ASSERT_EQ(strs.size(), inputs.size());
+
+    // Every heap buffer of the batch comes from one reservation, back to back
+    EXPECT_EQ(arena.Used() - used, total);
+
+    const char* lo = nullptr;
+    const char* hi = nullptr;
+
+    for(std::size_t k = 0; k < strs.size(); k++) {
+        const char* object       = reinterpret_cast<const char*>(&strs[k]);
+        bool        inline_bytes = strs[k].Data() >= object && strs[k].Data() < object + sizeof(Strazzle::ArenaString);
+
+        EXPECT_EQ(inline_bytes, inputs[k].second + 1 <= Strazzle::SSO_SIZE) << k;
+
+        if(inline_bytes) continue;
+
+        const char* end = strs[k].Data() + Strazzle::_ExpToNum(Strazzle::_GetExponent(inputs[k].second + 1));
+
+        lo = lo == nullptr ? strs[k].Data() : std::min(lo, strs[k].Data());
+        hi = hi == nullptr ? end : std::max(hi, end);
+    }
+
+    EXPECT_EQ(static_cast<std::size_t>(hi - lo), total);
+
+    // The strings stay valid while the arena hands out more buffers, until it is reset
+    std::vector<Strazzle::ArenaString> more = arena.MakeStrings(inputs);
+
+    more.clear();
+
+    before.Append(large.c_str());
+
+    for(std::size_t k = 0; k < strs.size(); k++) {
+        ASSERT_EQ(strs[k].Len(), inputs[k].second) << k;
+        EXPECT_EQ(std::memcmp(strs[k].Data(), inputs[k].first, inputs[k].second), 0) << k;
+        EXPECT_EQ(strs[k].Data()[inputs[k].second], '\0') << k;
+    }
+
+    strs.clear();
+
+    arena.Reset();
+
+    EXPECT_EQ(arena.Used(), 0);
+}
@@ -0,0 +1,153 @@
+#include "Strazzle/String.h"
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+
+TEST(StringAppend, RawKeepsEmbeddedNuls) {
+    Strazzle::String str;
+
+    str.AppendRaw("a\0b", 3);
+    str.AppendRaw("\0", 1);
+
+    EXPECT_EQ(str.Len(), 4);
+    EXPECT_EQ(std::memcmp(str.Data(), "a\0b\0", 5), 0);
+}
+
+TEST(StringAppend, LiteralLengthFromArrayType) {
+    Strazzle::String str;
+
+    str.Append("a\0b");
+
+    EXPECT_EQ(str.Len(), 3);
+    EXPECT_EQ(std::memcmp(str.Data(), "a\0b", 4), 0);
+
+    str.Append("cdef", 2);
+
+    EXPECT_EQ(str.Len(), 5);
+    EXPECT_EQ(str.Data()[4], 'd');
+}
+
+TEST(StringAppend, PointerUsesStrlen) {
+    const char* ptr = "a\0b";
+
+    Strazzle::String str;
+
+    str.Append(ptr);
+
+    EXPECT_EQ(str, "a");
+}
+
+TEST(StringAppend, BufferStopsAtNul) {
+    char buffer[16] = "abc";
+
+    Strazzle::String str;
+
+    str.Append(buffer);
+
+    EXPECT_EQ(str, "abc");
+
+    // A full buffer without a terminator is read up to its end
+    char full[4] = {'w', 'x', 'y', 'z'};
+
+    str.Append(full);
+
+    EXPECT_EQ(str, "abcwxyz");
+}
+
+TEST(StringAppend, SelfSmall) {
+    Strazzle::String str("abc");
+
+    str.Append(str);
+
+    EXPECT_EQ(str, "abcabc");
+}
+
+TEST(StringAppend, SelfAcrossGrowth) {
+    // Appending to itself grows the buffer, the source has to be read from the new one
+    Strazzle::String str("0123456789abcdef0123");
+
+    for(int k = 0; k < 5; k++) {
+        str.Append(str);
+    }
+
+    EXPECT_EQ(str.Len(), 20 * 32);
+
+    for(std::size_t i = 0; i < str.Len(); i = i + 20) {
+        EXPECT_EQ(std::memcmp(str.Data() + i, "0123456789abcdef0123", 20), 0);
+    }
+}
+
+TEST(StringAppend, SelfSubstr) {
+    Strazzle::String str(std::string(60, 'a').c_str());
+
+    str.Append("bcd");
+    str.AppendRaw(str.Data() + str.Len() - 3, 3);
+
+    EXPECT_EQ(str.Len(), 66);
+    EXPECT_STREQ(str.Cstr() + 60, "bcdbcd");
+}
+
+TEST(StringAppend, SelfReference) {
+    Strazzle::String str("0123456789");
+
+    Strazzle::String::Reference ref = str.RefSubstr(2, 3);
+
+    str.Append(ref);
+
+    EXPECT_EQ(str, "0123456789234");
+}
+
+TEST(StringInsert, RawKeepsEmbeddedNuls) {
+    Strazzle::String str("ab");
+
+    str.InsertRaw("\0\0", 1, 2);
+
+    EXPECT_EQ(str.Len(), 4);
+    EXPECT_EQ(std::memcmp(str.Data(), "a\0\0b", 5), 0);
+}
+
+TEST(StringInsert, OutOfBounds) {
+    Strazzle::String str("ab");
+
+    EXPECT_THROW(str.Insert("x", 3), std::out_of_range);
+
+    str.Insert("x", 2);
+
+    EXPECT_EQ(str, "abx");
+}
+
+TEST(StringInsert, SelfInFront) {
+    Strazzle::String str("abc");
+
+    str.Insert(str, 0);
+
+    EXPECT_EQ(str, "abcabc");
+}
+
+TEST(StringInsert, SelfInMiddle) {
+    // The inserted bytes lie behind the insert position, so moving the tail overwrites them
+    Strazzle::String str("0123456789");
+
+    str.InsertRaw(str.Data() + 5, 2, 5);
+
+    EXPECT_EQ(str, "015678923456789");
+}
+
+TEST(StringInsert, SelfAcrossGrowth) {
+    Strazzle::String str("0123456789abcdef0123");
+
+    str.InsertRaw(str.Data(), 10, 20);
+
+    EXPECT_EQ(str, "01234567890123456789abcdef0123abcdef0123");
+}
+
+TEST(StringInsert, LiteralLengthFromArrayType) {
+    Strazzle::String str("ab");
+
+    str.Insert("x\0y", 1);
+
+    EXPECT_EQ(str.Len(), 5);
+    EXPECT_EQ(std::memcmp(str.Data(), "ax\0yb", 6), 0);
+}
@@ -0,0 +1,142 @@
+#include "Strazzle/Search.h"
+#include "Strazzle/String.h"
+
+#include <compare>
+#include <gtest/gtest.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+static int Sign(int result) {
+    return (result > 0) - (result < 0);
+}
+
+/**
+ * @brief Compares like the library should, std::string compares chars as unsigned bytes
+ */
+static int Expected(const std::string& a, const std::string& b) {
+    return Sign(a.compare(b));
+}
+
+static Strazzle::String FromBytes(const std::string& str) {
+    Strazzle::String result;
+
+    result.AppendRaw(str.data(), str.size());
+
+    return result;
+}
+
+TEST(SearchKernels, MismatchMatchesNaive) {
+    std::vector<std::pair<const char*, std::size_t (*)(const char*, const char*, std::size_t)>> kernels = {{"scalar", Strazzle::_MismatchScalar}};
+
+#ifdef STRAZZLE_SEARCH_X86
+    __builtin_cpu_init();
+
+    if(__builtin_cpu_supports("sse2")) kernels.push_back({"sse2", Strazzle::_MismatchSse2});
+    if(__builtin_cpu_supports("avx2")) kernels.push_back({"avx2", Strazzle::_MismatchAvx2});
+    if(__builtin_cpu_supports("avx512bw")) kernels.push_back({"avx512", Strazzle::_MismatchAvx512});
+#endif
+
+    for(const auto& [name, mismatch] : kernels) {
+        SCOPED_TRACE(name);
+
+        for(std::size_t size : {0, 1, 15, 16, 17, 31, 32, 33, 63, 64, 65, 127, 128, 129, 300}) {
+            std::string a(size, 'a');
+
+            EXPECT_EQ(mismatch(a.data(), a.data(), size), size);
+
+            for(std::size_t i = 0; i < size; i++) {
+                std::string b = a;
+
+                b[i] = '\0';
+
+                EXPECT_EQ(mismatch(a.data(), b.data(), size), i) << "size " << size;
+            }
+        }
+    }
+}
+
+TEST(StringCompare, MatchesStdString) {
+    // Lengths on both sides of the SSO buffer and of the 16 byte cut off of the mismatch kernel
+    std::vector<std::string> strs;
+
+    for(std::size_t size : {0, 1, 5, 15, 16, 17, 22, 23, 24, 40, 100}) {
+        std::string base(size, 'm');
+
+        strs.push_back(base);
+
+        for(std::size_t i : {std::size_t(0), size / 2, size - 1}) {
+            if(i >= size) continue;
+
+            for(char c : {'\0', 'a', 'z', '\x80', '\xff'}) {
+                std::string str = base;
+
+                str[i] = c;
+
+                strs.push_back(str);
+            }
+        }
+    }
+
+    for(const std::string& a : strs) {
+        Strazzle::String str_a = FromBytes(a);
+
+        for(const std::string& b : strs) {
+            Strazzle::String str_b = FromBytes(b);
+
+            int expected = Expected(a, b);
+
+            ASSERT_EQ(Sign(str_a.Compare(str_b)), expected) << a.size() << " vs " << b.size();
+            ASSERT_EQ(str_a == str_b, expected == 0) << a.size() << " vs " << b.size();
+            ASSERT_EQ(str_a <=> str_b, expected <=> 0) << a.size() << " vs " << b.size();
+        }
+    }
+}
+
+TEST(StringCompare, EmbeddedNuls) {
+    Strazzle::String a;
+    Strazzle::String b;
+
+    a.AppendRaw("ab\0c", 4);
+    b.AppendRaw("ab\0d", 4);
+
+    EXPECT_NE(a, b);
+    EXPECT_LT(a, b);
+
+    // A C string ends at its first NUL, a literal does not
+    EXPECT_NE(a, static_cast<const char*>("ab"));
+    EXPECT_EQ(a, "ab\0c");
+    EXPECT_GT(a, static_cast<const char*>("ab"));
+}
+
+TEST(StringCompare, PrefixIsLess) {
+    Strazzle::String small("abc");
+    Strazzle::String large(std::string(50, 'a').c_str());
+    Strazzle::String longer(std::string(51, 'a').c_str());
+
+    EXPECT_LT(Strazzle::String("ab"), small);
+    EXPECT_LT(large, longer);
+    EXPECT_GT(longer, large);
+    EXPECT_LT(Strazzle::String("a"), large);
+}
+
+TEST(StringCompare, BytesAreUnsigned) {
+    EXPECT_GT(Strazzle::String("\x80"), Strazzle::String("\x7f"));
+    EXPECT_GT(Strazzle::String(std::string(40, '\xff').c_str()), Strazzle::String(std::string(40, '\x01').c_str()));
+}
+
+TEST(StringCompare, OtherSsoSizesAndReferences) {
+    Strazzle::SSOString<32> a("0123456789012345678901234567890");
+    Strazzle::SSOString<32> b("0123456789012345678901234567891");
+
+    EXPECT_LT(a, b);
+    EXPECT_EQ(a, Strazzle::SSOString<32>("0123456789012345678901234567890"));
+
+    Strazzle::String str("xxabcxx");
+
+    Strazzle::String::Reference ref = str.RefSubstr(2, 3);
+
+    EXPECT_EQ(ref, "abc");
+    EXPECT_EQ(Strazzle::String("abc"), ref);
+    EXPECT_LT(ref, "abd");
+}
@@ -0,0 +1,117 @@
+#include "Strazzle/String.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <string>
+
+/**
+ * @brief Malloc allocator that counts its allocations
+ */
+struct CountingAllocator {
+    static inline std::size_t allocations = 0;
+
+    char* Allocate(std::size_t size) {
+        allocations = allocations + 1;
+
+        return static_cast<char*>(malloc(size));
+    }
+
+    void Deallocate(char* p, std::size_t) {
+        free(p);
+    }
+};
+
+using CountingString = Strazzle::BasicString<CountingAllocator, Strazzle::SSO_SIZE>;
+
+TEST(Concat, MixedOperandsIntoNewString) {
+    Strazzle::String a("Hello");
+    Strazzle::String b(", ");
+    Strazzle::String line("the whole world");
+
+    Strazzle::String::Reference ref = line.RefSubstr(10, 5);
+
+    char buffer[8] = "!!";
+
+    Strazzle::String str = a + b + "lit " + ref + buffer + '\n';
+
+    EXPECT_EQ(str, "Hello, lit world!!\n");
+    EXPECT_EQ(str.Len(), 19);
+    EXPECT_EQ(strlen(str.Cstr()), 19);
+
+    // A Concat on the right and on the left, and its length before it is consumed
+    EXPECT_EQ((a + (b + ref)).Len(), 12);
+    EXPECT_EQ(Strazzle::String('<' + a + '>'), "<Hello>");
+
+    // Binary safe, the Reference keeps its NUL byte
+    Strazzle::String binary;
+
+    binary.AppendRaw("x\0y", 3);
+
+    Strazzle::String joined = binary + binary;
+
+    EXPECT_EQ(joined.Len(), 6);
+    EXPECT_EQ(std::memcmp(joined.Data(), "x\0yx\0y", 6), 0);
+}
+
+TEST(Concat, OneAllocation) {
+    CountingString a(std::string(30, 'a').c_str());
+    CountingString b(std::string(40, 'b').c_str());
+
+    std::size_t before = CountingAllocator::allocations;
+
+    // Straight to a LARGE_STRING of the final size, no intermediate strings
+    CountingString str = a + "-" + b + "-" + a + '\n';
+
+    EXPECT_EQ(CountingAllocator::allocations - before, 1);
+    EXPECT_EQ(str.Len(), 30 + 1 + 40 + 1 + 30 + 1);
+    EXPECT_EQ(strlen(str.Cstr()), str.Len());
+
+    // Fits the SSO buffer, nothing is allocated
+    before = CountingAllocator::allocations;
+
+    CountingString small = CountingString("ab") + "cd" + 'e';
+
+    EXPECT_EQ(CountingAllocator::allocations - before, 0);
+    EXPECT_EQ(small, "abcde");
+}
+
+TEST(Concat, AppendGrowsOnceFromSmallToLarge) {
+    CountingString str("small");
+    CountingString b(std::string(20, 'b').c_str());
+    CountingString c(std::string(50, 'c').c_str());
+
+    std::size_t before = CountingAllocator::allocations;
+
+    // The SMALL_STRING becomes a LARGE_STRING in the append, the buffer is grown once for all pieces
+    str.Append(b + "|" + c + '|');
+
+    EXPECT_EQ(CountingAllocator::allocations - before, 1);
+    EXPECT_EQ(str, (std::string("small") + std::string(20, 'b') + "|" + std::string(50, 'c') + "|").c_str());
+}
+
+TEST(Concat, AppendAliasedPieces) {
+    // A SMALL_STRING that moves to the heap, the pieces point into the SSO buffer that is replaced
+    Strazzle::String small("0123456789");
+
+    small.Append(small + "-" + small.RefSubstr(2, 3) + small);
+
+    EXPECT_EQ(small, "01234567890123456789-2340123456789");
+
+    // A LARGE_STRING that is reallocated, the pieces point into the old buffer
+    std::string      init(100, 'x');
+    Strazzle::String large(init.c_str());
+
+    large.Append(large + large + large.RefSubstr(0, 5) + "end");
+
+    EXPECT_EQ(large.Len(), 3 * 100 + 5 + 3);
+    EXPECT_EQ(large, (init + init + init + "xxxxxend").c_str());
+
+    // A piece that starts in the middle of the string and a piece that is all of it
+    Strazzle::String str("abcdefghijklmnopqrstuvwxyz");
+
+    str.Append(str.RefSubstr(20, 6) + str);
+
+    EXPECT_EQ(str, "abcdefghijklmnopqrstuvwxyzuvwxyzabcdefghijklmnopqrstuvwxyz");
+    EXPECT_EQ(strlen(str.Cstr()), str.Len());
+}
@@ -0,0 +1,201 @@
+#include "Strazzle/String.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+static const std::string LONG(100, 'a');
+
+namespace {
+/**
+ * @brief Records the sizes it is asked for, has no Reallocate so every growth allocates
+ */
+struct RecordingAllocator {
+    static inline std::vector<std::size_t> sizes;
+
+    char* Allocate(std::size_t size) {
+        sizes.push_back(size);
+
+        return static_cast<char*>(malloc(size));
+    }
+
+    void Deallocate(char* p, std::size_t size) {
+        // Freed with a size it was allocated with
+        EXPECT_NE(std::find(sizes.begin(), sizes.end(), size), sizes.end());
+
+        free(p);
+    }
+};
+} // namespace
+
+TEST(CowString, CopySharesBuffer) {
+    Strazzle::CowString str(LONG.c_str());
+    Strazzle::CowString copy(str);
+
+    EXPECT_EQ(copy.Data(), str.Data());
+    EXPECT_EQ(copy, str);
+
+    Strazzle::CowString assigned;
+
+    assigned = copy;
+
+    EXPECT_EQ(assigned.Data(), str.Data());
+}
+
+TEST(CowString, SmallCopiesAreNotShared) {
+    Strazzle::CowString str("short");
+    Strazzle::CowString copy(str);
+
+    EXPECT_NE(copy.Data(), str.Data());
+    EXPECT_EQ(copy, "short");
+}
+
+TEST(CowString, CopyDivergesAfterWrite) {
+    Strazzle::CowString str(LONG.c_str());
+    Strazzle::CowString copy(str);
+
+    copy.Append("b");
+
+    EXPECT_NE(copy.Data(), str.Data());
+    EXPECT_EQ(str, LONG.c_str());
+    EXPECT_EQ(copy, (LONG + "b").c_str());
+
+    // The original is the only owner again and is written in place
+    str.Append("c");
+
+    EXPECT_EQ(str, (LONG + "c").c_str());
+    EXPECT_EQ(copy, (LONG + "b").c_str());
+}
+
+TEST(CowString, EveryWriteUnshares) {
+    Strazzle::CowString str(LONG.c_str());
+
+    {
+        Strazzle::CowString copy(str);
+
+        copy.Insert("x", 0);
+
+        EXPECT_EQ(copy.Data()[0], 'x');
+    }
+
+    {
+        Strazzle::CowString copy(str);
+
+        copy.Erase(0, 50);
+
+        EXPECT_EQ(copy.Len(), 50);
+    }
+
+    {
+        Strazzle::CowString copy(str);
+
+        copy.Resize(200, 'z');
+
+        EXPECT_EQ(copy.Len(), 200);
+    }
+
+    {
+        Strazzle::CowString copy(str);
+
+        copy.Resize(50);
+
+        EXPECT_EQ(copy.Len(), 50);
+    }
+
+    {
+        Strazzle::CowString copy(str);
+
+        Strazzle::CowString substr = std::move(copy).Substr(10, 50);
+
+        EXPECT_EQ(substr.Len(), 50);
+    }
+
+    EXPECT_EQ(str, LONG.c_str());
+}
+
+TEST(CowString, OwnerOutlivedByCopy) {
+    Strazzle::CowString* str  = new Strazzle::CowString(LONG.c_str());
+    Strazzle::CowString  copy = *str;
+
+    delete str;
+
+    EXPECT_EQ(copy, LONG.c_str());
+
+    copy.Append("b");
+
+    EXPECT_EQ(copy.Len(), 101);
+}
+
+TEST(CowString, MoveDoesNotShare) {
+    Strazzle::CowString str(LONG.c_str());
+    Strazzle::CowString copy(str);
+
+    Strazzle::CowString moved(std::move(copy));
+
+    EXPECT_EQ(moved.Data(), str.Data());
+    EXPECT_EQ(copy.Len(), 0);
+
+    moved.Append("b");
+
+    EXPECT_EQ(str, LONG.c_str());
+}
+
+TEST(CowString, CopiesOnManyThreads) {
+    Strazzle::CowString str(LONG.c_str());
+
+    std::vector<std::thread> threads;
+
+    // The reference count is shared by all threads, half the copies write and drop their share early
+    for(int t = 0; t < 4; t++) {
+        threads.emplace_back([&str]() {
+            for(int k = 0; k < 1000; k++) {
+                Strazzle::CowString copy(str);
+
+                if(k % 2 == 0) copy.Append("b");
+
+                EXPECT_EQ(copy.Data()[0], 'a');
+            }
+        });
+    }
+
+    for(std::thread& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(str, LONG.c_str());
+}
+
+TEST(CowString, AllocationsStayPowersOfTwo) {
+    // The reference count is part of the allocation, a header on top of a power of 2 would land in the next size class of a pool
+    using RecordingCowString = Strazzle::BasicString<Strazzle::CopyOnWrite<RecordingAllocator>>;
+
+    RecordingAllocator::sizes.clear();
+
+    {
+        RecordingCowString str;
+
+        for(int k = 0; k < 100; k++) {
+            str.Append("0123456789");
+        }
+
+        RecordingCowString copy(str);
+
+        copy.Append("x");
+
+        EXPECT_EQ(str.Len(), 1000);
+        EXPECT_EQ(copy.Len(), 1001);
+    }
+
+    ASSERT_FALSE(RecordingAllocator::sizes.empty());
+
+    for(std::size_t size : RecordingAllocator::sizes) {
+        EXPECT_EQ(size & (size - 1), 0) << size;
+    }
+
+    // 1001 bytes, the terminator and the reference count fit 1024
+    EXPECT_EQ(*std::max_element(RecordingAllocator::sizes.begin(), RecordingAllocator::sizes.end()), 1024);
+}
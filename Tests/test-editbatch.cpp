@@ -0,0 +1,184 @@
+#include "Strazzle/EditBatch.h"
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+
+TEST(EditBatch, AppliesAllEdits) {
+    Strazzle::String str("hello world");
+
+    Strazzle::EditBatch batch;
+
+    batch.Replace(6, 5, "there").Insert("oh, ", 0).Erase(4, 1).Insert("!", 11);
+
+    EXPECT_EQ(batch.Len(), 4);
+
+    batch.Apply(str);
+
+    EXPECT_EQ(str, "oh, hell there!");
+}
+
+TEST(EditBatch, EditsAreByOriginalOffset) {
+    // The offsets don't shift with the edits before them, unlike with String::Insert and String::Erase
+    Strazzle::String str("0123456789");
+
+    Strazzle::EditBatch batch;
+
+    batch.Insert("a", 8).Insert("b", 2).Erase(4, 2);
+
+    batch.Apply(str);
+
+    EXPECT_EQ(str, "01b2367a89");
+}
+
+TEST(EditBatch, InsertsAtSameOffsetKeepTheirOrder) {
+    Strazzle::String str("ab");
+
+    Strazzle::EditBatch batch;
+
+    batch.Insert("1", 1).Insert("2", 1).Insert("3", 1);
+
+    batch.Apply(str);
+
+    EXPECT_EQ(str, "a123b");
+}
+
+TEST(EditBatch, InsertAtEdgesOfErase) {
+    Strazzle::String str("0123456789");
+
+    Strazzle::EditBatch batch;
+
+    batch.Erase(2, 3).Insert("x", 2).Insert("y", 5);
+
+    batch.Apply(str);
+
+    EXPECT_EQ(str, "01xy56789");
+}
+
+TEST(EditBatch, EraseIsClampedAtTheEnd) {
+    Strazzle::String str("0123456789");
+
+    Strazzle::EditBatch batch;
+
+    batch.Erase(7).Insert("end", 10);
+
+    batch.Apply(str);
+
+    EXPECT_EQ(str, "0123456end");
+}
+
+TEST(EditBatch, RejectsOverlappingErases) {
+    Strazzle::String str("0123456789");
+
+    Strazzle::EditBatch batch;
+
+    batch.Erase(2, 4).Erase(5, 2);
+
+    EXPECT_THROW(batch.Apply(str), std::invalid_argument);
+
+    // A failed Apply leaves the string as it was
+    EXPECT_EQ(str, "0123456789");
+}
+
+TEST(EditBatch, RejectsInsertInsideErase) {
+    Strazzle::String str("0123456789");
+
+    Strazzle::EditBatch batch;
+
+    batch.Replace(2, 4, "abc").Insert("x", 3);
+
+    EXPECT_THROW(batch.Apply(str), std::invalid_argument);
+    EXPECT_EQ(str, "0123456789");
+}
+
+TEST(EditBatch, RejectsOutOfRange) {
+    Strazzle::String str("0123456789");
+
+    Strazzle::EditBatch batch;
+
+    batch.Insert("x", 11);
+
+    EXPECT_THROW(batch.Apply(str), std::out_of_range);
+    EXPECT_EQ(str, "0123456789");
+}
+
+TEST(EditBatch, BinarySafe) {
+    Strazzle::String str;
+
+    str.AppendRaw("a\0b", 3);
+
+    Strazzle::EditBatch batch;
+
+    batch.InsertRaw("\0\0", 1, 2).ReplaceRaw(2, 1, "c\0", 2);
+
+    batch.Apply(str);
+
+    EXPECT_EQ(str.Len(), 6);
+    EXPECT_EQ(std::memcmp(str.Data(), "a\0\0\0c\0", 7), 0);
+}
+
+TEST(EditBatch, MatchesEditsOneByOne) {
+    std::string      expected(500, '.');
+    Strazzle::String str(expected.c_str());
+
+    Strazzle::EditBatch batch;
+
+    // Every 10th offset gets a replacement of varying size, applied back to front on the std::string so the offsets stay valid
+    for(std::size_t i = 0; i < 500; i = i + 10) {
+        std::size_t size = i % 7;
+        std::string text(i % 13, static_cast<char>('a' + i % 26));
+
+        batch.Replace(i, size, text.c_str());
+    }
+
+    for(std::size_t i = 490;; i = i - 10) {
+        expected.replace(i, i % 7, std::string(i % 13, static_cast<char>('a' + i % 26)));
+
+        if(i == 0) break;
+    }
+
+    batch.Apply(str);
+
+    EXPECT_EQ(str.Len(), expected.size());
+    EXPECT_STREQ(str.Cstr(), expected.c_str());
+}
+
+TEST(EditBatch, ApplyAgainAndClear) {
+    Strazzle::String a("abc");
+    Strazzle::String b("xyz");
+
+    Strazzle::EditBatch batch;
+
+    batch.Insert("-", 1);
+
+    batch.Apply(a);
+    batch.Apply(b);
+
+    EXPECT_EQ(a, "a-bc");
+    EXPECT_EQ(b, "x-yz");
+
+    batch.Clear();
+
+    EXPECT_EQ(batch.Len(), 0);
+
+    batch.Insert("+", 0);
+    batch.Apply(a);
+
+    EXPECT_EQ(a, "+a-bc");
+}
+
+TEST(EditBatch, ClearKeepsLargeText) {
+    Strazzle::String str("ab");
+
+    Strazzle::EditBatch batch;
+
+    batch.Insert(std::string(1000, 'x').c_str(), 1);
+    batch.Clear();
+
+    // The inserted bytes start over at the front of the kept buffer
+    batch.Insert("1", 1).Insert(std::string(100, 'y').c_str(), 2);
+    batch.Apply(str);
+
+    EXPECT_EQ(str, ("a1b" + std::string(100, 'y')).c_str());
+}
@@ -0,0 +1,156 @@
+#include "Strazzle/GapString.h"
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+
+TEST(GapString, LocalEditsStayInGap) {
+    Strazzle::GapString str("0123456789");
+
+    str.Insert("ab", 5);
+    str.Insert("cd", 7);
+    str.Erase(2, 2);
+
+    EXPECT_TRUE(str.IsGapBuffer());
+    EXPECT_EQ(str.Len(), 12);
+    EXPECT_STREQ(str.Cstr(), "014abcd56789");
+}
+
+TEST(GapString, FarEditFallsBackToContiguous) {
+    std::string expected(1000, 'a');
+
+    Strazzle::GapString str(expected.c_str());
+
+    str.Insert("x", 10);
+    expected.insert(expected.begin() + 10, 'x');
+
+    str.Insert("y", 900);
+    expected.insert(expected.begin() + 900, 'y');
+
+    EXPECT_FALSE(str.IsGapBuffer());
+    EXPECT_EQ(std::string(str.Data(), str.Len()), expected);
+
+    str.Insert("z", 901);
+    expected.insert(expected.begin() + 901, 'z');
+
+    EXPECT_TRUE(str.IsGapBuffer());
+    EXPECT_EQ(std::string(str.Data(), str.Len()), expected);
+}
+
+TEST(GapString, SelfInsert) {
+    Strazzle::GapString str("0123456789");
+
+    str.InsertRaw(str.Data() + 5, 2, 5);
+
+    EXPECT_STREQ(str.Cstr(), "015678923456789");
+}
+
+TEST(GapString, EraseOutOfBounds) {
+    Strazzle::GapString str("ab");
+
+    EXPECT_THROW(str.Erase(2), std::out_of_range);
+    EXPECT_THROW(str.Insert("x", 3), std::out_of_range);
+}
+
+TEST(GapString, CopyWithOpenGap) {
+    // The gap of the source sits in the middle, the copy reads both sides of it
+    Strazzle::GapString str("0123456789");
+
+    str.Insert("ab", 5);
+
+    const Strazzle::GapString& source = str;
+
+    Strazzle::GapString copy(source);
+
+    EXPECT_STREQ(copy.Cstr(), "01234ab56789");
+
+    Strazzle::GapString assigned("xyz");
+
+    assigned = source;
+
+    EXPECT_STREQ(assigned.Cstr(), "01234ab56789");
+
+    // The source still edits in its gap
+    str.Insert("c", 7);
+
+    EXPECT_STREQ(str.Cstr(), "01234abc56789");
+}
+
+TEST(GapString, CopyEmpty) {
+    Strazzle::GapString empty;
+
+    Strazzle::GapString copy(empty);
+
+    EXPECT_EQ(copy.Len(), 0);
+    EXPECT_STREQ(copy.Cstr(), "");
+}
+
+TEST(GapString, EditNearPreviousAfterData) {
+    std::string expected(1000, 'a');
+
+    Strazzle::GapString str(expected.c_str());
+
+    str.Insert("x", 500);
+    expected.insert(expected.begin() + 500, 'x');
+
+    // Data moves the gap to the end, the next edit is still close to the previous one
+    EXPECT_EQ(std::string(str.Data(), str.Len()), expected);
+
+    str.Insert("y", 502);
+    expected.insert(expected.begin() + 502, 'y');
+
+    EXPECT_TRUE(str.IsGapBuffer());
+
+    str.Erase(498, 2);
+    expected.erase(498, 2);
+
+    EXPECT_TRUE(str.IsGapBuffer());
+    EXPECT_EQ(std::string(str.Data(), str.Len()), expected);
+}
+
+TEST(GapString, AssignEmptyResetsMode) {
+    Strazzle::GapString str("0123456789");
+
+    str.Insert("ab", 5);
+
+    ASSERT_TRUE(str.IsGapBuffer());
+
+    str = Strazzle::GapString();
+
+    EXPECT_FALSE(str.IsGapBuffer());
+    EXPECT_EQ(str.Len(), 0);
+
+    // An assigned empty string keeps its buffer, the first edit is at the start
+    Strazzle::GapString copy("0123456789");
+
+    copy.Insert("ab", 5);
+
+    const Strazzle::GapString empty;
+
+    copy = empty;
+
+    EXPECT_FALSE(copy.IsGapBuffer());
+    EXPECT_STREQ(copy.Cstr(), "");
+
+    copy.Append("xyz");
+
+    EXPECT_STREQ(copy.Cstr(), "xyz");
+}
+
+TEST(GapString, ToStringKeepsTheGap) {
+    Strazzle::GapString str("0123456789");
+
+    str.Insert("ab", 5);
+
+    const Strazzle::GapString& source = str;
+
+    EXPECT_EQ(source.ToString(), "01234ab56789");
+    EXPECT_EQ(source.Len(), 12);
+
+    // The gap was not moved, the next local edit still goes into it
+    str.Insert("c", 7);
+
+    EXPECT_TRUE(str.IsGapBuffer());
+    EXPECT_EQ(str.ToString(), "01234abc56789");
+    EXPECT_EQ(Strazzle::GapString().ToString(), "");
+}
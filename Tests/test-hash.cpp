@@ -0,0 +1,104 @@
+#include "Strazzle/Hash.h"
+#include "Strazzle/InplaceString.h"
+#include "Strazzle/String.h"
+
+#include <functional>
+#include <gtest/gtest.h>
+#include <string>
+#include <unordered_set>
+
+// Lengths around the 3, 16 and 48 byte steps of the hash and the SSO boundary
+static const std::size_t SIZES[] = {0, 1, 2, 3, 4, 7, 8, 15, 16, 17, 23, 24, 31, 47, 48, 49, 95, 96, 97, 200};
+
+TEST(StringHash, EqualBytesHashEqual) {
+    for(std::size_t size : SIZES) {
+        std::string bytes(size, 'a');
+
+        for(std::size_t i = 0; i < size; i++) {
+            bytes[i] = static_cast<char>('a' + i * 7 % 26);
+        }
+
+        Strazzle::String str(bytes.c_str());
+
+        // A Reference and an InplaceString with the same bytes
+        Strazzle::String base(("xy" + bytes + "z").c_str());
+
+        Strazzle::String::Reference ref = base.RefSubstr(2, size);
+
+        Strazzle::InplaceString<200> inplace(bytes.c_str());
+
+        std::size_t hash = Strazzle::_Hash(bytes.data(), size);
+
+        EXPECT_EQ(str.Hash(), hash) << "size " << size;
+        EXPECT_EQ(ref.Hash(), hash) << "size " << size;
+        EXPECT_EQ(inplace.Hash(), hash) << "size " << size;
+        EXPECT_EQ(std::hash<Strazzle::String>()(str), hash) << "size " << size;
+        EXPECT_EQ(std::hash<Strazzle::InplaceString<200>>()(inplace), hash) << "size " << size;
+        EXPECT_EQ(Strazzle::StringHash()(bytes.c_str()), hash) << "size " << size;
+    }
+}
+
+TEST(StringHash, BinarySafe) {
+    Strazzle::String a;
+    Strazzle::String b;
+
+    a.AppendRaw("a\0b", 3);
+    b.AppendRaw("a\0c", 3);
+
+    EXPECT_NE(a.Hash(), b.Hash());
+    EXPECT_EQ(a.Hash(), Strazzle::_Hash("a\0b", 3));
+}
+
+TEST(StringHash, DiffersForNearbyInputs) {
+    // Every length and every single byte change of a short input hashes differently
+    std::unordered_set<std::size_t> hashes;
+
+    std::string bytes(64, 'a');
+
+    for(std::size_t size = 0; size <= bytes.size(); size++) {
+        hashes.insert(Strazzle::_Hash(bytes.data(), size));
+    }
+
+    for(std::size_t i = 0; i < bytes.size(); i++) {
+        std::string changed = bytes;
+
+        changed[i] = 'b';
+
+        hashes.insert(Strazzle::_Hash(changed.data(), changed.size()));
+    }
+
+    EXPECT_EQ(hashes.size(), 65 + 64);
+}
+
+TEST(StringHash, HeterogeneousLookup) {
+    std::unordered_set<Strazzle::String, Strazzle::StringHash, std::equal_to<>> set;
+
+    set.insert(Strazzle::String("GET"));
+    set.insert(Strazzle::String("/api/v1/orders/00000017/items"));
+
+    Strazzle::String line("GET /api/v1/orders/00000017/items HTTP/1.1");
+
+    // Found with a Reference and a C string, no String is built for the lookup
+    EXPECT_NE(set.find(line.RefSubstr(0, 3)), set.end());
+    EXPECT_NE(set.find(line.RefSubstr(4, 29)), set.end());
+    EXPECT_EQ(set.find(line.RefSubstr(4, 28)), set.end());
+
+    EXPECT_NE(set.find("GET"), set.end());
+    EXPECT_EQ(set.find("PUT"), set.end());
+
+    EXPECT_NE(set.find(Strazzle::String("GET")), set.end());
+}
+
+TEST(StringHash, StdHashInUnorderedSet) {
+    std::unordered_set<Strazzle::String> set;
+
+    for(std::size_t size : SIZES) {
+        set.insert(Strazzle::String(std::string(size, 'k').c_str()));
+    }
+
+    EXPECT_EQ(set.size(), std::size(SIZES));
+
+    for(std::size_t size : SIZES) {
+        EXPECT_EQ(set.count(Strazzle::String(std::string(size, 'k').c_str())), 1) << "size " << size;
+    }
+}
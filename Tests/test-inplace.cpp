@@ -0,0 +1,192 @@
+#include "Strazzle/InplaceString.h"
+#include "Strazzle/String.h"
+
+#include <compare>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+using Truncating = Strazzle::InplaceString<8, Strazzle::InplaceOverflow::TRUNCATE>;
+using Throwing   = Strazzle::InplaceString<8, Strazzle::InplaceOverflow::THROW>;
+using ErrorCode  = Strazzle::InplaceString<8, Strazzle::InplaceOverflow::ERROR_CODE>;
+
+static_assert(std::is_trivially_copyable_v<Strazzle::InplaceString<8>>);
+static_assert(std::is_trivially_copyable_v<Strazzle::InplaceString<1000>>);
+static_assert(std::is_trivially_copyable_v<Truncating>);
+
+// The length takes a byte up to a capacity of 255 and two bytes up to 65535: buffer, length and overflow flag
+static_assert(sizeof(Strazzle::InplaceString<15>) == 16 + 1 + 1);
+static_assert(sizeof(Strazzle::InplaceString<255>) == 256 + 1 + 1);
+static_assert(sizeof(Strazzle::InplaceString<256>) == 258 + 2 + 1 + 1);
+static_assert(sizeof(Strazzle::InplaceString<65536>) == 65544 + 8 + 8);
+
+TEST(InplaceString, LengthTypeHoldsCapacity) {
+    Strazzle::InplaceString<255> small(std::string(255, 'a').c_str());
+    Strazzle::InplaceString<300> medium(std::string(300, 'b').c_str());
+
+    EXPECT_EQ(small.Len(), 255);
+    EXPECT_EQ(medium.Len(), 300);
+    EXPECT_EQ(strlen(medium.Cstr()), 300);
+}
+
+TEST(InplaceString, AppendOverflow) {
+    Truncating truncating("abcdef");
+
+    truncating.Append("ghij");
+
+    EXPECT_EQ(truncating, "abcdefgh");
+    EXPECT_TRUE(truncating.Overflowed());
+
+    truncating.ClearOverflow();
+
+    EXPECT_FALSE(truncating.Overflowed());
+
+    Throwing throwing("abcdef");
+
+    EXPECT_THROW(throwing.Append("ghij"), std::length_error);
+    EXPECT_EQ(throwing, "abcdef");
+    EXPECT_FALSE(throwing.Overflowed());
+
+    throwing.Append("gh");
+
+    EXPECT_EQ(throwing, "abcdefgh");
+
+    ErrorCode error_code("abcdef");
+
+    error_code.Append("ghij");
+
+    EXPECT_EQ(error_code, "abcdef");
+    EXPECT_TRUE(error_code.Overflowed());
+}
+
+TEST(InplaceString, InsertOverflow) {
+    Truncating truncating("abcdef");
+
+    truncating.Insert("xyz", 2);
+
+    EXPECT_EQ(truncating, "abxyzcde");
+    EXPECT_TRUE(truncating.Overflowed());
+
+    // Inserted bytes behind the capacity are cut off too
+    Truncating tail("abcdef");
+
+    tail.Insert("xyzw", 6);
+
+    EXPECT_EQ(tail, "abcdefxy");
+
+    Throwing throwing("abcdef");
+
+    EXPECT_THROW(throwing.Insert("xyz", 2), std::length_error);
+    EXPECT_EQ(throwing, "abcdef");
+
+    ErrorCode error_code("abcdef");
+
+    error_code.Insert("xyz", 2);
+
+    EXPECT_EQ(error_code, "abcdef");
+    EXPECT_TRUE(error_code.Overflowed());
+
+    EXPECT_THROW(error_code.Insert("x", 7), std::out_of_range);
+}
+
+TEST(InplaceString, ResizeOverflow) {
+    Truncating truncating("ab");
+
+    truncating.Resize(10, 'x');
+
+    EXPECT_EQ(truncating, "abxxxxxx");
+    EXPECT_TRUE(truncating.Overflowed());
+
+    Truncating fill("ab");
+
+    fill.Resize(10, "123");
+
+    EXPECT_EQ(fill, "ab123123");
+
+    Throwing throwing("ab");
+
+    EXPECT_THROW(throwing.Resize(9, 'x'), std::length_error);
+    EXPECT_THROW(throwing.Resize(9, "123"), std::length_error);
+    EXPECT_EQ(throwing, "ab");
+
+    ErrorCode error_code("ab");
+
+    error_code.Resize(9, "123");
+
+    EXPECT_EQ(error_code, "ab");
+    EXPECT_TRUE(error_code.Overflowed());
+
+    error_code.Resize(8, "123");
+
+    EXPECT_EQ(error_code, "ab123123");
+}
+
+TEST(InplaceString, ResizeEmptyFill) {
+    Strazzle::InplaceString<16> str("ab");
+
+    EXPECT_THROW(str.Resize(5, ""), std::invalid_argument);
+    EXPECT_EQ(str, "ab");
+
+    str.Resize(1, "");
+
+    EXPECT_EQ(str, "a");
+}
+
+TEST(InplaceString, SelfInsert) {
+    Strazzle::InplaceString<32> str("0123456789");
+
+    // The inserted bytes lie behind the insert position, so moving the tail overwrites them
+    str.InsertRaw(str.Data() + 5, 2, 5);
+
+    EXPECT_EQ(str, "015678923456789");
+
+    str.InsertRaw(str.Data(), 0, 3);
+
+    EXPECT_EQ(str, "015015678923456789");
+
+    // Truncated self insertion
+    Truncating truncating("abcdef");
+
+    truncating.InsertRaw(truncating.Data(), 3, 6);
+
+    EXPECT_EQ(truncating, "abcabcde");
+}
+
+TEST(InplaceString, MixedComparison) {
+    Strazzle::InplaceString<32> inplace("hello");
+    Strazzle::String            str("hello");
+    Strazzle::String            larger("help");
+    Strazzle::String            base("say hello");
+
+    Strazzle::String::Reference ref = base.RefSubstr(4, 5);
+
+    EXPECT_TRUE(inplace == str);
+    EXPECT_TRUE(str == inplace);
+    EXPECT_TRUE(inplace == ref);
+    EXPECT_TRUE(ref == inplace);
+    EXPECT_TRUE(inplace == "hello");
+    EXPECT_FALSE(inplace == larger);
+    EXPECT_FALSE(larger == inplace);
+
+    EXPECT_EQ(inplace <=> str, std::strong_ordering::equal);
+    EXPECT_EQ(inplace <=> larger, std::strong_ordering::less);
+    EXPECT_EQ(larger <=> inplace, std::strong_ordering::greater);
+    EXPECT_EQ(ref <=> inplace, std::strong_ordering::equal);
+    EXPECT_EQ(inplace <=> "hellp", std::strong_ordering::less);
+
+    EXPECT_TRUE(inplace < larger);
+    EXPECT_TRUE(larger > inplace);
+}
+
+TEST(InplaceString, ToStringIsBinarySafe) {
+    Strazzle::InplaceString<8> inplace;
+
+    inplace.AppendRaw("a\0b", 3);
+
+    Strazzle::String str = inplace.ToString();
+
+    EXPECT_EQ(str.Len(), 3);
+    EXPECT_EQ(str, inplace);
+}
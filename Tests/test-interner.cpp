@@ -0,0 +1,177 @@
+#include "Strazzle/String.h"
+#include "Strazzle/StringInterner.h"
+
+#include <algorithm>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * @brief A distinct string for every k, of varying length
+ */
+static std::string Key(std::size_t k) {
+    return "key-" + std::to_string(k) + std::string(k % 40, 'x');
+}
+
+TEST(StringInterner, SameStringSameAtom) {
+    Strazzle::StringInterner interner;
+
+    Strazzle::Atom a = interner.Intern("alpha");
+    Strazzle::Atom b = interner.Intern("beta");
+
+    EXPECT_NE(a, b);
+    EXPECT_EQ(interner.Intern("alpha"), a);
+
+    // A String and a Reference with the same bytes
+    Strazzle::String str("alpha");
+    Strazzle::String line("alpha,beta");
+
+    EXPECT_EQ(interner.Intern(str), a);
+    EXPECT_EQ(interner.Intern(line.RefSubstr(6, 4)), b);
+    EXPECT_EQ(interner.Intern(line.RefSubstr(0, 4)), interner.Intern("alph"));
+
+    EXPECT_EQ(interner.Size(), 3);
+
+    EXPECT_EQ(interner.Find("beta"), b);
+    EXPECT_FALSE(interner.Find("gamma").has_value());
+    EXPECT_EQ(interner.Size(), 3);
+}
+
+TEST(StringInterner, CstrAndLen) {
+    Strazzle::StringInterner interner;
+
+    std::string long_string(1000, 'l');
+
+    Strazzle::Atom empty      = interner.Intern("");
+    Strazzle::Atom short_atom = interner.Intern("short");
+    Strazzle::Atom long_atom  = interner.Intern(long_string.c_str());
+
+    EXPECT_EQ(interner.Len(empty), 0);
+    EXPECT_STREQ(interner.Cstr(empty), "");
+    EXPECT_EQ(interner.Len(short_atom), 5);
+    EXPECT_STREQ(interner.Cstr(short_atom), "short");
+    EXPECT_EQ(interner.Len(long_atom), 1000);
+    EXPECT_STREQ(interner.Cstr(long_atom), long_string.c_str());
+
+    // The interner keeps its own copy
+    char buffer[] = "buffer";
+
+    Strazzle::Atom atom = interner.Intern(buffer, 6);
+
+    buffer[0] = 'B';
+
+    EXPECT_STREQ(interner.Cstr(atom), "buffer");
+}
+
+TEST(StringInterner, BinaryStrings) {
+    Strazzle::StringInterner interner;
+
+    Strazzle::Atom a   = interner.Intern("a\0b", 3);
+    Strazzle::Atom b   = interner.Intern("a\0c", 3);
+    Strazzle::Atom pre = interner.Intern("a", 1);
+
+    EXPECT_NE(a, b);
+    EXPECT_NE(a, pre);
+    EXPECT_EQ(interner.Intern("a\0b", 3), a);
+    EXPECT_EQ(interner.Len(a), 3);
+    EXPECT_EQ(std::memcmp(interner.Cstr(a), "a\0b", 4), 0);
+}
+
+TEST(StringInterner, GrowsTablesAndChunks) {
+    Strazzle::StringInterner interner;
+
+    // Far more strings than the initial tables of all shards hold, and atoms in many chunks
+    const std::size_t count = 20000;
+
+    std::vector<Strazzle::Atom> atoms;
+
+    for(std::size_t k = 0; k < count; k++) {
+        atoms.push_back(interner.Intern(Key(k).c_str()));
+
+        // Atoms are handed out in order, 63 and 64 are the last of the first chunk and the first of the second
+        EXPECT_EQ(atoms[k].id, k);
+    }
+
+    EXPECT_EQ(interner.Size(), count);
+
+    for(std::size_t k = 0; k < count; k++) {
+        std::string key = Key(k);
+
+        ASSERT_EQ(interner.Intern(key.c_str()), atoms[k]) << key;
+        ASSERT_EQ(interner.Find(key.c_str()), atoms[k]) << key;
+        ASSERT_STREQ(interner.Cstr(atoms[k]), key.c_str());
+        ASSERT_EQ(interner.Len(atoms[k]), key.size());
+    }
+
+    EXPECT_EQ(interner.Size(), count);
+}
+
+TEST(StringInterner, ChunkBoundary) {
+    Strazzle::StringInterner interner;
+
+    for(std::size_t k = 0; k < 200; k++) {
+        interner.Intern(Key(k).c_str());
+    }
+
+    // The last and first atom of the chunks of 64 and 128 entries
+    for(uint32_t id : {0u, 63u, 64u, 191u, 192u, 199u}) {
+        EXPECT_STREQ(interner.Cstr(Strazzle::Atom{id}), Key(id).c_str()) << id;
+    }
+}
+
+TEST(StringInterner, ConcurrentThreadsAgree) {
+    Strazzle::StringInterner interner;
+
+    const std::size_t thread_count = 8;
+    const std::size_t per_thread   = 4000;
+
+    // Thread t interns the keys [t * 1000, t * 1000 + 4000) in its own order, so every key is interned by up to 4 threads at once
+    std::vector<std::vector<Strazzle::Atom>> atoms(thread_count, std::vector<Strazzle::Atom>(per_thread));
+    std::vector<std::thread>                 threads;
+
+    for(std::size_t t = 0; t < thread_count; t++) {
+        threads.emplace_back([&, t] {
+            std::vector<std::size_t> order(per_thread);
+
+            for(std::size_t k = 0; k < per_thread; k++) {
+                order[k] = k;
+            }
+
+            std::shuffle(order.begin(), order.end(), std::mt19937(t));
+
+            for(std::size_t k : order) {
+                atoms[t][k] = interner.Intern(Key(t * 1000 + k).c_str());
+            }
+        });
+    }
+
+    for(std::thread& thread : threads) {
+        thread.join();
+    }
+
+    std::size_t distinct = (thread_count - 1) * 1000 + per_thread;
+
+    EXPECT_EQ(interner.Size(), distinct);
+
+    std::unordered_set<uint32_t> ids;
+
+    for(std::size_t key = 0; key < distinct; key++) {
+        Strazzle::Atom atom = interner.Intern(Key(key).c_str());
+
+        ids.insert(atom.id);
+
+        EXPECT_STREQ(interner.Cstr(atom), Key(key).c_str());
+
+        // Every thread that interned the key got the same atom
+        for(std::size_t t = 0; t < thread_count; t++) {
+            if(key >= t * 1000 && key < t * 1000 + per_thread) EXPECT_EQ(atoms[t][key - t * 1000], atom) << "key " << key << " thread " << t;
+        }
+    }
+
+    EXPECT_EQ(ids.size(), distinct);
+    EXPECT_EQ(interner.Size(), distinct);
+}
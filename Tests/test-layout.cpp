@@ -0,0 +1,138 @@
+#include "Strazzle/String.h"
+#include "Strazzle/StringPool.h"
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Checks if the bytes of str are stored in the object itself ie it is a SMALL_STRING
+ */
+template<typename Str>
+static bool IsInline(const Str& str) {
+    const char* object = reinterpret_cast<const char*>(&str);
+
+    return str.Data() >= object && str.Data() < object + sizeof(Str);
+}
+
+static_assert(sizeof(Strazzle::String) == 24);
+static_assert(sizeof(Strazzle::SSOString<32>) == 32);
+static_assert(Strazzle::TriviallyRelocatable<Strazzle::String>);
+static_assert(Strazzle::TriviallyRelocatable<Strazzle::PooledString>);
+static_assert(std::is_nothrow_move_constructible_v<Strazzle::String>);
+
+TEST(StringLayout, HoldsTwentyThreeBytesInline) {
+    for(std::size_t size = 0; size <= 23; size++) {
+        Strazzle::String str(std::string(size, 'a').c_str());
+
+        EXPECT_TRUE(IsInline(str)) << "size " << size;
+        EXPECT_EQ(str.Len(), size);
+        EXPECT_EQ(strlen(str.Cstr()), size);
+    }
+
+    Strazzle::String str(std::string(24, 'a').c_str());
+
+    EXPECT_FALSE(IsInline(str));
+    EXPECT_EQ(str.Len(), 24);
+    EXPECT_EQ(strlen(str.Cstr()), 24);
+}
+
+TEST(StringLayout, AppendAcrossTheSsoBoundary) {
+    Strazzle::String str;
+    std::string      expected;
+
+    for(char c = 'a'; c <= 'z'; c++) {
+        str.Append(std::string(1, c).c_str());
+        expected.push_back(c);
+
+        EXPECT_EQ(IsInline(str), expected.size() <= 23);
+        EXPECT_STREQ(str.Cstr(), expected.c_str());
+    }
+
+    // Shrinking back below the boundary moves the bytes back into the object
+    str.Resize(23);
+
+    EXPECT_TRUE(IsInline(str));
+    EXPECT_STREQ(str.Cstr(), expected.substr(0, 23).c_str());
+
+    str.Resize(0);
+
+    EXPECT_STREQ(str.Cstr(), "");
+}
+
+TEST(StringLayout, ReserveOnShortStringStaysTerminated) {
+    Strazzle::String str("abc");
+
+    str.Reserve(100);
+
+    EXPECT_FALSE(IsInline(str));
+    EXPECT_EQ(str.Len(), 3);
+    EXPECT_STREQ(str.Cstr(), "abc");
+
+    // Reserving within the SSO buffer is a no-op
+    Strazzle::String small("abc");
+
+    small.Reserve(20);
+
+    EXPECT_TRUE(IsInline(small));
+    EXPECT_STREQ(small.Cstr(), "abc");
+}
+
+TEST(StringLayout, OtherSsoSizes) {
+    Strazzle::SSOString<32> str(std::string(31, 'a').c_str());
+
+    EXPECT_TRUE(IsInline(str));
+    EXPECT_EQ(str.Len(), 31);
+
+    str.Append("b");
+
+    EXPECT_FALSE(IsInline(str));
+    EXPECT_EQ(str.Len(), 32);
+    EXPECT_EQ(str.Data()[31], 'b');
+
+    Strazzle::SSOString<19> tiny(std::string(18, 'a').c_str());
+
+    EXPECT_TRUE(IsInline(tiny));
+    EXPECT_EQ(tiny.Len(), 18);
+}
+
+TEST(StringLayout, RelocateMovesSmallAndLarge) {
+    alignas(Strazzle::String) unsigned char src_buffer[2 * sizeof(Strazzle::String)];
+    alignas(Strazzle::String) unsigned char dst_buffer[2 * sizeof(Strazzle::String)];
+
+    Strazzle::String* src = reinterpret_cast<Strazzle::String*>(src_buffer);
+    Strazzle::String* dst = reinterpret_cast<Strazzle::String*>(dst_buffer);
+
+    std::construct_at(src, "small");
+    std::construct_at(src + 1, std::string(100, 'a').c_str());
+
+    const char* data = src[1].Data();
+
+    Strazzle::_Relocate(dst, src, 2);
+
+    // A SMALL_STRING points into its new object, a LARGE_STRING keeps its heap buffer
+    EXPECT_EQ(dst[0], "small");
+    EXPECT_TRUE(IsInline(dst[0]));
+    EXPECT_EQ(dst[1].Data(), data);
+    EXPECT_EQ(dst[1].Len(), 100);
+
+    std::destroy_at(dst);
+    std::destroy_at(dst + 1);
+}
+
+TEST(StringLayout, VectorGrowthKeepsStrings) {
+    // std::vector moves the strings with the noexcept move constructor when it grows, SMALL_STRINGs and LARGE_STRINGs alike
+    std::vector<Strazzle::String> strs;
+
+    for(std::size_t k = 0; k < 100; k++) {
+        strs.emplace_back(std::string(k, 'a' + k % 26).c_str());
+    }
+
+    for(std::size_t k = 0; k < 100; k++) {
+        EXPECT_EQ(strs[k].Len(), k);
+        EXPECT_EQ(strlen(strs[k].Cstr()), k);
+    }
+}
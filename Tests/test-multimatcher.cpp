@@ -0,0 +1,220 @@
+#include "Strazzle/MultiMatcher.h"
+#include "Strazzle/String.h"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+using Occurrence = std::tuple<std::size_t, std::size_t, std::size_t>;
+
+/**
+ * @brief The (pattern, start, length) of all matches, sorted so the order of reports at the same end doesn't matter
+ */
+static std::vector<Occurrence> Occurrences(const std::vector<Strazzle::MultiMatcher::Match>& matches) {
+    std::vector<Occurrence> occurrences;
+
+    for(const Strazzle::MultiMatcher::Match& match : matches) {
+        occurrences.emplace_back(match.pattern, match.i, match.len);
+    }
+
+    std::sort(occurrences.begin(), occurrences.end());
+
+    return occurrences;
+}
+
+/**
+ * @brief Every occurrence of every pattern found by comparing at every position
+ */
+static std::vector<Occurrence> NaiveOccurrences(const std::vector<std::string>& patterns, const std::string& haystack) {
+    std::vector<Occurrence> occurrences;
+
+    for(std::size_t p = 0; p < patterns.size(); p++) {
+        if(patterns[p].empty()) continue;
+
+        for(std::size_t i = 0; i + patterns[p].size() <= haystack.size(); i++) {
+            if(haystack.compare(i, patterns[p].size(), patterns[p]) == 0) occurrences.emplace_back(p, i, patterns[p].size());
+        }
+    }
+
+    std::sort(occurrences.begin(), occurrences.end());
+
+    return occurrences;
+}
+
+/**
+ * @brief Builds a matcher from std::strings, binary safe
+ */
+static Strazzle::MultiMatcher MakeMatcher(const std::vector<std::string>& patterns) {
+    std::vector<std::pair<const char*, std::size_t>> ranges;
+
+    for(const std::string& pattern : patterns) {
+        ranges.emplace_back(pattern.data(), pattern.size());
+    }
+
+    return Strazzle::MultiMatcher(ranges);
+}
+
+/**
+ * @brief Checks the matches of patterns in haystack against the naive search and that they are reported in order of their end
+ */
+static void ExpectNaiveMatches(const std::vector<std::string>& patterns, const std::string& haystack) {
+    Strazzle::MultiMatcher matcher = MakeMatcher(patterns);
+
+    std::vector<Strazzle::MultiMatcher::Match> matches;
+
+    matcher.ForEachMatch(haystack.data(), haystack.size(), [&](const Strazzle::MultiMatcher::Match& match) {
+        matches.push_back(match);
+
+        return true;
+    });
+
+    for(std::size_t m = 1; m < matches.size(); m++) {
+        EXPECT_LE(matches[m - 1].i + matches[m - 1].len, matches[m].i + matches[m].len) << haystack;
+    }
+
+    EXPECT_EQ(Occurrences(matches), NaiveOccurrences(patterns, haystack)) << haystack;
+}
+
+TEST(MultiMatcher, OverlappingPatterns) {
+    Strazzle::MultiMatcher matcher = {"he", "she", "his", "hers"};
+
+    std::vector<Strazzle::MultiMatcher::Match> matches = matcher.FindAll(Strazzle::String("ushers"));
+
+    // she and he end at the same byte, hers overlaps both
+    EXPECT_EQ(Occurrences(matches), (std::vector<Occurrence>{{0, 2, 2}, {1, 1, 3}, {3, 2, 4}}));
+    EXPECT_EQ(matches.back().pattern, 3);
+
+    EXPECT_EQ(matcher.PatternCount(), 4);
+}
+
+TEST(MultiMatcher, SuffixPatterns) {
+    // Every pattern is a suffix of the one before, they are found through the dictionary links of the longest
+    Strazzle::MultiMatcher matcher = {"abcd", "bcd", "cd", "d"};
+
+    std::vector<Strazzle::MultiMatcher::Match> matches = matcher.FindAll(Strazzle::String("xabcdx"));
+
+    EXPECT_EQ(Occurrences(matches), (std::vector<Occurrence>{{0, 1, 4}, {1, 2, 3}, {2, 3, 2}, {3, 4, 1}}));
+
+    // A suffix pattern reached after a failed longer match
+    matches = matcher.FindAll(Strazzle::String("abcbcd"));
+
+    EXPECT_EQ(Occurrences(matches), (std::vector<Occurrence>{{1, 3, 3}, {2, 4, 2}, {3, 5, 1}}));
+}
+
+TEST(MultiMatcher, BinaryPatterns) {
+    std::vector<std::string> patterns = {std::string("a\0b", 3), std::string("\0\0", 2), std::string("\xff\x80", 2)};
+
+    std::string haystack("xa\0b\0\0\0\xff\x80\0", 10);
+
+    ExpectNaiveMatches(patterns, haystack);
+
+    Strazzle::MultiMatcher matcher = MakeMatcher(patterns);
+
+    EXPECT_EQ(matcher.FindAll(Strazzle::String("a")).size(), 0);
+    EXPECT_EQ(matcher.FindAll(Strazzle::String("ab")).size(), 0);
+}
+
+TEST(MultiMatcher, EmptyPatternNeverMatches) {
+    Strazzle::MultiMatcher matcher = {"", "b"};
+
+    EXPECT_EQ(Occurrences(matcher.FindAll(Strazzle::String("abc"))), (std::vector<Occurrence>{{1, 1, 1}}));
+    EXPECT_EQ(matcher.PatternCount(), 2);
+
+    Strazzle::MultiMatcher empty = {""};
+
+    EXPECT_FALSE(empty.Contains(Strazzle::String("abc")));
+}
+
+TEST(MultiMatcher, WithAndWithoutPrefilter) {
+    // 8 distinct first chars use the FindAny prefilter, 9 don't
+    std::vector<std::string> few  = {"abc", "bcd", "cab", "dd", "ea", "fab", "gc", "hh", "acb"};
+    std::vector<std::string> many = few;
+
+    many.push_back("ia");
+
+    std::string haystack;
+
+    std::mt19937 rng(3);
+
+    for(int k = 0; k < 2000; k++) {
+        // Mostly bytes that start no pattern, so the prefilter skips
+        haystack.push_back(rng() % 4 == 0 ? static_cast<char>('a' + rng() % 9) : static_cast<char>('p' + rng() % 8));
+    }
+
+    ExpectNaiveMatches(few, haystack);
+    ExpectNaiveMatches(many, haystack);
+
+    // The prefilter stops at the end of a haystack without any first char
+    ExpectNaiveMatches(few, std::string(100, 'z'));
+    ExpectNaiveMatches(few, std::string(100, 'z') + "ab");
+}
+
+TEST(MultiMatcher, RandomAgainstNaive) {
+    std::mt19937 rng(11);
+
+    for(int round = 0; round < 300; round++) {
+        // A small alphabet so patterns overlap and share prefixes and suffixes
+        std::size_t alphabet = 2 + rng() % 11;
+
+        std::vector<std::string> patterns(1 + rng() % 12);
+
+        for(std::string& pattern : patterns) {
+            pattern.resize(1 + rng() % 5);
+
+            for(char& c : pattern) {
+                c = static_cast<char>(rng() % alphabet);
+            }
+        }
+
+        std::string haystack(rng() % 300, '\0');
+
+        for(char& c : haystack) {
+            c = static_cast<char>(rng() % (alphabet + 1));
+        }
+
+        ExpectNaiveMatches(patterns, haystack);
+    }
+}
+
+TEST(MultiMatcher, StopsEarly) {
+    Strazzle::MultiMatcher matcher = {"a", "aa"};
+
+    Strazzle::String haystack("aaaa");
+
+    std::size_t reports = 0;
+
+    matcher.ForEachMatch(haystack, [&](const Strazzle::MultiMatcher::Match&) {
+        reports = reports + 1;
+
+        return reports < 3;
+    });
+
+    EXPECT_EQ(reports, 3);
+
+    EXPECT_TRUE(matcher.Contains(haystack));
+    EXPECT_FALSE(matcher.Contains(Strazzle::String("bbbb")));
+}
+
+TEST(MultiMatcher, FromStringsAndReferences) {
+    std::vector<Strazzle::String> strings = {Strazzle::String("needle"), Strazzle::String("a pattern that is longer than the SSO buffer")};
+
+    Strazzle::MultiMatcher from_strings(strings);
+
+    Strazzle::String haystack("find the needle and a pattern that is longer than the SSO buffer");
+
+    EXPECT_EQ(Occurrences(from_strings.FindAll(haystack)), (std::vector<Occurrence>{{0, 9, 6}, {1, 20, 44}}));
+
+    // References are not null terminated, only their bytes are patterns
+    Strazzle::String words("needle haystack");
+
+    std::vector<Strazzle::String::Reference> refs = {words.RefSubstr(0, 4), words.RefSubstr(7, 3)};
+
+    Strazzle::MultiMatcher from_refs(refs);
+
+    EXPECT_EQ(Occurrences(from_refs.FindAll(haystack)), (std::vector<Occurrence>{{0, 9, 4}}));
+    EXPECT_EQ(Occurrences(from_refs.FindAll(Strazzle::String("hayneed"))), (std::vector<Occurrence>{{0, 3, 4}, {1, 0, 3}}));
+}
@@ -0,0 +1,163 @@
+#include "Strazzle/Rope.h"
+#include "Strazzle/String.h"
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+TEST(StringOwnership, MoveConstructStealsBuffer) {
+    Strazzle::String str(std::string(100, 'a').c_str());
+
+    const char* data = str.Data();
+
+    Strazzle::String moved(std::move(str));
+
+    EXPECT_EQ(moved.Data(), data);
+    EXPECT_EQ(moved.Len(), 100);
+
+    EXPECT_EQ(str.Len(), 0);
+    EXPECT_STREQ(str.Cstr(), "");
+}
+
+TEST(StringOwnership, MoveAssignStealsBuffer) {
+    Strazzle::String str(std::string(100, 'a').c_str());
+    Strazzle::String other(std::string(200, 'b').c_str());
+
+    const char* data = str.Data();
+
+    other = std::move(str);
+
+    EXPECT_EQ(other.Data(), data);
+    EXPECT_EQ(other, std::string(100, 'a').c_str());
+
+    EXPECT_EQ(str.Len(), 0);
+    EXPECT_STREQ(str.Cstr(), "");
+
+    // The moved from string is usable again
+    str.Append("abc");
+
+    EXPECT_EQ(str, "abc");
+}
+
+TEST(StringOwnership, MoveSmallString) {
+    Strazzle::String str("short");
+
+    Strazzle::String moved(std::move(str));
+
+    EXPECT_EQ(moved, "short");
+    EXPECT_EQ(str.Len(), 0);
+}
+
+TEST(StringOwnership, AppendChains) {
+    Strazzle::String str;
+
+    str.Append("a").Append("b").Append(Strazzle::String("c"));
+
+    EXPECT_EQ(str, "abc");
+}
+
+TEST(StringOwnership, RvalueAppendReusesBuffer) {
+    Strazzle::String str(std::string(100, 'a').c_str());
+
+    str.Reserve(1000);
+
+    const char* data = str.Data();
+
+    Strazzle::String result = std::move(str).Append("b");
+
+    EXPECT_EQ(result.Data(), data);
+    EXPECT_EQ(result.Len(), 101);
+    EXPECT_EQ(result.Data()[100], 'b');
+}
+
+TEST(StringOwnership, RvalueSubstrCutsInPlace) {
+    Strazzle::String str("0123456789012345678901234567890123456789");
+
+    Strazzle::String substr = std::move(str).Substr(30, 5);
+
+    EXPECT_EQ(substr, "01234");
+
+    Strazzle::String large(std::string(100, 'a').c_str());
+
+    large.Append("bcd");
+
+    // The reserve keeps the buffer from shrinking, so the substr has to stay in it
+    large.Reserve(200);
+
+    const char* data = large.Data();
+
+    Strazzle::String tail = std::move(large).Substr(60);
+
+    EXPECT_EQ(tail.Data(), data);
+    EXPECT_EQ(tail.Len(), 43);
+    EXPECT_STREQ(tail.Cstr() + 40, "bcd");
+}
+
+static Strazzle::String MakeString() {
+    return Strazzle::String("0123456789012345678901234567890123456789");
+}
+
+TEST(StringOwnership, RvalueResultsOutliveTheTemporary) {
+    // The results own their bytes, a reference bound to them lives until the end of the scope
+    auto&& substr = MakeString().Substr(1);
+    auto&& append = MakeString().Append("x").AppendRaw("y\0", 2);
+
+    static_assert(!std::is_reference_v<decltype(MakeString().Substr(1))>);
+    static_assert(!std::is_reference_v<decltype(MakeString().Append("x"))>);
+
+    EXPECT_EQ(substr.Len(), 39);
+    EXPECT_EQ(substr.Data()[0], '1');
+    EXPECT_EQ(append.Len(), 43);
+    EXPECT_EQ(std::memcmp(append.Data() + 40, "xy\0", 4), 0);
+
+    const Strazzle::String& ref = MakeString().Substr(38).Append("z");
+
+    EXPECT_EQ(ref, "89z");
+}
+
+TEST(StringOwnership, SubstrOutOfBounds) {
+    Strazzle::String str("abc");
+
+    EXPECT_THROW(str.Substr(3), std::out_of_range);
+    EXPECT_THROW(Strazzle::String("abc").Substr(4), std::out_of_range);
+}
+
+TEST(StringOwnership, EraseBounds) {
+    Strazzle::String str("abcdef");
+
+    EXPECT_THROW(str.Erase(6), std::out_of_range);
+
+    str.Erase(4, 100);
+
+    EXPECT_EQ(str, "abcd");
+
+    str.Erase(1, 2);
+
+    EXPECT_EQ(str, "ad");
+}
+
+TEST(StringOwnership, EraseBackToSmall) {
+    Strazzle::String str(std::string(100, 'a').c_str());
+
+    str.Erase(3);
+
+    EXPECT_EQ(str, "aaa");
+    EXPECT_EQ(strlen(str.Cstr()), 3);
+}
+
+TEST(StringOwnership, RopeAdoptsString) {
+    Strazzle::String str(std::string(100, 'a').c_str());
+
+    Strazzle::Rope rope(std::move(str));
+
+    EXPECT_EQ(rope.Len(), 100);
+    EXPECT_EQ(str.Len(), 0);
+
+    rope.Insert("b", 50);
+
+    EXPECT_EQ(rope.At(50), 'b');
+    EXPECT_EQ(rope.ToString().Len(), 101);
+}
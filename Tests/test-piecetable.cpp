@@ -0,0 +1,240 @@
+#include "Strazzle/PieceTable.h"
+#include "Strazzle/String.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+
+/**
+ * @brief A file in the temp directory that is removed with the test
+ */
+struct TempFile {
+    std::string path;
+
+    TempFile(const char* name, const std::string& content) {
+        path = (std::filesystem::temp_directory_path() / ("strazzle-" + std::to_string(getpid()) + "-" + name)).string();
+
+        std::ofstream(path, std::ios::binary) << content;
+    }
+
+    ~TempFile() {
+        std::filesystem::remove(path);
+        std::filesystem::remove(path + ".tmp");
+    }
+
+    std::string Read() const {
+        std::ifstream file(path, std::ios::binary);
+
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+};
+
+/**
+ * @brief Checks the length and the bytes of the whole table
+ */
+static void ExpectText(const Strazzle::PieceTable& table, const std::string& expected) {
+    ASSERT_EQ(table.Len(), expected.size());
+
+    if(expected.empty()) return;
+
+    Strazzle::String text = table.Substr(0);
+
+    EXPECT_EQ(std::string(text.Data(), text.Len()), expected);
+}
+
+TEST(PieceTable, OpenAndSubstr) {
+    TempFile file("open", "hello piece table");
+
+    Strazzle::PieceTable table(file.path.c_str());
+
+    EXPECT_EQ(table.Len(), 17);
+    EXPECT_EQ(table.Pieces(), 1);
+    EXPECT_EQ(table.Substr(6, 5), "piece");
+    EXPECT_EQ(table.Substr(12), "table");
+    EXPECT_EQ(table.Substr(12, 100), "table");
+
+    EXPECT_THROW(table.Substr(17), std::out_of_range);
+    EXPECT_THROW(Strazzle::PieceTable("/nonexistent/strazzle"), std::runtime_error);
+}
+
+TEST(PieceTable, EditsAcrossPieces) {
+    TempFile file("edits", "0123456789");
+
+    Strazzle::PieceTable table(file.path.c_str());
+
+    table.Insert("abc", 5);
+    table.Insert("XY", 0);
+    table.Insert("!", table.Len());
+
+    EXPECT_EQ(table.Pieces(), 5);
+    ExpectText(table, "XY01234abc56789!");
+
+    // Substrs and erases that start and end inside different pieces
+    EXPECT_EQ(table.Substr(1, 8), "Y01234ab");
+    EXPECT_EQ(table.Substr(8, 5), "bc567");
+
+    table.Erase(6, 4);
+
+    ExpectText(table, "XY012356789!");
+
+    table.Erase(1, 10);
+
+    ExpectText(table, "X!");
+
+    table.Erase(0);
+
+    ExpectText(table, "");
+    EXPECT_EQ(table.Pieces(), 0);
+
+    table.Insert("again", 0);
+
+    ExpectText(table, "again");
+}
+
+TEST(PieceTable, TypingExtendsThePiece) {
+    TempFile file("typing", "0123456789");
+
+    Strazzle::PieceTable table(file.path.c_str());
+
+    // Each insertion continues the previous one, they share one ADDED piece
+    for(char c = 'a'; c <= 'z'; c++) {
+        table.Insert(std::string(1, c).c_str(), 5 + (c - 'a'));
+    }
+
+    EXPECT_EQ(table.Pieces(), 3);
+    ExpectText(table, "01234abcdefghijklmnopqrstuvwxyz56789");
+
+    // Not adjacent in the add buffer, so a new piece even though the position follows
+    table.Insert("1", 0);
+    table.Insert("2", 32);
+
+    EXPECT_EQ(table.Pieces(), 5);
+
+    table.Insert("3", 33);
+
+    EXPECT_EQ(table.Pieces(), 5);
+    ExpectText(table, "101234abcdefghijklmnopqrstuvwxyz2356789");
+}
+
+TEST(PieceTable, RandomAgainstStdString) {
+    std::string content(5000, 'a');
+
+    for(std::size_t i = 0; i < content.size(); i++) {
+        content[i] = static_cast<char>('a' + i % 26);
+    }
+
+    TempFile file("random", content);
+
+    Strazzle::PieceTable table(file.path.c_str());
+    std::string          expected = content;
+
+    std::mt19937 rng(5);
+
+    std::size_t i = 0;
+
+    for(int step = 0; step < 3000; step++) {
+        // Mostly local edits around the previous one, like typing, and some far away
+        if(rng() % 4 == 0) {
+            i = rng() % (expected.size() + 1);
+        } else {
+            std::size_t step = rng() % 7;
+
+            i = std::min(expected.size(), i + step >= 3 ? i + step - 3 : 0);
+        }
+
+        switch(rng() % 3) {
+        case 0: {
+            std::string text(1 + rng() % 10, static_cast<char>('A' + rng() % 26));
+
+            text[0] = '\0';
+
+            table.InsertRaw(text.data(), i, text.size());
+            expected.insert(i, text);
+            break;
+        }
+        case 1: {
+            if(i == expected.size()) break;
+
+            std::size_t size = rng() % 20;
+
+            table.Erase(i, size);
+            expected.erase(i, size);
+            break;
+        }
+        default: {
+            if(i == expected.size()) break;
+
+            std::size_t size = rng() % 100;
+
+            Strazzle::String substr = table.Substr(i, size);
+
+            EXPECT_EQ(std::string(substr.Data(), substr.Len()), expected.substr(i, size));
+            break;
+        }
+        }
+
+        if(step % 100 == 0) ExpectText(table, expected);
+    }
+
+    ExpectText(table, expected);
+}
+
+TEST(PieceTable, WriteRoundTrip) {
+    TempFile file("write", "line 1\nline 2\nline 3\n");
+
+    {
+        Strazzle::PieceTable table(file.path.c_str());
+
+        table.Erase(7, 7);
+        table.Insert("inserted\n", 0);
+        table.InsertRaw("\0", table.Len(), 1);
+
+        // Written over the mapped original through a temp file and a rename
+        table.Write(file.path.c_str());
+
+        EXPECT_FALSE(std::filesystem::exists(file.path + ".tmp"));
+
+        // The table still reads from the mapping of the replaced file
+        EXPECT_EQ(table.Substr(9, 6), "line 1");
+    }
+
+    EXPECT_EQ(file.Read(), std::string("inserted\nline 1\nline 3\n\0", 24));
+
+    Strazzle::PieceTable reopened(file.path.c_str());
+
+    EXPECT_EQ(reopened.Len(), 24);
+    EXPECT_EQ(reopened.Substr(16, 6), "line 3");
+}
+
+TEST(PieceTable, EmptyFile) {
+    TempFile file("empty", "");
+
+    Strazzle::PieceTable table(file.path.c_str());
+
+    EXPECT_EQ(table.Len(), 0);
+    EXPECT_EQ(table.Pieces(), 0);
+    EXPECT_THROW(table.Erase(0), std::out_of_range);
+    EXPECT_THROW(table.Insert("x", 1), std::out_of_range);
+
+    table.Write(file.path.c_str());
+
+    EXPECT_EQ(file.Read(), "");
+
+    table.Insert("text", 0);
+    table.Write(file.path.c_str());
+
+    EXPECT_EQ(file.Read(), "text");
+
+    // A moved from table is empty
+    Strazzle::PieceTable moved(std::move(table));
+
+    EXPECT_EQ(table.Len(), 0);
+    EXPECT_EQ(moved.Substr(0), "text");
+}
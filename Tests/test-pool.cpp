@@ -0,0 +1,215 @@
+#include "Strazzle/StringPool.h"
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Difference of the statistics of the pool between two points
+ */
+static Strazzle::StringPool::Stats Delta(const Strazzle::StringPool::Stats& before, const Strazzle::StringPool::Stats& after) {
+    Strazzle::StringPool::Stats delta;
+
+    delta.cache_hits  = after.cache_hits - before.cache_hits;
+    delta.shared_hits = after.shared_hits - before.shared_hits;
+    delta.misses      = after.misses - before.misses;
+    delta.frees       = after.frees - before.frees;
+
+    return delta;
+}
+
+TEST(StringPool, HitsAndMisses) {
+    std::thread([] {
+        // Starts from an empty thread cache and an empty shared free list
+        Strazzle::StringPool::Trim();
+
+        Strazzle::StringPool::Stats before = Strazzle::StringPool::GetStats();
+
+        char* a = Strazzle::StringPool::Allocate(100);
+
+        Strazzle::StringPool::Deallocate(a, 100);
+
+        char* b = Strazzle::StringPool::Allocate(120);
+
+        // Same size class, the buffer comes back from the cache of the thread
+        EXPECT_EQ(a, b);
+
+        Strazzle::StringPool::Deallocate(b, 120);
+
+        // Too small and too large sizes are not pooled
+        char* small = Strazzle::StringPool::Allocate(8);
+        char* large = Strazzle::StringPool::Allocate(std::size_t(1) << 21);
+
+        Strazzle::StringPool::Deallocate(small, 8);
+        Strazzle::StringPool::Deallocate(large, std::size_t(1) << 21);
+
+        Strazzle::StringPool::Stats delta = Delta(before, Strazzle::StringPool::GetStats());
+
+        EXPECT_EQ(delta.cache_hits, 1);
+        EXPECT_EQ(delta.shared_hits, 0);
+        EXPECT_EQ(delta.misses, 3);
+        EXPECT_EQ(delta.frees, 4);
+        EXPECT_EQ(delta.Allocations(), 4);
+        EXPECT_DOUBLE_EQ(delta.HitRate(), 0.25);
+    }).join();
+}
+
+TEST(StringPool, TrimEmptiesCacheAndSharedList) {
+    std::thread([] {
+        Strazzle::StringPool::Trim();
+
+        std::vector<char*> buffers;
+
+        for(int k = 0; k < 200; k++) {
+            buffers.push_back(Strazzle::StringPool::Allocate(1000));
+        }
+
+        // More than a cache holds, part of them goes to the shared free list
+        for(char* p : buffers) {
+            Strazzle::StringPool::Deallocate(p, 1000);
+        }
+
+        Strazzle::StringPool::Trim();
+
+        Strazzle::StringPool::Stats before = Strazzle::StringPool::GetStats();
+
+        char* p = Strazzle::StringPool::Allocate(1000);
+
+        Strazzle::StringPool::Deallocate(p, 1000);
+
+        Strazzle::StringPool::Stats delta = Delta(before, Strazzle::StringPool::GetStats());
+
+        EXPECT_EQ(delta.misses, 1);
+        EXPECT_EQ(delta.cache_hits + delta.shared_hits, 0);
+    }).join();
+}
+
+TEST(StringPool, CrossThreadFree) {
+    Strazzle::StringPool::Trim();
+
+    std::vector<Strazzle::PooledString> strings;
+
+    std::thread([&] {
+        for(int k = 0; k < 100; k++) {
+            strings.emplace_back(std::string(3000, static_cast<char>('a' + k % 26)).c_str());
+        }
+    }).join();
+
+    Strazzle::StringPool::Stats before = Strazzle::StringPool::GetStats();
+
+    // Freed by another thread than the one that allocated them, the thread returns them to the shared free list when it exits
+    std::thread([&] {
+        for(std::size_t k = 0; k < strings.size(); k++) {
+            EXPECT_EQ(strings[k].Len(), 3000);
+            EXPECT_EQ(strings[k].Data()[2999], static_cast<char>('a' + k % 26));
+        }
+
+        strings.clear();
+    }).join();
+
+    std::thread([] {
+        std::vector<Strazzle::PooledString> reused;
+
+        for(int k = 0; k < 100; k++) {
+            reused.emplace_back(std::string(3000, 'z').c_str());
+        }
+    }).join();
+
+    Strazzle::StringPool::Stats delta = Delta(before, Strazzle::StringPool::GetStats());
+
+    EXPECT_EQ(delta.frees, 200);
+    EXPECT_EQ(delta.misses, 0);
+    EXPECT_GE(delta.shared_hits, 1);
+
+    Strazzle::StringPool::Trim();
+}
+
+TEST(StringPool, RefillTakesOneBatch) {
+    Strazzle::StringPool::Trim();
+
+    // A thread leaves several batches of one size class on the shared free list
+    std::thread([] {
+        std::vector<char*> buffers;
+
+        for(int k = 0; k < 200; k++) {
+            buffers.push_back(Strazzle::StringPool::Allocate(4096));
+        }
+
+        for(char* p : buffers) {
+            Strazzle::StringPool::Deallocate(p, 4096);
+        }
+    }).join();
+
+    Strazzle::StringPool::Stats before = Strazzle::StringPool::GetStats();
+
+    // This thread refills and keeps its cache, another thread still finds batches
+    char* p = Strazzle::StringPool::Allocate(4096);
+
+    std::thread([] {
+        char* q = Strazzle::StringPool::Allocate(4096);
+
+        Strazzle::StringPool::Deallocate(q, 4096);
+    }).join();
+
+    Strazzle::StringPool::Stats delta = Delta(before, Strazzle::StringPool::GetStats());
+
+    EXPECT_EQ(delta.shared_hits, 2);
+    EXPECT_EQ(delta.misses, 0);
+
+    Strazzle::StringPool::Deallocate(p, 4096);
+    Strazzle::StringPool::Trim();
+}
+
+TEST(StringPool, FreeAfterThreadCacheIsDestroyed) {
+    Strazzle::StringPool::Trim();
+
+    Strazzle::StringPool::Stats before = Strazzle::StringPool::GetStats();
+
+    std::thread([] {
+        // Built before the cache of the thread, so it is destroyed after it
+        thread_local Strazzle::PooledString late;
+
+        late.Append(std::string(100000, 'a').c_str());
+    }).join();
+
+    Strazzle::StringPool::Stats delta = Delta(before, Strazzle::StringPool::GetStats());
+
+    EXPECT_EQ(delta.misses, 1);
+    EXPECT_EQ(delta.frees, 1);
+
+    // The buffer was returned to the shared free list
+    char* p = Strazzle::StringPool::Allocate(100001);
+
+    delta = Delta(before, Strazzle::StringPool::GetStats());
+
+    EXPECT_EQ(delta.shared_hits, 1);
+
+    Strazzle::StringPool::Deallocate(p, 100001);
+    Strazzle::StringPool::Trim();
+}
+
+TEST(StringPool, ConcurrentChurn) {
+    std::vector<std::thread> threads;
+
+    for(int t = 0; t < 4; t++) {
+        threads.emplace_back([t] {
+            std::vector<Strazzle::PooledString> live(64);
+
+            for(int k = 0; k < 5000; k++) {
+                Strazzle::PooledString str;
+
+                str.Resize(32 + (k * 37 + t) % 2000, static_cast<char>('a' + t));
+
+                EXPECT_EQ(str.Data()[str.Len() - 1], static_cast<char>('a' + t));
+
+                live[k % live.size()] = std::move(str);
+            }
+        });
+    }
+
+    for(std::thread& thread : threads) {
+        thread.join();
+    }
+}
@@ -0,0 +1,60 @@
+#include "Strazzle/String.h"
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+
+TEST(StringResize, FillChar) {
+    Strazzle::String str("ab");
+
+    str.Resize(5, 'x');
+
+    EXPECT_EQ(str, "abxxx");
+
+    str.Resize(1);
+
+    EXPECT_EQ(str, "a");
+}
+
+TEST(StringResize, FillStringStopsAtSize) {
+    // The last copy of the fill is cut short, the length must not step past size
+    for(std::size_t size = 2; size < 100; size++) {
+        Strazzle::String str("ab");
+
+        str.Resize(size, "123");
+
+        std::string expected = "ab";
+
+        while(expected.size() < size) {
+            expected.append("123");
+        }
+
+        expected.resize(size);
+
+        EXPECT_EQ(str.Len(), size);
+        EXPECT_EQ(strlen(str.Cstr()), size);
+        EXPECT_STREQ(str.Cstr(), expected.c_str());
+    }
+}
+
+TEST(StringResize, FillStringShrinks) {
+    Strazzle::String str(std::string(100, 'a').c_str());
+
+    str.Resize(3, "xyz");
+
+    EXPECT_EQ(str, "aaa");
+}
+
+TEST(StringResize, EmptyFillString) {
+    Strazzle::String str("ab");
+
+    // Growing needs at least one byte of fill, the string is left as it was
+    EXPECT_THROW(str.Resize(5, ""), std::invalid_argument);
+    EXPECT_EQ(str, "ab");
+
+    str.Resize(2, "");
+    str.Resize(1, "");
+
+    EXPECT_EQ(str, "a");
+}
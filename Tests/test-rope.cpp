@@ -0,0 +1,209 @@
+#include "Strazzle/Rope.h"
+#include "Strazzle/String.h"
+
+#include <gtest/gtest.h>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Copies the rope into a std::string through its chunks
+ */
+static std::string Chunks(const Strazzle::Rope& rope) {
+    std::string str;
+
+    rope.ForEachChunk([&](const char* chunk, std::size_t size) { str.append(chunk, size); });
+
+    return str;
+}
+
+/**
+ * @brief Checks the length, the bytes and a few chars of the rope against the expected string
+ */
+static void ExpectRope(const Strazzle::Rope& rope, const std::string& expected, std::mt19937& rng) {
+    ASSERT_EQ(rope.Len(), expected.size());
+
+    EXPECT_EQ(rope.ToString().Len(), expected.size());
+    EXPECT_STREQ(rope.ToString().Cstr(), expected.c_str());
+    EXPECT_EQ(Chunks(rope), expected);
+
+    for(int k = 0; k < 8 && !expected.empty(); k++) {
+        std::size_t i = rng() % expected.size();
+
+        EXPECT_EQ(rope.At(i), expected[i]) << "at " << i;
+    }
+}
+
+/**
+ * @brief A string of size chars, the chars follow the position so misplaced pieces show up
+ */
+static std::string MakeText(std::size_t size, std::mt19937& rng) {
+    std::string text(size, 'a');
+
+    std::size_t first = rng() % 26;
+
+    for(std::size_t i = 0; i < size; i++) {
+        text[i] = static_cast<char>('a' + (first + i) % 26);
+    }
+
+    return text;
+}
+
+/**
+ * @brief Sizes around the leaf size, so edits land on and cross the boundaries of the leaves
+ */
+static std::size_t EditSize(std::mt19937& rng) {
+    switch(rng() % 4) {
+    case 0:
+        return rng() % 8;
+    case 1:
+        return Strazzle::ROPE_LEAF_SIZE - 4 + rng() % 8;
+    case 2:
+        return rng() % (3 * Strazzle::ROPE_LEAF_SIZE);
+    default:
+        return rng() % 200;
+    }
+}
+
+TEST(Rope, BuildsLeavesAtTheBoundary) {
+    std::mt19937 rng(1);
+
+    for(std::size_t size : {std::size_t(0), std::size_t(1), Strazzle::ROPE_LEAF_SIZE - 2, Strazzle::ROPE_LEAF_SIZE - 1, Strazzle::ROPE_LEAF_SIZE,
+            2 * Strazzle::ROPE_LEAF_SIZE - 2, 2 * Strazzle::ROPE_LEAF_SIZE - 1, 10 * Strazzle::ROPE_LEAF_SIZE + 3}) {
+        std::string text = MakeText(size, rng);
+
+        ExpectRope(Strazzle::Rope(text.c_str()), text, rng);
+
+        // Adopting a string keeps a single leaf of any size
+        ExpectRope(Strazzle::Rope(Strazzle::String(text.c_str())), text, rng);
+    }
+}
+
+TEST(Rope, LocalInsertFillsLeafUpToTheBoundary) {
+    std::mt19937 rng(2);
+
+    Strazzle::Rope rope;
+    std::string    expected;
+
+    // Char by char inserts grow one leaf until it is full and then spill into new leaves
+    for(std::size_t k = 0; k < 3 * Strazzle::ROPE_LEAF_SIZE; k++) {
+        std::size_t i = rng() % (expected.size() + 1);
+        char        c = static_cast<char>('a' + k % 26);
+
+        rope.Insert(std::string(1, c).c_str(), i);
+        expected.insert(expected.begin() + i, c);
+    }
+
+    ExpectRope(rope, expected, rng);
+}
+
+TEST(Rope, RandomAgainstStdString) {
+    std::mt19937 rng(3);
+
+    Strazzle::Rope rope;
+    std::string    expected;
+
+    // Earlier versions, they must not change when the rope is edited later
+    std::vector<std::pair<Strazzle::Rope, std::string>> snapshots;
+
+    for(int step = 0; step < 2000; step++) {
+        switch(rng() % 6) {
+        case 0: {
+            std::string text = MakeText(EditSize(rng), rng);
+            std::size_t i    = rng() % (expected.size() + 1);
+
+            rope.Insert(text.c_str(), i);
+            expected.insert(i, text);
+            break;
+        }
+        case 1: {
+            std::string text = MakeText(EditSize(rng), rng);
+
+            rope.Append(text.c_str());
+            expected.append(text);
+            break;
+        }
+        case 2: {
+            if(expected.empty()) break;
+
+            std::size_t i    = rng() % expected.size();
+            std::size_t size = EditSize(rng);
+
+            rope.Erase(i, size);
+            expected.erase(i, size);
+            break;
+        }
+        case 3: {
+            if(expected.empty()) break;
+
+            std::size_t i    = rng() % expected.size();
+            std::size_t size = EditSize(rng);
+
+            Strazzle::Rope substr = rope.Substr(i, size);
+
+            ExpectRope(substr, expected.substr(i, size), rng);
+
+            // Shares the leaves of the substr, inserted into the middle of the rope
+            std::size_t at = rng() % (expected.size() + 1);
+
+            rope.Insert(substr, at);
+            expected.insert(at, expected.substr(i, size));
+            break;
+        }
+        case 4: {
+            if(expected.empty()) break;
+
+            std::size_t i    = rng() % expected.size();
+            std::size_t size = EditSize(rng);
+
+            Strazzle::Rope::Reference ref = rope.RefSubstr(i, size);
+
+            EXPECT_EQ(ref.ToString(), Strazzle::String(expected.substr(i, size).c_str()));
+
+            Strazzle::Rope other(MakeText(EditSize(rng), rng).c_str());
+            std::string    other_expected = other.ToString().Cstr();
+
+            other.Append(rope);
+            other_expected.append(expected);
+
+            ExpectRope(other, other_expected, rng);
+            break;
+        }
+        default:
+            if(snapshots.size() < 16) snapshots.emplace_back(rope, expected);
+            break;
+        }
+
+        // Keeps the rope from growing without bound
+        if(expected.size() > 64 * Strazzle::ROPE_LEAF_SIZE) {
+            rope.Erase(0, expected.size() / 2);
+            expected.erase(0, expected.size() / 2);
+        }
+
+        if(step % 50 == 0) ExpectRope(rope, expected, rng);
+    }
+
+    ExpectRope(rope, expected, rng);
+
+    for(const auto& [snapshot, snapshot_expected] : snapshots) {
+        ExpectRope(snapshot, snapshot_expected, rng);
+    }
+}
+
+TEST(Rope, OutOfBounds) {
+    Strazzle::Rope rope("abc");
+
+    EXPECT_THROW(rope.Insert("x", 4), std::out_of_range);
+    EXPECT_THROW(rope.Erase(3), std::out_of_range);
+    EXPECT_THROW(rope.Substr(3), std::out_of_range);
+    EXPECT_THROW(rope.At(3), std::out_of_range);
+
+    Strazzle::Rope::Reference ref = rope.RefSubstr(1, 2);
+
+    rope.Erase(1);
+
+    // The base got shorter than the reference
+    EXPECT_THROW(ref.ToString(), std::out_of_range);
+}
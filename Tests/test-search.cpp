@@ -0,0 +1,223 @@
+#include "Strazzle/Search.h"
+#include "Strazzle/String.h"
+
+#include <gtest/gtest.h>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Get the kernels of every instruction set the cpu supports, so each is checked and not only the one that is dispatched to
+ */
+static std::vector<std::pair<const char*, Strazzle::_SearchKernels>> SupportedKernels() {
+    std::vector<std::pair<const char*, Strazzle::_SearchKernels>> kernels;
+
+    kernels.push_back({"scalar", {Strazzle::_FindCharScalar, Strazzle::_RFindCharScalar, Strazzle::_CountCharScalar, Strazzle::_FindScalar,
+                                  Strazzle::_RFindScalar, Strazzle::_FindAnyScalar, Strazzle::_MismatchScalar}});
+
+#ifdef STRAZZLE_SEARCH_X86
+    __builtin_cpu_init();
+
+    if(__builtin_cpu_supports("sse2")) {
+        kernels.push_back({"sse2", {Strazzle::_FindCharSse2, Strazzle::_RFindCharSse2, Strazzle::_CountCharSse2, Strazzle::_FindSse2,
+                                    Strazzle::_RFindSse2, Strazzle::_FindAnySse2, Strazzle::_MismatchSse2}});
+    }
+
+    if(__builtin_cpu_supports("avx2")) {
+        kernels.push_back({"avx2", {Strazzle::_FindCharAvx2, Strazzle::_RFindCharAvx2, Strazzle::_CountCharAvx2, Strazzle::_FindAvx2,
+                                    Strazzle::_RFindAvx2, Strazzle::_FindAnyAvx2, Strazzle::_MismatchAvx2}});
+    }
+
+    if(__builtin_cpu_supports("avx512bw")) {
+        kernels.push_back({"avx512", {Strazzle::_FindCharAvx512, Strazzle::_RFindCharAvx512, Strazzle::_CountCharAvx512, Strazzle::_FindAvx512,
+                                      Strazzle::_RFindAvx512, Strazzle::_FindAnyAvx512, Strazzle::_MismatchAvx512}});
+    }
+#endif
+
+    return kernels;
+}
+
+/**
+ * @brief Get a haystack of two letters, so short needles match often and the kernels have to reject many candidates
+ */
+static std::string Haystack(std::size_t size, uint32_t seed) {
+    std::string str(size, 'a');
+
+    for(std::size_t i = 0; i < size; i++) {
+        seed   = seed * 1664525 + 1013904223;
+        str[i] = (seed >> 28) & 1 ? 'b' : 'a';
+    }
+
+    return str;
+}
+
+static std::size_t NaiveCount(std::string_view str, char c) {
+    std::size_t count = 0;
+
+    for(char k : str) {
+        count = count + (k == c);
+    }
+
+    return count;
+}
+
+// Sizes around the 16, 32 and 64 byte vectors, the kernels switch to their tails there
+static const std::size_t SIZES[] = {1, 2, 3, 7, 15, 16, 17, 31, 32, 33, 47, 63, 64, 65, 95, 127, 128, 129, 191, 255, 256, 257};
+
+TEST(SearchKernels, FindCharMatchesNaive) {
+    for(const auto& [name, kernels] : SupportedKernels()) {
+        SCOPED_TRACE(name);
+
+        for(std::size_t size : SIZES) {
+            // One 'x' at every position and none at all, also at an unaligned start
+            for(std::size_t offset = 0; offset < 3; offset++) {
+                std::string buffer = Haystack(size + offset, static_cast<uint32_t>(size));
+
+                for(std::size_t i = 0; i <= size; i++) {
+                    std::string str = buffer;
+
+                    if(i < size) str[offset + i] = 'x';
+
+                    std::string_view view(str.data() + offset, size);
+
+                    EXPECT_EQ(kernels.find_char(view.data(), size, 'x'), view.find('x')) << "size " << size << " i " << i;
+                    EXPECT_EQ(kernels.rfind_char(view.data(), size, 'x'), view.rfind('x')) << "size " << size << " i " << i;
+                }
+            }
+
+            std::string str = Haystack(size, static_cast<uint32_t>(size) + 1);
+
+            EXPECT_EQ(kernels.find_char(str.data(), size, 'b'), str.find('b')) << "size " << size;
+            EXPECT_EQ(kernels.rfind_char(str.data(), size, 'b'), str.rfind('b')) << "size " << size;
+        }
+    }
+}
+
+TEST(SearchKernels, CountCharMatchesNaive) {
+    for(const auto& [name, kernels] : SupportedKernels()) {
+        SCOPED_TRACE(name);
+
+        EXPECT_EQ(kernels.count_char("", 0, 'a'), 0);
+
+        for(std::size_t size : SIZES) {
+            for(std::size_t offset = 0; offset < 3; offset++) {
+                std::string      str = Haystack(size + offset, static_cast<uint32_t>(size * 3 + offset));
+                std::string_view view(str.data() + offset, size);
+
+                EXPECT_EQ(kernels.count_char(view.data(), size, 'a'), NaiveCount(view, 'a')) << "size " << size;
+                EXPECT_EQ(kernels.count_char(view.data(), size, 'x'), 0) << "size " << size;
+            }
+
+            // Every byte matching, which overflows a per lane counter that isn't flushed often enough
+            std::string same(size, 'a');
+
+            EXPECT_EQ(kernels.count_char(same.data(), size, 'a'), size);
+        }
+
+        std::string large(100000, 'a');
+
+        EXPECT_EQ(kernels.count_char(large.data(), large.size(), 'a'), large.size());
+    }
+}
+
+TEST(SearchKernels, FindMatchesNaive) {
+    const std::size_t NEEDLE_SIZES[] = {2, 3, 4, 7, 15, 16, 17, 31, 32, 33, 63, 64, 65};
+
+    for(const auto& [name, kernels] : SupportedKernels()) {
+        SCOPED_TRACE(name);
+
+        for(std::size_t size : SIZES) {
+            std::string str = Haystack(size, static_cast<uint32_t>(size) * 7);
+
+            for(std::size_t needle_size : NEEDLE_SIZES) {
+                if(needle_size > size) break;
+
+                // Needles cut out of the haystack are found, the same with the last byte changed likely are not
+                for(std::size_t i = 0; i + needle_size <= size; i = i + 1 + size / 8) {
+                    std::string needle = str.substr(i, needle_size);
+
+                    EXPECT_EQ(kernels.find(str.data(), size, needle.data(), needle_size), str.find(needle))
+                        << "size " << size << " needle " << needle;
+                    EXPECT_EQ(kernels.rfind(str.data(), size, needle.data(), needle_size), str.rfind(needle))
+                        << "size " << size << " needle " << needle;
+
+                    needle.back() = 'x';
+
+                    EXPECT_EQ(kernels.find(str.data(), size, needle.data(), needle_size), str.find(needle))
+                        << "size " << size << " needle " << needle;
+                    EXPECT_EQ(kernels.rfind(str.data(), size, needle.data(), needle_size), str.rfind(needle))
+                        << "size " << size << " needle " << needle;
+                }
+
+                // A needle only at the very end and only at the very start
+                std::string end    = std::string(size - 1, 'a') + "b";
+                std::string needle = std::string(needle_size - 1, 'a') + "b";
+
+                EXPECT_EQ(kernels.find(end.data(), size, needle.data(), needle_size), size - needle_size) << "size " << size;
+                EXPECT_EQ(kernels.rfind(end.data(), size, needle.data(), needle_size), size - needle_size) << "size " << size;
+
+                std::string start(size, 'a');
+
+                start[0] = 'b';
+
+                needle.assign(needle_size, 'a');
+                needle[0] = 'b';
+
+                EXPECT_EQ(kernels.find(start.data(), size, needle.data(), needle_size), 0) << "size " << size;
+                EXPECT_EQ(kernels.rfind(start.data(), size, needle.data(), needle_size), 0) << "size " << size;
+            }
+        }
+    }
+}
+
+TEST(StringSearch, FindAndRFindWithPos) {
+    std::string      expected = Haystack(300, 42);
+    Strazzle::String str(expected.c_str());
+
+    for(std::size_t pos = 0; pos <= 301; pos = pos + 13) {
+        EXPECT_EQ(str.Find('b', pos), expected.find('b', pos)) << "pos " << pos;
+        EXPECT_EQ(str.RFind('b', pos), expected.rfind('b', pos)) << "pos " << pos;
+        EXPECT_EQ(str.Find("abba", pos), expected.find("abba", pos)) << "pos " << pos;
+        EXPECT_EQ(str.RFind("abba", pos), expected.rfind("abba", pos)) << "pos " << pos;
+        EXPECT_EQ(str.Find("", pos), expected.find("", pos)) << "pos " << pos;
+    }
+
+    EXPECT_EQ(str.RFind("abba"), expected.rfind("abba"));
+    EXPECT_EQ(str.Find(std::string(301, 'a').c_str()), Strazzle::NPOS);
+}
+
+TEST(StringSearch, CountAndContains) {
+    Strazzle::String str("abababa");
+
+    EXPECT_EQ(str.Count('a'), 4);
+    EXPECT_EQ(str.Count("aba"), 2);
+    EXPECT_EQ(str.Count(""), 0);
+
+    EXPECT_TRUE(str.Contains("bab"));
+    EXPECT_TRUE(str.Contains('b'));
+    EXPECT_FALSE(str.Contains("bb"));
+}
+
+TEST(StringSearch, EmbeddedNuls) {
+    Strazzle::String str;
+
+    str.AppendRaw("ab\0cd\0cd", 8);
+
+    EXPECT_EQ(str.Find('\0'), 2);
+    EXPECT_EQ(str.RFind('\0'), 5);
+    EXPECT_EQ(str.Find("\0cd"), 2);
+    EXPECT_EQ(str.RFind("\0cd"), 5);
+    EXPECT_EQ(str.Count("\0cd"), 2);
+}
+
+TEST(StringSearch, Reference) {
+    Strazzle::String str("xxabcabcxx");
+
+    Strazzle::String::Reference ref = str.RefSubstr(2, 6);
+
+    EXPECT_EQ(ref.Find("abc"), 0);
+    EXPECT_EQ(ref.RFind("abc"), 3);
+    EXPECT_EQ(ref.Find('x'), Strazzle::NPOS);
+    EXPECT_EQ(ref.Count('a'), 2);
+}
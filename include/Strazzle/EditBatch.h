@@ -0,0 +1,183 @@
+#pragma once
+
+#include "Strazzle/String.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace Strazzle {
+/**
+ * @brief Collects insertions, erasures and replacements by their offset in the original string and applies them in one pass
+ *        Applying k edits one by one moves the tail k times, a batch copies every byte once into a single allocation of the final size
+ *        Erased ranges may not overlap and nothing may be inserted strictly inside an erased range, several insertions at the same
+ *        offset are applied in the order they were added. The inserted bytes are copied into the batch
+ */
+class EditBatch {
+#ifdef STRAZZLE_DEBUG_ALL_PUBLIC
+  public:
+#endif
+    /**
+     * @brief A single edit, erases erase_len bytes at pos and inserts text_len bytes of the text buffer in their place
+     */
+    struct Edit {
+        // Offset in the original string
+        std::size_t pos;
+
+        // Number of bytes to erase
+        std::size_t erase_len;
+
+        // Offset of the inserted bytes in the text buffer
+        std::size_t text_off;
+
+        // Number of bytes to insert
+        std::size_t text_len;
+    };
+
+    // The edits in the order they were added, sorted by pos once applied
+    std::vector<Strazzle::EditBatch::Edit> _edits;
+
+    // Bytes of all insertions
+    Strazzle::String _text;
+
+  public:
+    /**
+     * @brief Insert exactly size bytes of str at offset i of the original string. Binary safe
+     */
+    Strazzle::EditBatch& InsertRaw(const char* str, std::size_t i, std::size_t size) {
+        return EditBatch::ReplaceRaw(i, 0, str, size);
+    }
+
+    /**
+     * @brief Insert str at offset i of the original string
+     * @param str A C string, string literal, char buffer, String or Reference
+     */
+    template<typename Str>
+    Strazzle::EditBatch& Insert(Str&& str, std::size_t i) {
+        auto [data, size] = Strazzle::_Bytes(std::forward<Str>(str));
+
+        return EditBatch::ReplaceRaw(i, 0, data, size);
+    }
+
+    /**
+     * @brief Erase size bytes at offset i of the original string, the range is clamped to the end of the string
+     */
+    Strazzle::EditBatch& Erase(std::size_t i, std::size_t size = SIZE_MAX) {
+        return EditBatch::ReplaceRaw(i, size, "", 0);
+    }
+
+    /**
+     * @brief Replace size bytes at offset i of the original string with exactly str_size bytes of str. Binary safe
+     */
+    Strazzle::EditBatch& ReplaceRaw(std::size_t i, std::size_t size, const char* str, std::size_t str_size) {
+        _edits.push_back({i, size, _text.Len(), str_size});
+
+        _text.AppendRaw(str, str_size);
+
+        return *this;
+    }
+
+    /**
+     * @brief Replace size bytes at offset i of the original string with str
+     * @param str A C string, string literal, char buffer, String or Reference
+     */
+    template<typename Str>
+    Strazzle::EditBatch& Replace(std::size_t i, std::size_t size, Str&& str) {
+        auto [data, len] = Strazzle::_Bytes(std::forward<Str>(str));
+
+        return EditBatch::ReplaceRaw(i, size, data, len);
+    }
+
+    /**
+     * @brief Applies all edits to str, the result is built in one new buffer of the final size
+     *        The batch is kept so it can be applied again, see Clear
+     */
+    template<Strazzle::StringAllocator Allocator, std::size_t SSOSize>
+    STRAZZLE_ENTRY_POINT void Apply(Strazzle::BasicString<Allocator, SSOSize>& str) {
+        Strazzle::_CallerScope caller(__builtin_return_address(0));
+
+        if(_edits.empty()) return;
+
+        std::stable_sort(_edits.begin(), _edits.end(), [](const Edit& a, const Edit& b) { return a.pos < b.pos; });
+
+        const char* src = str.Data();
+        std::size_t len = str.Len();
+
+        // First pass validates the edits and sums up the final length
+        std::size_t new_len = len;
+        std::size_t cursor  = 0;
+        std::size_t last    = SIZE_MAX;
+
+        for(const Edit& edit : _edits) {
+            if(edit.pos > len) throw std::out_of_range("Index is out of bounds! << Strazzle::EditBatch::Apply()\n");
+
+            if(edit.pos < cursor && !(edit.pos == last && edit.erase_len == 0))
+                throw std::invalid_argument("Edits overlap! << Strazzle::EditBatch::Apply()\n");
+
+            std::size_t erase_len = std::min(edit.erase_len, len - edit.pos);
+
+            new_len = new_len - erase_len + edit.text_len;
+            cursor  = std::max(cursor, edit.pos + erase_len);
+            last    = edit.pos;
+        }
+
+        Strazzle::BasicString<Allocator, SSOSize> out(str._allocator);
+
+        out.ResizeAllocation(new_len + 1);
+
+        char* dst = out.Buffer();
+
+        // Second pass copies the kept ranges of str and the inserted bytes
+        cursor = 0;
+
+        for(const Edit& edit : _edits) {
+            if(edit.pos > cursor) {
+                std::memcpy(dst, src + cursor, edit.pos - cursor);
+
+                dst    = dst + edit.pos - cursor;
+                cursor = edit.pos;
+            }
+
+            std::memcpy(dst, _text.Data() + edit.text_off, edit.text_len);
+
+            dst    = dst + edit.text_len;
+            cursor = std::max(cursor, edit.pos + std::min(edit.erase_len, len - edit.pos));
+        }
+
+        std::memcpy(dst, src + cursor, len - cursor);
+
+        Strazzle::_CountStat(Strazzle::Stat::BYTES_COPIED, new_len);
+
+        out.SetLen(new_len);
+
+        out.Buffer()[new_len] = '\0';
+
+        str = std::move(out);
+    }
+
+    /**
+     * @brief Get the number of edits in the batch
+     */
+    std::size_t Len() const {
+        return _edits.size();
+    }
+
+    /**
+     * @brief Drops all edits, the memory of the batch is kept for the next one
+     */
+    void Clear() {
+        _edits.clear();
+
+        // Reserving the allocated size keeps the next insertions from shrinking the heap buffer of the text
+        if(_text.GetMode() == Strazzle::String::Mode::LARGE_STRING) {
+            _text._large._reserved_exp = _text._large._allocated_exp;
+        }
+
+        _text.SetLen(0);
+
+        _text.Buffer()[0] = '\0';
+    }
+};
+} // namespace Strazzle
@@ -0,0 +1,373 @@
+#pragma once
+
+#include "Strazzle/String.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace Strazzle {
+// An edit at most this many bytes away from the previous one is local and is made in the gap
+const std::size_t GAP_LOCALITY = 256;
+
+// Smallest heap buffer of a gap string
+const std::size_t GAP_MIN_SIZE = 64;
+
+/**
+ * @brief String for editing workloads, keeps a movable gap of free bytes in the buffer
+ *        While edits stay local (GAP_BUFFER) the gap follows them, so an insertion or erasure only moves the bytes between the
+ *        gap and the edit instead of the whole tail. Once an edit lands far from the previous one the string falls back to
+ *        CONTIGUOUS mode, which edits like Strazzle::String and keeps the gap at the end, and a local edit switches back again
+ *        The gap is closed lazily by Cstr and Data, the next local edit reopens it. Both write to the string, so they are not const,
+ *        ToString copies a const GapString out without touching its gap
+ * @tparam Allocator Allocator for the heap buffer
+ */
+template<Strazzle::StringAllocator Allocator = Strazzle::MallocAllocator>
+class BasicGapString {
+#ifdef STRAZZLE_DEBUG_ALL_PUBLIC
+  public:
+#endif
+    enum class Mode : uint8_t { CONTIGUOUS = 0, GAP_BUFFER = 1 };
+
+    // Heap buffer, the bytes before the gap, the gap and the bytes after the gap
+    char* _data = nullptr;
+
+    // Size of the heap buffer
+    std::size_t _capacity = 0;
+
+    // Start of the gap, equal to the position of the next char inserted in the gap
+    std::size_t _gap_start = 0;
+
+    // End of the gap, there is always at least one byte of gap so the null terminator fits
+    std::size_t _gap_end = 0;
+
+    // Position right behind the last edit, decides whether the next edit is local
+    std::size_t _last = 0;
+
+    // Current mode
+    Mode _mode = Mode::CONTIGUOUS;
+
+    // Allocator of the heap buffer
+    [[no_unique_address]] Allocator _allocator;
+
+  public:
+    BasicGapString(const Allocator& allocator = Allocator()) : _allocator(allocator) {
+    }
+
+    BasicGapString(const char* str, std::size_t size = SIZE_MAX, const Allocator& allocator = Allocator()) : _allocator(allocator) {
+        BasicGapString::AppendRaw(str, std::min(strlen(str), size));
+    }
+
+    /**
+     * @brief Copies the bytes of any byte range, eg a Strazzle::String
+     */
+    template<Strazzle::ByteRange Range>
+    explicit BasicGapString(const Range& range, const Allocator& allocator = Allocator()) : _allocator(allocator) {
+        BasicGapString::AppendRaw(range.Data(), range.Len());
+    }
+
+    /**
+     * @brief Copy constructor, the copy is contiguous and its buffer is only as large as needed
+     */
+    BasicGapString(const BasicGapString& str) : _allocator(str._allocator) {
+        BasicGapString::AppendGapString(str);
+    }
+
+    /**
+     * @brief Move constructor, steals the buffer of str. str is left empty
+     */
+    BasicGapString(BasicGapString&& str) noexcept : _allocator(str._allocator) {
+        BasicGapString::Steal(str);
+    }
+
+    ~BasicGapString() {
+        BasicGapString::Free();
+    }
+
+    BasicGapString& operator=(const BasicGapString& str) {
+        if(this == &str) return *this;
+
+        _gap_start = 0;
+        _gap_end   = _capacity;
+        _last      = 0;
+        _mode      = Mode::CONTIGUOUS;
+
+        BasicGapString::AppendGapString(str);
+
+        return *this;
+    }
+
+    BasicGapString& operator=(BasicGapString&& str) noexcept {
+        if(this == &str) return *this;
+
+        BasicGapString::Free();
+
+        _allocator = str._allocator;
+
+        BasicGapString::Steal(str);
+
+        return *this;
+    }
+
+    /**
+     * @brief Insert exactly size bytes of str at a specified position. Binary safe, str does not need to be null terminated
+     * @param str The bytes to insert.
+     * @param i The position to insert at.
+     * @param size The number of bytes to insert.
+     */
+    void InsertRaw(const char* str, std::size_t i, std::size_t size) {
+        std::size_t len = BasicGapString::Len();
+
+        if(i > len) throw std::out_of_range("Index is out of bounds!\n << Strazzle::BasicGapString::InsertRaw()");
+
+        // str may point into this string and move along with the gap, insert a copy
+        if(BasicGapString::Owns(str)) {
+            BasicGapString copy(_allocator);
+
+            copy.AppendRaw(str, size);
+
+            BasicGapString::InsertRaw(copy._data, i, size);
+            return;
+        }
+
+        BasicGapString::Grow(size);
+
+        if(BasicGapString::IsLocal(i)) {
+            _mode = Mode::GAP_BUFFER;
+
+            BasicGapString::MoveGap(i);
+        } else {
+            _mode = Mode::CONTIGUOUS;
+
+            BasicGapString::MoveGap(len);
+
+            std::memmove(_data + i + size, _data + i, len - i);
+        }
+
+        std::memcpy(_data + i, str, size);
+
+        _gap_start = _gap_start + size;
+        _last      = i + size;
+    }
+
+    /**
+     * @brief Insert str at a specified position
+     * @param str A C string, string literal, char buffer, String or Reference
+     * @param i The position to insert at.
+     */
+    template<typename Str>
+    void Insert(Str&& str, std::size_t i) {
+        auto [data, size] = Strazzle::_Bytes(std::forward<Str>(str));
+
+        BasicGapString::InsertRaw(data, i, size);
+    }
+
+    /**
+     * @brief Append exactly size bytes of str to the end. Binary safe, str does not need to be null terminated
+     */
+    BasicGapString& AppendRaw(const char* str, std::size_t size) {
+        BasicGapString::InsertRaw(str, BasicGapString::Len(), size);
+
+        return *this;
+    }
+
+    /**
+     * @brief Append str to the end
+     * @param str A C string, string literal, char buffer, String or Reference
+     */
+    template<typename Str>
+    BasicGapString& Append(Str&& str) {
+        auto [data, size] = Strazzle::_Bytes(std::forward<Str>(str));
+
+        return BasicGapString::AppendRaw(data, size);
+    }
+
+    /**
+     * @brief Erase part of the string, the erased bytes become part of the gap
+     * @param i The starting position to erase.
+     * @param size The number of characters to erase (default is SIZE_MAX).
+     */
+    void Erase(std::size_t i, std::size_t size = SIZE_MAX) {
+        std::size_t len = BasicGapString::Len();
+
+        if(i >= len) throw std::out_of_range("Index is out of bounds!\n << Strazzle::BasicGapString::Erase()");
+
+        size = std::min(len - i, size);
+
+        if(BasicGapString::IsLocal(i)) {
+            _mode = Mode::GAP_BUFFER;
+
+            BasicGapString::MoveGap(i);
+
+            _gap_end = _gap_end + size;
+        } else {
+            _mode = Mode::CONTIGUOUS;
+
+            BasicGapString::MoveGap(len);
+
+            std::memmove(_data + i, _data + i + size, len - i - size);
+
+            _gap_start = len - size;
+        }
+
+        _last = i;
+    }
+
+    /**
+     * @brief Get a pointer to the C-style string, closes the gap first
+     */
+    const char* Cstr() {
+        return BasicGapString::Data();
+    }
+
+    /**
+     * @brief Get a pointer to the bytes of the string, same as Cstr. Moves the tail of the string if the gap is open
+     */
+    const char* Data() {
+        if(_data == nullptr) return "";
+
+        BasicGapString::MoveGap(BasicGapString::Len());
+
+        _data[_gap_start] = '\0';
+
+        return _data;
+    }
+
+    /**
+     * @brief Copies the bytes on both sides of the gap into a contiguous string, the gap stays where it is
+     * @return The string
+     */
+    STRAZZLE_ENTRY_POINT Strazzle::String ToString() const {
+        Strazzle::_CallerScope caller(__builtin_return_address(0));
+
+        Strazzle::String str;
+
+        if(_data == nullptr) return str;
+
+        str.Reserve(BasicGapString::Len());
+        str.AppendRaw(_data, _gap_start);
+        str.AppendRaw(_data + _gap_end, _capacity - _gap_end);
+
+        return str;
+    }
+
+    /**
+     * @brief Get the length of the string.
+     */
+    std::size_t Len() const {
+        return _capacity - (_gap_end - _gap_start);
+    }
+
+    /**
+     * @brief Checks if the edits are currently made in the gap
+     */
+    bool IsGapBuffer() const {
+        return _mode == Mode::GAP_BUFFER;
+    }
+
+#ifndef STRAZZLE_DEBUG_ALL_PUBLIC
+  private:
+#endif
+    /**
+     * @brief Checks if an edit at i is close enough to the previous edit to be made in the gap
+     *        Measured from the edit and not from the gap, Data moves the gap to the end without editing
+     */
+    bool IsLocal(std::size_t i) const {
+        return (i > _last ? i - _last : _last - i) <= Strazzle::GAP_LOCALITY;
+    }
+
+    /**
+     * @brief Moves the gap so it starts at i, only the bytes between the gap and i are moved
+     */
+    void MoveGap(std::size_t i) {
+        if(i < _gap_start) {
+            std::size_t size = _gap_start - i;
+
+            std::memmove(_data + _gap_end - size, _data + i, size);
+
+            _gap_start = i;
+            _gap_end   = _gap_end - size;
+        } else if(i > _gap_start) {
+            std::size_t size = i - _gap_start;
+
+            std::memmove(_data + _gap_start, _data + _gap_end, size);
+
+            _gap_start = i;
+            _gap_end   = _gap_end + size;
+        }
+    }
+
+    /**
+     * @brief Makes the gap large enough for size more bytes and the null terminator, the buffer grows to the next power of 2
+     */
+    void Grow(std::size_t size) {
+        if(_gap_end - _gap_start > size) return;
+
+        std::size_t len      = BasicGapString::Len();
+        std::size_t capacity = std::max(Strazzle::_ExpToNum(Strazzle::_GetExponent(len + size + 1)), Strazzle::GAP_MIN_SIZE);
+        std::size_t tail     = _capacity - _gap_end;
+
+        char* data = _allocator.Allocate(capacity);
+
+        if(data == nullptr) throw std::bad_alloc();
+
+        if(_data != nullptr) {
+            std::memcpy(data, _data, _gap_start);
+            std::memcpy(data + capacity - tail, _data + _gap_end, tail);
+
+            _allocator.Deallocate(_data, _capacity);
+        }
+
+        _data     = data;
+        _gap_end  = capacity - tail;
+        _capacity = capacity;
+    }
+
+    /**
+     * @brief Appends the bytes on both sides of the gap of str, unlike str.Data() this leaves str untouched
+     */
+    void AppendGapString(const BasicGapString& str) {
+        if(str._data == nullptr) return;
+
+        BasicGapString::Grow(str.Len());
+
+        BasicGapString::AppendRaw(str._data, str._gap_start);
+        BasicGapString::AppendRaw(str._data + str._gap_end, str._capacity - str._gap_end);
+    }
+
+    /**
+     * @brief Checks if str points into the buffer
+     */
+    bool Owns(const char* str) const {
+        return _data != nullptr && !std::less<const char*>()(str, _data) && std::less<const char*>()(str, _data + _capacity);
+    }
+
+    /**
+     * @brief Takes over the buffer of str and leaves it empty, the current buffer has to be freed already
+     */
+    void Steal(BasicGapString& str) {
+        _data      = std::exchange(str._data, nullptr);
+        _capacity  = std::exchange(str._capacity, 0);
+        _gap_start = std::exchange(str._gap_start, 0);
+        _gap_end   = std::exchange(str._gap_end, 0);
+        _last      = std::exchange(str._last, 0);
+        _mode      = std::exchange(str._mode, Mode::CONTIGUOUS);
+    }
+
+    /**
+     * @brief Frees the buffer
+     */
+    void Free() {
+        if(_data != nullptr) _allocator.Deallocate(_data, _capacity);
+
+        _data      = nullptr;
+        _capacity  = 0;
+        _gap_start = 0;
+        _gap_end   = 0;
+    }
+};
+
+using GapString = Strazzle::BasicGapString<>;
+} // namespace Strazzle
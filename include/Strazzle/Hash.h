@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cinttypes>
+#include <cstring>
+
+namespace Strazzle {
+// Mixing constants of the hash (wyhash), odd and with balanced bits
+const uint64_t HASH_SECRET[4] = {0x2d358dccaa6c78a5ULL, 0x8bb84b93962eacc9ULL, 0x4b33a62ed433d4a3ULL, 0x4d5a2da51de1aa47ULL};
+
+/**
+ * @brief Multiplies a and b to 128 bits, a gets the low and b the high half
+ */
+inline void _HashMultiply(uint64_t& a, uint64_t& b) {
+    __uint128_t product = static_cast<__uint128_t>(a) * b;
+
+    a = static_cast<uint64_t>(product);
+    b = static_cast<uint64_t>(product >> 64);
+}
+
+/**
+ * @brief Folds the 128 bit product of a and b to 64 bits
+ */
+inline uint64_t _HashMix(uint64_t a, uint64_t b) {
+    Strazzle::_HashMultiply(a, b);
+
+    return a ^ b;
+}
+
+inline uint64_t _HashRead8(const char* p) {
+    uint64_t v;
+
+    std::memcpy(&v, p, 8);
+
+    return v;
+}
+
+inline uint64_t _HashRead4(const char* p) {
+    uint32_t v;
+
+    std::memcpy(&v, p, 4);
+
+    return v;
+}
+
+/**
+ * @brief Reads 1 to 3 bytes as the first, middle and last byte
+ */
+inline uint64_t _HashRead3(const char* p, std::size_t size) {
+    return (static_cast<uint64_t>(static_cast<uint8_t>(p[0])) << 16) | (static_cast<uint64_t>(static_cast<uint8_t>(p[size >> 1])) << 8) |
+           static_cast<uint8_t>(p[size - 1]);
+}
+
+/**
+ * @brief Non cryptographic 64 bit hash of size bytes (wyhash)
+ *        Inputs of up to 16 bytes are read with at most four overlapping loads and no loop
+ *        Large inputs are consumed 48 bytes per step in three independent lanes so the multiplies overlap
+ * @param str The bytes, binary safe
+ * @param size The number of bytes
+ * @param seed The seed
+ * @return The hash
+ */
+inline uint64_t _Hash(const char* str, std::size_t size, uint64_t seed = 0) {
+    const uint64_t* secret = Strazzle::HASH_SECRET;
+
+    seed = seed ^ Strazzle::_HashMix(seed ^ secret[0], secret[1]);
+
+    uint64_t a;
+    uint64_t b;
+
+    if(size <= 16) [[likely]] {
+        if(size >= 4) {
+            // 4..16 bytes, the loads of the two halves overlap
+            std::size_t step = (size >> 3) << 2;
+
+            a = (Strazzle::_HashRead4(str) << 32) | Strazzle::_HashRead4(str + step);
+            b = (Strazzle::_HashRead4(str + size - 4) << 32) | Strazzle::_HashRead4(str + size - 4 - step);
+        } else if(size > 0) {
+            a = Strazzle::_HashRead3(str, size);
+            b = 0;
+        } else {
+            a = 0;
+            b = 0;
+        }
+    } else {
+        const char* p    = str;
+        std::size_t left = size;
+
+        if(left > 48) {
+            uint64_t lane_1 = seed;
+            uint64_t lane_2 = seed;
+
+            do {
+                seed   = Strazzle::_HashMix(Strazzle::_HashRead8(p) ^ secret[1], Strazzle::_HashRead8(p + 8) ^ seed);
+                lane_1 = Strazzle::_HashMix(Strazzle::_HashRead8(p + 16) ^ secret[2], Strazzle::_HashRead8(p + 24) ^ lane_1);
+                lane_2 = Strazzle::_HashMix(Strazzle::_HashRead8(p + 32) ^ secret[3], Strazzle::_HashRead8(p + 40) ^ lane_2);
+
+                p    = p + 48;
+                left = left - 48;
+            } while(left > 48);
+
+            seed = seed ^ lane_1 ^ lane_2;
+        }
+
+        while(left > 16) {
+            seed = Strazzle::_HashMix(Strazzle::_HashRead8(p) ^ secret[1], Strazzle::_HashRead8(p + 8) ^ seed);
+
+            p    = p + 16;
+            left = left - 16;
+        }
+
+        // The last 16 bytes, may overlap bytes that were already consumed
+        a = Strazzle::_HashRead8(p + left - 16);
+        b = Strazzle::_HashRead8(p + left - 8);
+    }
+
+    a = a ^ secret[1];
+    b = b ^ seed;
+
+    Strazzle::_HashMultiply(a, b);
+
+    return Strazzle::_HashMix(a ^ secret[0] ^ size, b ^ secret[1]);
+}
+
+} // namespace Strazzle
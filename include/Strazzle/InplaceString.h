@@ -0,0 +1,480 @@
+#pragma once
+
+#include "Strazzle/Hash.h"
+#include "Strazzle/Search.h"
+#include "Strazzle/String.h"
+
+#include <cinttypes>
+#include <compare>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace Strazzle {
+/**
+ * @brief What a Strazzle::InplaceString does when an operation would exceed its capacity
+ *        TRUNCATE keeps the bytes that fit, THROW throws std::length_error and leaves the string unchanged, ERROR_CODE leaves the string
+ *        unchanged. TRUNCATE and ERROR_CODE set the overflow flag, see Strazzle::InplaceString::Overflowed()
+ */
+enum class InplaceOverflow : uint8_t { TRUNCATE = 0, THROW = 1, ERROR_CODE = 2 };
+
+/**
+ * @brief String with a fixed capacity of N bytes that lives entirely in the object and never allocates
+ *        Trivially copyable and free of pointers, so it can be copied into shared memory or through lock-free queues with memcpy
+ *        Has the Append, Insert, Erase, Resize and Substr API of Strazzle::BasicString and is a Strazzle::ByteRange, so strings and
+ *        References compare, search and append with it without a conversion
+ * @tparam N The capacity in bytes, without the null terminator
+ * @tparam Policy What to do on overflow
+ */
+template<std::size_t N, Strazzle::InplaceOverflow Policy = Strazzle::InplaceOverflow::THROW>
+class InplaceString {
+#ifdef STRAZZLE_DEBUG_ALL_PUBLIC
+  public:
+#endif
+    // Smallest type that holds N
+    using LenType = std::conditional_t<N <= UINT8_MAX, uint8_t, std::conditional_t<N <= UINT16_MAX, uint16_t, std::size_t>>;
+
+    // The bytes and the null terminator, zeroed so copies never read uninitialized bytes
+    char _buffer[N + 1] = {};
+
+    // Length of the string
+    LenType _len = 0;
+
+    // Set when an operation exceeded the capacity, until it is cleared
+    bool _overflowed = false;
+
+#ifndef STRAZZLE_DEBUG_ALL_PUBLIC
+  public:
+#endif
+    InplaceString() = default;
+
+    InplaceString(const char* str, std::size_t size = SIZE_MAX) {
+        InplaceString::Append(str, size);
+    }
+
+    /**
+     * @brief Copies the bytes of a String, a Reference or an InplaceString of another capacity
+     */
+    template<Strazzle::ByteRange Range>
+    explicit InplaceString(const Range& range, std::size_t size = SIZE_MAX) {
+        InplaceString::Append(range, size);
+    }
+
+    /**
+     * @brief Get the capacity
+     */
+    static constexpr std::size_t Capacity() {
+        return N;
+    }
+
+    /**
+     * @brief Checks if an operation exceeded the capacity since the last ClearOverflow, never set with the THROW policy
+     */
+    bool Overflowed() const {
+        return _overflowed;
+    }
+
+    void ClearOverflow() {
+        _overflowed = false;
+    }
+
+    /**
+     * @brief Append exactly size bytes of str to the end of the current string. Binary safe, str does not need to be null terminated
+     * @param str The bytes to append.
+     * @param size The number of bytes to append.
+     */
+    InplaceString& AppendRaw(const char* str, std::size_t size) {
+        if(size > N - _len) {
+            if(!InplaceString::Overflow("Capacity exceeded! << Strazzle::InplaceString::AppendRaw()\n")) return *this;
+
+            size = N - _len;
+        }
+
+        // str may point into this string, the bytes behind the end are never part of it
+        std::memcpy(_buffer + _len, str, size);
+
+        InplaceString::SetLen(_len + size);
+
+        return *this;
+    }
+
+    /**
+     * @brief Append a string to the end of the current string.
+     * @param str The string to append.
+     * @param size Maximum size to append (default is SIZE_MAX).
+     */
+    template<Strazzle::CStringPointer T>
+    InplaceString& Append(T str, std::size_t size = SIZE_MAX) {
+        size = std::min(strlen(str), size);
+
+        return InplaceString::AppendRaw(str, size);
+    }
+
+    /**
+     * @brief String literal version of Append, the length is known from the array type so no strlen is needed
+     */
+    template<std::size_t M>
+    InplaceString& Append(const char (&str)[M], std::size_t size = SIZE_MAX) {
+        size = std::min(M - 1, size);
+
+        return InplaceString::AppendRaw(str, size);
+    }
+
+    /**
+     * @brief Char buffer version of Append, a buffer is not necessarily filled so its length is not taken from the array type
+     */
+    template<std::size_t M>
+    InplaceString& Append(char (&str)[M], std::size_t size = SIZE_MAX) {
+        size = std::min(strnlen(str, M), size);
+
+        return InplaceString::AppendRaw(str, size);
+    }
+
+    /**
+     * @brief String, Reference and InplaceString version of Append
+     */
+    template<Strazzle::ByteRange Range>
+    InplaceString& Append(const Range& range, std::size_t size = SIZE_MAX) {
+        size = std::min(range.Len(), size);
+
+        return InplaceString::AppendRaw(range.Data(), size);
+    }
+
+    /**
+     * @brief Insert exactly size bytes of str at a specified position. Binary safe, str does not need to be null terminated
+     *        With the TRUNCATE policy the result is cut to the capacity
+     * @param str The bytes to insert.
+     * @param i The position to insert at.
+     * @param size The number of bytes to insert.
+     */
+    void InsertRaw(const char* str, std::size_t i, std::size_t size) {
+        if(i > _len) throw std::out_of_range("Index is out of bounds!\n << Strazzle::InplaceString::InsertRaw()");
+
+        if(size > N - _len) {
+            if(!InplaceString::Overflow("Capacity exceeded! << Strazzle::InplaceString::InsertRaw()\n")) return;
+        }
+
+        std::size_t len      = std::min(_len + size, N);
+        std::size_t inserted = std::min(size, N - i);
+
+        // str may point into this string, the part behind i gets moved so insert a copy
+        char copy[N];
+
+        if(InplaceString::Owns(str)) {
+            std::memcpy(copy, str, inserted);
+
+            str = copy;
+        }
+
+        std::memmove(_buffer + i + inserted, _buffer + i, len - i - inserted);
+
+        std::memcpy(_buffer + i, str, inserted);
+
+        InplaceString::SetLen(len);
+    }
+
+    /**
+     * @brief Insert a string at a specified position in the current string.
+     * @param str The string to insert.
+     * @param i The position to insert at.
+     * @param size Maximum size to insert (default is SIZE_MAX).
+     */
+    template<Strazzle::CStringPointer T>
+    void Insert(T str, std::size_t i, std::size_t size = SIZE_MAX) {
+        size = std::min(strlen(str), size);
+
+        InplaceString::InsertRaw(str, i, size);
+    }
+
+    /**
+     * @brief String literal version of Insert, the length is known from the array type so no strlen is needed
+     */
+    template<std::size_t M>
+    void Insert(const char (&str)[M], std::size_t i, std::size_t size = SIZE_MAX) {
+        size = std::min(M - 1, size);
+
+        InplaceString::InsertRaw(str, i, size);
+    }
+
+    /**
+     * @brief Char buffer version of Insert, a buffer is not necessarily filled so its length is not taken from the array type
+     */
+    template<std::size_t M>
+    void Insert(char (&str)[M], std::size_t i, std::size_t size = SIZE_MAX) {
+        size = std::min(strnlen(str, M), size);
+
+        InplaceString::InsertRaw(str, i, size);
+    }
+
+    /**
+     * @brief String, Reference and InplaceString version of Insert
+     */
+    template<Strazzle::ByteRange Range>
+    void Insert(const Range& range, std::size_t i, std::size_t size = SIZE_MAX) {
+        size = std::min(range.Len(), size);
+
+        InplaceString::InsertRaw(range.Data(), i, size);
+    }
+
+    /**
+     * @brief Erase a portion of the string starting from a specified position.
+     * @param i The starting position for erasing.
+     * @param size Maximum size to erase (default is SIZE_MAX).
+     */
+    void Erase(std::size_t i, std::size_t size = SIZE_MAX) {
+        if(i >= _len) throw std::out_of_range("Index is out of bounds!\n << Strazzle::InplaceString::Erase()");
+
+        size = std::min(_len - i, size);
+
+        std::memmove(_buffer + i, _buffer + i + size, _len - i - size);
+
+        InplaceString::SetLen(_len - size);
+    }
+
+    /**
+     * @brief Resize the string to a specified size, filling with a character.
+     * @param size The new size of the string.
+     * @param fill The character to fill with (default is a space).
+     */
+    void Resize(std::size_t size, char fill = ' ') {
+        if(size > N) {
+            if(!InplaceString::Overflow("Capacity exceeded! << Strazzle::InplaceString::Resize()\n")) return;
+
+            size = N;
+        }
+
+        if(size > _len) {
+            std::memset(_buffer + _len, fill, size - _len);
+        }
+
+        InplaceString::SetLen(size);
+    }
+
+    /**
+     * @brief Resize the string to a specified size, filling with a given string.
+     * @param size The new size of the string.
+     * @param fill The string to fill with, growing with an empty fill throws std::invalid_argument and leaves the string unchanged.
+     */
+    void Resize(std::size_t size, const char* fill) {
+        std::size_t str_len = strlen(fill);
+
+        if(str_len == 0 && size > _len) throw std::invalid_argument("Fill is empty! << Strazzle::InplaceString::Resize()\n");
+
+        if(size > N) {
+            if(!InplaceString::Overflow("Capacity exceeded! << Strazzle::InplaceString::Resize()\n")) return;
+
+            size = N;
+        }
+
+        std::size_t len = _len;
+
+        if(size > len) {
+            while(len < size) {
+                std::memcpy(_buffer + len, fill, len + str_len <= size ? str_len : size - len);
+                len = std::min(len + str_len, size);
+            }
+        } else {
+            len = size;
+        }
+
+        InplaceString::SetLen(len);
+    }
+
+    /**
+     * @brief Get a pointer to the C-style string.
+     */
+    const char* Cstr() const {
+        return _buffer;
+    }
+
+    /**
+     * @brief Get a pointer to the bytes of the string, same as Cstr
+     */
+    const char* Data() const {
+        return _buffer;
+    }
+
+    /**
+     * @brief Get the length of the string.
+     */
+    std::size_t Len() const {
+        return _len;
+    }
+
+    /**
+     * @brief Returns a substr
+     * @param i The starting index
+     * @param size The lenght of the substr
+     */
+    InplaceString Substr(std::size_t i, std::size_t size = SIZE_MAX) const {
+        if(i >= _len) throw std::out_of_range("Index is out of bounds! << Strazzle::InplaceString::Substr()\n");
+
+        size = std::min(_len - i, size);
+
+        return InplaceString().AppendRaw(_buffer + i, size);
+    }
+
+    /**
+     * @brief Copies the string into a Strazzle::BasicString, binary safe
+     */
+    template<Strazzle::StringAllocator Allocator = Strazzle::MallocAllocator, std::size_t SSOSize = Strazzle::SSO_SIZE>
+    Strazzle::BasicString<Allocator, SSOSize> ToString(const Allocator& allocator = Allocator()) const {
+        return Strazzle::BasicString<Allocator, SSOSize>(allocator).AppendRaw(_buffer, _len);
+    }
+
+    /**
+     * @brief Finds the first c at or after pos
+     * @return The index or Strazzle::NPOS
+     */
+    std::size_t Find(char c, std::size_t pos = 0) const {
+        return Strazzle::_FindChar(_buffer, _len, c, pos);
+    }
+
+    /**
+     * @brief Finds the first occurrence of needle that starts at or after pos
+     * @param needle A C string, string literal, char buffer, String, Reference or InplaceString
+     * @return The index or Strazzle::NPOS, an empty needle is found at pos
+     */
+    template<typename Needle>
+    std::size_t Find(Needle&& needle, std::size_t pos = 0) const {
+        auto [str, size] = Strazzle::_Bytes(std::forward<Needle>(needle));
+
+        return Strazzle::_Find(_buffer, _len, str, size, pos);
+    }
+
+    /**
+     * @brief Finds the last c at or before pos
+     * @return The index or Strazzle::NPOS
+     */
+    std::size_t RFind(char c, std::size_t pos = Strazzle::NPOS) const {
+        return Strazzle::_RFindChar(_buffer, _len, c, pos);
+    }
+
+    /**
+     * @brief Finds the last occurrence of needle that starts at or before pos
+     * @return The index or Strazzle::NPOS
+     */
+    template<typename Needle>
+    std::size_t RFind(Needle&& needle, std::size_t pos = Strazzle::NPOS) const {
+        auto [str, size] = Strazzle::_Bytes(std::forward<Needle>(needle));
+
+        return Strazzle::_RFind(_buffer, _len, str, size, pos);
+    }
+
+    /**
+     * @brief Checks if the string contains c or needle
+     */
+    template<typename Needle>
+    bool Contains(Needle&& needle) const {
+        return InplaceString::Find(std::forward<Needle>(needle)) != Strazzle::NPOS;
+    }
+
+    /**
+     * @brief Counts the occurrences of c
+     */
+    std::size_t Count(char c) const {
+        return Strazzle::_CountChar(_buffer, _len, c);
+    }
+
+    /**
+     * @brief Counts the non overlapping occurrences of needle, an empty needle is counted 0 times
+     */
+    template<typename Needle>
+    std::size_t Count(Needle&& needle) const {
+        auto [str, size] = Strazzle::_Bytes(std::forward<Needle>(needle));
+
+        return Strazzle::_Count(_buffer, _len, str, size);
+    }
+
+    /**
+     * @brief Hashes the bytes of the string, equal to the hash of a String with the same bytes
+     */
+    std::size_t Hash() const {
+        return Strazzle::_Hash(_buffer, _len);
+    }
+
+    /**
+     * @brief Three way comparison of the bytes of the string with other, binary safe
+     * @param other A C string, string literal, char buffer, String, Reference or InplaceString
+     * @return Less than, equal to or greater than 0 like memcmp
+     */
+    template<typename Other>
+    int Compare(Other&& other) const {
+        auto [str, size] = Strazzle::_Bytes(std::forward<Other>(other));
+
+        return Strazzle::_Compare(_buffer, _len, str, size);
+    }
+
+    /**
+     * @brief Equality, strings of different length are rejected without looking at their bytes
+     *        Byte ranges are taken by const reference so the reversed candidates of C++20 don't make a == b ambiguous
+     */
+    template<Strazzle::ByteRange Other>
+    bool operator==(const Other& other) const {
+        return _len == other.Len() && Strazzle::_Equal(_buffer, other.Data(), _len);
+    }
+
+    template<typename Other>
+        requires(!Strazzle::ByteRange<std::remove_cvref_t<Other>>)
+    bool operator==(Other&& other) const {
+        auto [str, size] = Strazzle::_Bytes(std::forward<Other>(other));
+
+        return _len == size && Strazzle::_Equal(_buffer, str, size);
+    }
+
+    template<Strazzle::ByteRange Other>
+    std::strong_ordering operator<=>(const Other& other) const {
+        return InplaceString::Compare(other) <=> 0;
+    }
+
+    template<typename Other>
+        requires(!Strazzle::ByteRange<std::remove_cvref_t<Other>>)
+    std::strong_ordering operator<=>(Other&& other) const {
+        return InplaceString::Compare(std::forward<Other>(other)) <=> 0;
+    }
+
+#ifndef STRAZZLE_DEBUG_ALL_PUBLIC
+  private:
+#endif
+    /**
+     * @brief Applies the overflow policy
+     * @param msg The message of the exception of the THROW policy
+     * @return If the operation continues with the bytes that fit
+     */
+    bool Overflow(const char* msg) {
+        if constexpr(Policy == Strazzle::InplaceOverflow::THROW) {
+            throw std::length_error(msg);
+        }
+
+        _overflowed = true;
+
+        return Policy == Strazzle::InplaceOverflow::TRUNCATE;
+    }
+
+    /**
+     * @brief Sets the length and the null terminator
+     */
+    void SetLen(std::size_t len) {
+        _len = static_cast<LenType>(len);
+
+        _buffer[len] = '\0';
+    }
+
+    /**
+     * @brief Checks if str points into the buffer of this string
+     */
+    bool Owns(const char* str) const {
+        return !std::less<const char*>()(str, _buffer) && std::less<const char*>()(str, _buffer + N + 1);
+    }
+};
+
+} // namespace Strazzle
+
+template<std::size_t N, Strazzle::InplaceOverflow Policy>
+struct std::hash<Strazzle::InplaceString<N, Policy>> {
+    std::size_t operator()(const Strazzle::InplaceString<N, Policy>& str) const {
+        return str.Hash();
+    }
+};
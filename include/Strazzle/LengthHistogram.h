@@ -0,0 +1,343 @@
+#pragma once
+
+#include "Strazzle/Profiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cinttypes>
+#include <cstddef>
+#include <cstdio>
+#include <vector>
+
+#ifdef STRAZZLE_LENGTH_HISTOGRAM
+    #include <mutex>
+    #include <unordered_map>
+#endif
+
+namespace Strazzle {
+// Lengths below this have a bucket each, longer lengths share a bucket per power of 2
+const std::size_t HISTOGRAM_FINE = 64;
+
+// The fine buckets and one bucket per exponent from 6 to 63
+const std::size_t HISTOGRAM_BUCKETS = Strazzle::HISTOGRAM_FINE + 58;
+
+// A string whose heap buffer grew this many times is reported with the site of its growth
+const uint8_t GROWTH_THRESHOLD = 3;
+
+/**
+ * @brief Get the bucket of a length
+ */
+inline std::size_t _LengthBucket(std::size_t len) {
+    if(len < Strazzle::HISTOGRAM_FINE) return len;
+
+    return Strazzle::HISTOGRAM_FINE + (63 - __builtin_clzl(len)) - 6;
+}
+
+/**
+ * @brief Snapshot of the lengths strings had when they were destroyed, see Strazzle::GetLengthHistogram
+ *        Empty strings, which includes every moved-from string, are not counted
+ */
+struct LengthHistogram {
+    // Strings per bucket, see Strazzle::_LengthBucket
+    std::size_t counts[Strazzle::HISTOGRAM_BUCKETS] = {};
+
+    /**
+     * @brief Get the shortest length of a bucket
+     */
+    static std::size_t BucketMin(std::size_t k) {
+        return k < Strazzle::HISTOGRAM_FINE ? k : 1UL << (k - Strazzle::HISTOGRAM_FINE + 6);
+    }
+
+    /**
+     * @brief Get the longest length of a bucket
+     */
+    static std::size_t BucketMax(std::size_t k) {
+        return k < Strazzle::HISTOGRAM_FINE ? k : (LengthHistogram::BucketMin(k) << 1) - 1;
+    }
+
+    /**
+     * @brief Get the number of strings counted
+     */
+    std::size_t Total() const {
+        std::size_t total = 0;
+
+        for(std::size_t count : counts) {
+            total = total + count;
+        }
+
+        return total;
+    }
+
+    /**
+     * @brief Get the share of strings that would have been SMALL_STRINGs with an SSO buffer of sso_size bytes
+     *        A power of 2 bucket only counts if all of it fits, so the result is a lower bound above 64 bytes
+     */
+    double Coverage(std::size_t sso_size) const {
+        std::size_t total = LengthHistogram::Total();
+        std::size_t fit   = 0;
+
+        if(total == 0) return 1.0;
+
+        for(std::size_t k = 0; k < Strazzle::HISTOGRAM_BUCKETS && LengthHistogram::BucketMax(k) < sso_size; k++) {
+            fit = fit + counts[k];
+        }
+
+        return static_cast<double>(fit) / total;
+    }
+
+    /**
+     * @brief Get the smallest SSO size, a multiple of 8 from 24 to 128, that keeps at least coverage of the strings off the heap
+     *        Sizes are multiples of 8 because the object is padded to them anyway
+     * @return The SSO size for Strazzle::SSOString, 0 if even 128 bytes aren't enough and the strings are too long for SSO to help
+     */
+    std::size_t RecommendSsoSize(double coverage = 0.9) const {
+        for(std::size_t sso_size = 24; sso_size <= 128; sso_size = sso_size + 8) {
+            if(LengthHistogram::Coverage(sso_size) >= coverage) return sso_size;
+        }
+
+        return 0;
+    }
+};
+
+/**
+ * @brief A site where strings grew through several exponents, eg an Append loop that would be better off with a Reserve
+ */
+struct GrowthSite {
+    // Tag of the site, see Strazzle::ProfileScope, nullptr if the site is a return address
+    const char* tag;
+
+    // Return address of the outermost string call that grew the strings, see Strazzle::_CallerScope. nullptr if the site is a tag
+    const void* address;
+
+    // Strings that reached Strazzle::GROWTH_THRESHOLD growths at the site
+    std::size_t strings;
+
+    // Growths of those strings from the threshold on
+    std::size_t growths;
+
+    // Largest buffer they grew to, a hint for the size to reserve
+    std::size_t max_bytes;
+};
+
+#ifdef STRAZZLE_LENGTH_HISTOGRAM
+/**
+ * @brief Histogram of one thread, only written by its thread so counting is a plain load and store
+ *        The buckets are atomic so a snapshot may read them from another thread
+ */
+struct _ThreadHistogram {
+    std::atomic<std::size_t> counts[Strazzle::HISTOGRAM_BUCKETS] = {};
+
+    _ThreadHistogram();
+
+    ~_ThreadHistogram();
+};
+
+/**
+ * @brief The histograms of all running threads, the sums of the threads that exited and the growth sites
+ */
+struct _HistogramRegistry {
+    std::mutex mutex;
+
+    std::vector<Strazzle::_ThreadHistogram*> threads;
+
+    std::size_t exited[Strazzle::HISTOGRAM_BUCKETS] = {};
+
+    // Growth sites, the key is the tag or the return address
+    std::unordered_map<const void*, Strazzle::GrowthSite> sites;
+};
+
+/**
+ * @brief Get the registry, it is never destroyed so threads may still exit while static objects are destroyed
+ */
+inline Strazzle::_HistogramRegistry& _GetHistogramRegistry() {
+    static Strazzle::_HistogramRegistry* registry = new Strazzle::_HistogramRegistry();
+
+    return *registry;
+}
+
+inline _ThreadHistogram::_ThreadHistogram() {
+    Strazzle::_HistogramRegistry& registry = Strazzle::_GetHistogramRegistry();
+
+    std::lock_guard lock(registry.mutex);
+
+    registry.threads.push_back(this);
+}
+
+inline _ThreadHistogram::~_ThreadHistogram() {
+    Strazzle::_HistogramRegistry& registry = Strazzle::_GetHistogramRegistry();
+
+    std::lock_guard lock(registry.mutex);
+
+    for(std::size_t k = 0; k < Strazzle::HISTOGRAM_BUCKETS; k++) {
+        registry.exited[k] = registry.exited[k] + counts[k].load(std::memory_order_relaxed);
+    }
+
+    registry.threads.erase(std::find(registry.threads.begin(), registry.threads.end(), this));
+}
+
+/**
+ * @brief Get the histogram of the current thread
+ */
+inline Strazzle::_ThreadHistogram& _GetThreadHistogram() {
+    static thread_local Strazzle::_ThreadHistogram histogram;
+
+    return histogram;
+}
+
+/**
+ * @brief Slow path of Strazzle::_CountGrowth, adds a growth to the site of the current thread
+ */
+__attribute__((noinline, cold)) inline void _RecordGrowth(uint8_t grows, std::size_t bytes) {
+    Strazzle::_HistogramRegistry& registry = Strazzle::_GetHistogramRegistry();
+
+    const char* tag     = Strazzle::_ProfileTag();
+    const void* address = tag == nullptr ? Strazzle::_ProfileCaller() : nullptr;
+
+    std::lock_guard lock(registry.mutex);
+
+    auto [it, inserted] = registry.sites.try_emplace(tag != nullptr ? static_cast<const void*>(tag) : address);
+
+    if(inserted) it->second = {tag, address, 0, 0, 0};
+
+    Strazzle::GrowthSite& site = it->second;
+
+    if(grows == Strazzle::GROWTH_THRESHOLD) site.strings = site.strings + 1;
+
+    site.growths   = site.growths + 1;
+    site.max_bytes = std::max(site.max_bytes, bytes);
+}
+#endif
+
+/**
+ * @brief Counts the length of a string that is destroyed, does nothing if STRAZZLE_LENGTH_HISTOGRAM is not defined
+ */
+inline void _CountLength([[maybe_unused]] std::size_t len) {
+#ifdef STRAZZLE_LENGTH_HISTOGRAM
+    if(len == 0) return;
+
+    std::atomic<std::size_t>& count = Strazzle::_GetThreadHistogram().counts[Strazzle::_LengthBucket(len)];
+
+    count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+#endif
+}
+
+/**
+ * @brief Reports a growth of a heap buffer once the string grew Strazzle::GROWTH_THRESHOLD times
+ *        The site is the tag of the innermost Strazzle::ProfileScope, or the caller of the outermost Strazzle::_CallerScope
+ * @param grows How often the buffer grew, including this time
+ * @param bytes Size of the grown buffer
+ */
+inline void _CountGrowth([[maybe_unused]] uint8_t grows, [[maybe_unused]] std::size_t bytes) {
+#ifdef STRAZZLE_LENGTH_HISTOGRAM
+    if(grows >= Strazzle::GROWTH_THRESHOLD) [[unlikely]] {
+        Strazzle::_RecordGrowth(grows, bytes);
+    }
+#endif
+}
+
+/**
+ * @brief Sums up the histograms of all threads, including the ones that exited. Empty if STRAZZLE_LENGTH_HISTOGRAM is not defined
+ */
+inline Strazzle::LengthHistogram GetLengthHistogram() {
+    Strazzle::LengthHistogram histogram;
+
+#ifdef STRAZZLE_LENGTH_HISTOGRAM
+    Strazzle::_HistogramRegistry& registry = Strazzle::_GetHistogramRegistry();
+
+    std::lock_guard lock(registry.mutex);
+
+    for(std::size_t k = 0; k < Strazzle::HISTOGRAM_BUCKETS; k++) {
+        histogram.counts[k] = registry.exited[k];
+
+        for(Strazzle::_ThreadHistogram* thread : registry.threads) {
+            histogram.counts[k] = histogram.counts[k] + thread->counts[k].load(std::memory_order_relaxed);
+        }
+    }
+#endif
+
+    return histogram;
+}
+
+/**
+ * @brief Get the sites where strings grew through several exponents, the ones with the most strings first
+ */
+inline std::vector<Strazzle::GrowthSite> GetGrowthSites() {
+    std::vector<Strazzle::GrowthSite> sites;
+
+#ifdef STRAZZLE_LENGTH_HISTOGRAM
+    Strazzle::_HistogramRegistry& registry = Strazzle::_GetHistogramRegistry();
+
+    {
+        std::lock_guard lock(registry.mutex);
+
+        for(const auto& [key, site] : registry.sites) {
+            sites.push_back(site);
+        }
+    }
+
+    std::sort(sites.begin(), sites.end(), [](const GrowthSite& a, const GrowthSite& b) { return a.strings > b.strings; });
+#endif
+
+    return sites;
+}
+
+/**
+ * @brief Writes the non-empty buckets, the recommended SSO size and the growth sites, addresses can be resolved with addr2line
+ * @param file A file opened for writing, eg stderr
+ */
+inline void DumpLengthReport(FILE* file) {
+    Strazzle::LengthHistogram histogram = Strazzle::GetLengthHistogram();
+
+    std::size_t total = histogram.Total();
+    std::size_t sum   = 0;
+
+    fprintf(file, "%-16s %14s %10s\n", "length", "strings", "cumulative");
+
+    for(std::size_t k = 0; k < Strazzle::HISTOGRAM_BUCKETS; k++) {
+        if(histogram.counts[k] == 0) continue;
+
+        sum = sum + histogram.counts[k];
+
+        // Two 20 digit numbers, the dash and the terminator
+        char range[48];
+
+        if(k < Strazzle::HISTOGRAM_FINE) {
+            snprintf(range, sizeof(range), "%zu", k);
+        } else {
+            snprintf(range, sizeof(range), "%zu-%zu", LengthHistogram::BucketMin(k), LengthHistogram::BucketMax(k));
+        }
+
+        fprintf(file, "%-16s %14zu %9.1f%%\n", range, histogram.counts[k], 100.0 * sum / total);
+    }
+
+    std::size_t sso_size = histogram.RecommendSsoSize();
+
+    fprintf(file, "\nThe default SSO size of 24 keeps %.1f%% of %zu strings off the heap\n", 100.0 * histogram.Coverage(24), total);
+
+    if(sso_size != 0) {
+        fprintf(file, "Strazzle::SSOString<%zu> is the smallest that keeps 90%% off the heap, %.1f%%\n", sso_size,
+                100.0 * histogram.Coverage(sso_size));
+    } else {
+        fprintf(file, "No SSO size up to 128 keeps 90%% off the heap, the strings are too long for SSO to help\n");
+    }
+
+    std::vector<Strazzle::GrowthSite> sites = Strazzle::GetGrowthSites();
+
+    if(sites.empty()) return;
+
+    fprintf(file, "\nStrings that grew %d or more times, consider a Reserve:\n", Strazzle::GROWTH_THRESHOLD);
+    fprintf(file, "%-32s %12s %12s %14s\n", "site", "strings", "growths", "max_bytes");
+
+    for(const Strazzle::GrowthSite& site : sites) {
+        char name[64];
+
+        if(site.tag != nullptr) {
+            snprintf(name, sizeof(name), "%s", site.tag);
+        } else {
+            snprintf(name, sizeof(name), "%p", site.address);
+        }
+
+        fprintf(file, "%-32s %12zu %12zu %14zu\n", name, site.strings, site.growths, site.max_bytes);
+    }
+}
+} // namespace Strazzle
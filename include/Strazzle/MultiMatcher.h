@@ -0,0 +1,356 @@
+#pragma once
+
+#include "Strazzle/Search.h"
+#include "Strazzle/String.h"
+
+#include <cinttypes>
+#include <initializer_list>
+#include <ranges>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace Strazzle {
+/**
+ * @brief Finds all occurrences of a fixed set of patterns in one pass over the haystack (Aho-Corasick)
+ *        The automaton is compiled into a dense transition table over byte classes, so every byte of the haystack costs one table
+ *        lookup. If the patterns start with only a few distinct chars the scan skips to the next of them with the SIMD kernels
+ *        The matcher is immutable once built and can be shared between threads
+ */
+class MultiMatcher {
+  public:
+    /**
+     * @brief An occurrence of a pattern in the haystack
+     */
+    struct Match {
+        // Index of the pattern in the list the matcher was built from
+        std::size_t pattern;
+        // Start of the occurrence in the haystack
+        std::size_t i;
+        // Length of the occurrence
+        std::size_t len;
+    };
+
+#ifndef STRAZZLE_DEBUG_ALL_PUBLIC
+  private:
+#endif
+    // Marks missing edges of the trie while building
+    static constexpr uint32_t NO_STATE = UINT32_MAX;
+
+    // Byte class of every byte, bytes that appear in no pattern share class 0
+    uint16_t _classes[256] = {};
+    // Number of byte classes, ie the width of a row of the transition table
+    std::size_t _class_count = 1;
+
+    // Transition table, row of a state times class. Entries are row offsets (state * _class_count) so the scan needs no multiply
+    std::vector<uint32_t> _delta;
+
+    // States in which a pattern ends (directly or through a suffix) are numbered last, this is the row offset of the first of them
+    uint32_t _matching_start = 0;
+    // Patterns ending in the state, _outputs[_output_offsets[s] .. _output_offsets[s + 1]]
+    std::vector<uint32_t> _output_offsets;
+    std::vector<uint32_t> _outputs;
+    // Next state on the suffix chain that has outputs, NO_STATE if there is none
+    std::vector<uint32_t> _dict_links;
+
+    // Length of every pattern
+    std::vector<std::size_t> _lengths;
+
+    // First chars of all patterns, only used as prefilter if there are at most Strazzle::FIND_ANY_MAX of them
+    char        _first_chars[Strazzle::FIND_ANY_MAX];
+    std::size_t _first_char_count = 0;
+    bool        _prefilter        = false;
+
+#ifndef STRAZZLE_DEBUG_ALL_PUBLIC
+  public:
+#endif
+    /**
+     * @brief Compiles the matcher, empty patterns never match
+     * @param patterns The (pointer, length) pairs of the patterns, binary safe
+     */
+    MultiMatcher(std::span<const std::pair<const char*, std::size_t>> patterns) {
+        Strazzle::MultiMatcher::Build(patterns);
+    }
+
+    /**
+     * @brief Compiles the matcher from C strings
+     */
+    MultiMatcher(std::initializer_list<const char*> patterns) {
+        std::vector<std::pair<const char*, std::size_t>> ranges;
+
+        for(const char* pattern : patterns) {
+            ranges.emplace_back(pattern, strlen(pattern));
+        }
+
+        Strazzle::MultiMatcher::Build(ranges);
+    }
+
+    /**
+     * @brief Compiles the matcher from a range of strings, References or InplaceStrings, eg a std::vector<Strazzle::String>
+     */
+    template<std::ranges::input_range Patterns>
+        requires Strazzle::ByteRange<std::ranges::range_value_t<Patterns>>
+    MultiMatcher(const Patterns& patterns) {
+        std::vector<std::pair<const char*, std::size_t>> ranges;
+
+        for(const auto& pattern : patterns) {
+            ranges.emplace_back(pattern.Data(), pattern.Len());
+        }
+
+        Strazzle::MultiMatcher::Build(ranges);
+    }
+
+    /**
+     * @brief Calls fn for every occurrence of every pattern, in order of the end of the occurrence. Overlapping occurrences are all reported
+     * @param str The haystack
+     * @param size The length of the haystack
+     * @param fn Called with a const Match&, returning false stops the scan
+     */
+    template<typename Fn>
+    void ForEachMatch(const char* str, std::size_t size, Fn&& fn) const {
+        if(_prefilter) {
+            Strazzle::MultiMatcher::Scan<true>(str, size, fn);
+        } else {
+            Strazzle::MultiMatcher::Scan<false>(str, size, fn);
+        }
+    }
+
+    /**
+     * @brief String and Reference version of ForEachMatch
+     */
+    template<Strazzle::ByteRange Range, typename Fn>
+    void ForEachMatch(const Range& range, Fn&& fn) const {
+        Strazzle::MultiMatcher::ForEachMatch(range.Data(), range.Len(), std::forward<Fn>(fn));
+    }
+
+    /**
+     * @brief Finds every occurrence of every pattern
+     * @param str The haystack, a String or a Reference
+     * @return The occurrences, in order of their end
+     */
+    template<typename Haystack>
+    std::vector<Match> FindAll(const Haystack& str) const {
+        std::vector<Match> matches;
+
+        Strazzle::MultiMatcher::ForEachMatch(str, [&](const Match& match) {
+            matches.push_back(match);
+
+            return true;
+        });
+
+        return matches;
+    }
+
+    /**
+     * @brief Checks if any pattern occurs in the haystack, stops at the first occurrence
+     * @param str The haystack, a String or a Reference
+     */
+    template<typename Haystack>
+    bool Contains(const Haystack& str) const {
+        bool found = false;
+
+        Strazzle::MultiMatcher::ForEachMatch(str, [&](const Match&) {
+            found = true;
+
+            return false;
+        });
+
+        return found;
+    }
+
+    /**
+     * @brief Get the number of patterns
+     */
+    std::size_t PatternCount() const {
+        return _lengths.size();
+    }
+
+#ifndef STRAZZLE_DEBUG_ALL_PUBLIC
+  private:
+#endif
+    /**
+     * @brief The scan loop of ForEachMatch, the prefilter is a template parameter so the loop without it has no branch on the state
+     */
+    template<bool Prefilter, typename Fn>
+    void Scan(const char* str, std::size_t size, Fn& fn) const {
+        // Locals so the compiler keeps them in registers, fn could otherwise alias the members
+        const uint32_t* delta          = _delta.data();
+        const uint16_t* classes        = _classes;
+        const uint32_t  matching_start = _matching_start;
+
+        uint32_t state = 0;
+
+        for(std::size_t i = 0; i < size; i++) {
+            if constexpr(Prefilter) {
+                if(state == 0) {
+                    i = Strazzle::_FindAny(str, size, _first_chars, _first_char_count, i);
+
+                    if(i == Strazzle::NPOS) return;
+                }
+            }
+
+            state = delta[state + classes[static_cast<uint8_t>(str[i])]];
+
+            if(state >= matching_start && !Strazzle::MultiMatcher::Report(state / _class_count, i, fn)) return;
+        }
+    }
+
+    /**
+     * @brief Reports the patterns ending at i in state and on its suffix chain
+     * @return False if fn stopped the scan
+     */
+    template<typename Fn>
+    bool Report(uint32_t state, std::size_t i, Fn& fn) const {
+        for(; state != NO_STATE; state = _dict_links[state]) {
+            for(uint32_t o = _output_offsets[state]; o < _output_offsets[state + 1]; o++) {
+                uint32_t    pattern = _outputs[o];
+                std::size_t len     = _lengths[pattern];
+
+                if(!fn(Match{pattern, i + 1 - len, len})) return false;
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Builds the trie, the suffix links and the transition table
+     */
+    void Build(std::span<const std::pair<const char*, std::size_t>> patterns) {
+        // Byte classes and first chars
+        bool first_seen[256] = {};
+
+        for(const auto& [str, len] : patterns) {
+            for(std::size_t i = 0; i < len; i++) {
+                uint8_t c = static_cast<uint8_t>(str[i]);
+
+                if(_classes[c] == 0) {
+                    _classes[c]  = static_cast<uint16_t>(_class_count);
+                    _class_count = _class_count + 1;
+                }
+            }
+
+            if(len != 0 && !first_seen[static_cast<uint8_t>(str[0])]) {
+                first_seen[static_cast<uint8_t>(str[0])] = true;
+
+                if(_first_char_count < Strazzle::FIND_ANY_MAX) {
+                    _first_chars[_first_char_count] = str[0];
+                }
+
+                _first_char_count = _first_char_count + 1;
+            }
+        }
+
+        _prefilter = _first_char_count != 0 && _first_char_count <= Strazzle::FIND_ANY_MAX;
+
+        // Trie, edges are NO_STATE until the table is completed
+        std::vector<uint32_t>              trie(_class_count, NO_STATE);
+        std::vector<std::vector<uint32_t>> outputs(1);
+
+        for(std::size_t p = 0; p < patterns.size(); p++) {
+            const auto& [str, len] = patterns[p];
+
+            _lengths.push_back(len);
+
+            if(len == 0) continue;
+
+            uint32_t state = 0;
+
+            for(std::size_t i = 0; i < len; i++) {
+                uint32_t& next = trie[state * _class_count + _classes[static_cast<uint8_t>(str[i])]];
+
+                if(next == NO_STATE) {
+                    next = static_cast<uint32_t>(outputs.size());
+
+                    outputs.emplace_back();
+                    trie.resize(trie.size() + _class_count, NO_STATE);
+                }
+
+                state = trie[state * _class_count + _classes[static_cast<uint8_t>(str[i])]];
+            }
+
+            outputs[state].push_back(static_cast<uint32_t>(p));
+        }
+
+        std::size_t state_count = outputs.size();
+
+        // Breadth first, the suffix links of shallower states are final before they are used
+        std::vector<uint32_t> fail(state_count, 0);
+        std::vector<uint32_t> queue;
+
+        _dict_links.assign(state_count, NO_STATE);
+
+        for(std::size_t c = 0; c < _class_count; c++) {
+            uint32_t& next = trie[c];
+
+            if(next == NO_STATE) {
+                next = 0;
+            } else {
+                queue.push_back(next);
+            }
+        }
+
+        for(std::size_t q = 0; q < queue.size(); q++) {
+            uint32_t state = queue[q];
+
+            for(std::size_t c = 0; c < _class_count; c++) {
+                uint32_t& next     = trie[state * _class_count + c];
+                uint32_t  fallback = trie[fail[state] * _class_count + c];
+
+                if(next == NO_STATE) {
+                    next = fallback;
+                    continue;
+                }
+
+                fail[next] = fallback;
+
+                _dict_links[next] = !outputs[fallback].empty() ? fallback : _dict_links[fallback];
+
+                queue.push_back(next);
+            }
+        }
+
+        // Renumber the states so the matching ones come last, the root has no outputs and stays 0
+        std::vector<uint32_t> ids(state_count);
+        std::vector<uint32_t> order;
+
+        for(int matching = 0; matching < 2; matching++) {
+            for(uint32_t state = 0; state < state_count; state++) {
+                if((!outputs[state].empty() || _dict_links[state] != NO_STATE) == (matching == 1)) {
+                    ids[state] = static_cast<uint32_t>(order.size());
+
+                    order.push_back(state);
+                }
+            }
+
+            if(matching == 0) _matching_start = static_cast<uint32_t>(order.size() * _class_count);
+        }
+
+        // Flatten
+        _delta.resize(trie.size());
+
+        _output_offsets.resize(state_count + 1);
+
+        std::vector<uint32_t> dict_links(state_count, NO_STATE);
+
+        for(uint32_t id = 0; id < state_count; id++) {
+            uint32_t state = order[id];
+
+            for(std::size_t c = 0; c < _class_count; c++) {
+                _delta[id * _class_count + c] = static_cast<uint32_t>(ids[trie[state * _class_count + c]] * _class_count);
+            }
+
+            _output_offsets[id] = static_cast<uint32_t>(_outputs.size());
+
+            _outputs.insert(_outputs.end(), outputs[state].begin(), outputs[state].end());
+
+            if(_dict_links[state] != NO_STATE) dict_links[id] = ids[_dict_links[state]];
+        }
+
+        _dict_links = std::move(dict_links);
+
+        _output_offsets[state_count] = static_cast<uint32_t>(_outputs.size());
+    }
+};
+
+} // namespace Strazzle
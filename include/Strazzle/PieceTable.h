@@ -0,0 +1,391 @@
+#pragma once
+
+#include "Strazzle/String.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace Strazzle {
+/**
+ * @brief Document for editing huge files, the file is mapped read-only and never copied
+ *        The text is a list of pieces that point either into the file or into an add buffer that only grows, Insert appends to the
+ *        add buffer and Erase drops pieces, so the cost of an edit does not depend on the size of the file. Write streams the
+ *        pieces into a new file without building the text in memory
+ *        The pieces are a flat vector and not a tree: the piece of an edit is searched from the piece of the previous edit, so typing
+ *        and other local edits find it in O(1), but an edit far from the previous one scans O(number of pieces) and splitting a
+ *        piece moves the pieces behind it. That is cheap for the thousands of pieces of an editing session, not for millions
+ */
+class PieceTable {
+#ifdef STRAZZLE_DEBUG_ALL_PUBLIC
+  public:
+#endif
+    enum class Source : uint8_t { ORIGINAL = 0, ADDED = 1 };
+
+    /**
+     * @brief A range of the original file or of the add buffer
+     */
+    struct Piece {
+        // Buffer the piece points into
+        Strazzle::PieceTable::Source source;
+
+        // Offset in the buffer
+        std::size_t off;
+
+        // Length of the piece
+        std::size_t len;
+    };
+
+    // The original file, mapped read-only
+    const char* _original = nullptr;
+
+    // Length of the original file
+    std::size_t _original_len = 0;
+
+#ifndef __linux__
+    // Copy of the file where it can't be mapped
+    Strazzle::String _file;
+#endif
+
+    // Bytes of all insertions, pieces refer to it by offset since it moves when it grows
+    Strazzle::String _added;
+
+    // The pieces of the text in order
+    std::vector<Strazzle::PieceTable::Piece> _pieces;
+
+    // Length of the text
+    std::size_t _len = 0;
+
+    // Index of a piece and its position in the text, the search for the piece of the next edit starts there
+    std::size_t _cursor_k   = 0;
+    std::size_t _cursor_pos = 0;
+
+  public:
+    PieceTable() {
+    }
+
+    /**
+     * @brief Opens a file, only the mapping is set up so it takes the same time for any size of file
+     * @param path Path of the file
+     */
+    explicit PieceTable(const char* path) {
+#ifdef __linux__
+        int fd = open(path, O_RDONLY);
+
+        if(fd < 0) throw std::runtime_error("Could not open file! << Strazzle::PieceTable::PieceTable()\n");
+
+        struct stat st;
+
+        if(fstat(fd, &st) != 0) {
+            close(fd);
+            throw std::runtime_error("Could not stat file! << Strazzle::PieceTable::PieceTable()\n");
+        }
+
+        _original_len = st.st_size;
+
+        if(_original_len != 0) {
+            void* p = mmap(nullptr, _original_len, PROT_READ, MAP_PRIVATE, fd, 0);
+
+            if(p == MAP_FAILED) {
+                close(fd);
+                throw std::runtime_error("Could not map file! << Strazzle::PieceTable::PieceTable()\n");
+            }
+
+            _original = static_cast<const char*>(p);
+        }
+
+        // The mapping keeps the file alive
+        close(fd);
+#else
+        FILE* file = fopen(path, "rb");
+
+        if(file == nullptr) throw std::runtime_error("Could not open file! << Strazzle::PieceTable::PieceTable()\n");
+
+        char buffer[1 << 16];
+
+        for(std::size_t n; (n = fread(buffer, 1, sizeof(buffer), file)) != 0;) {
+            _file.AppendRaw(buffer, n);
+        }
+
+        fclose(file);
+
+        _original     = _file.Data();
+        _original_len = _file.Len();
+#endif
+
+        if(_original_len != 0) _pieces.push_back({Source::ORIGINAL, 0, _original_len});
+
+        _len = _original_len;
+    }
+
+    PieceTable(const PieceTable&) = delete;
+
+    PieceTable& operator=(const PieceTable&) = delete;
+
+    /**
+     * @brief Move constructor, takes over the mapping. table is left empty
+     */
+    PieceTable(PieceTable&& table) noexcept {
+        PieceTable::Steal(table);
+    }
+
+    PieceTable& operator=(PieceTable&& table) noexcept {
+        if(this == &table) return *this;
+
+        PieceTable::Unmap();
+        PieceTable::Steal(table);
+
+        return *this;
+    }
+
+    ~PieceTable() {
+        PieceTable::Unmap();
+    }
+
+    /**
+     * @brief Insert exactly size bytes of str at a specified position. Binary safe, str does not need to be null terminated
+     *        Typing at the end of the previous insertion extends its piece instead of adding one
+     * @param str The bytes to insert.
+     * @param i The position to insert at.
+     * @param size The number of bytes to insert.
+     */
+    void InsertRaw(const char* str, std::size_t i, std::size_t size) {
+        if(i > _len) throw std::out_of_range("Index is out of bounds!\n << Strazzle::PieceTable::InsertRaw()");
+
+        if(size == 0) return;
+
+        std::size_t k   = PieceTable::Split(i);
+        std::size_t off = _added.Len();
+
+        _added.AppendRaw(str, size);
+
+        if(k != 0 && _pieces[k - 1].source == Source::ADDED && _pieces[k - 1].off + _pieces[k - 1].len == off) {
+            _pieces[k - 1].len = _pieces[k - 1].len + size;
+        } else {
+            _pieces.insert(_pieces.begin() + k, {Source::ADDED, off, size});
+
+            k = k + 1;
+        }
+
+        // The next insertion usually follows this one
+        _cursor_k   = k;
+        _cursor_pos = i + size;
+
+        _len = _len + size;
+    }
+
+    /**
+     * @brief Insert str at a specified position
+     * @param str A C string, string literal, char buffer, String or Reference
+     * @param i The position to insert at.
+     */
+    template<typename Str>
+    void Insert(Str&& str, std::size_t i) {
+        auto [data, size] = Strazzle::_Bytes(std::forward<Str>(str));
+
+        PieceTable::InsertRaw(data, i, size);
+    }
+
+    /**
+     * @brief Erase part of the text, no bytes are moved
+     * @param i The starting position to erase.
+     * @param size The number of characters to erase (default is SIZE_MAX).
+     */
+    void Erase(std::size_t i, std::size_t size = SIZE_MAX) {
+        if(i >= _len) throw std::out_of_range("Index is out of bounds!\n << Strazzle::PieceTable::Erase()");
+
+        size = std::min(_len - i, size);
+
+        std::size_t first = PieceTable::Split(i);
+        std::size_t last  = PieceTable::Split(i + size);
+
+        _pieces.erase(_pieces.begin() + first, _pieces.begin() + last);
+
+        _cursor_k   = first;
+        _cursor_pos = i;
+
+        _len = _len - size;
+    }
+
+    /**
+     * @brief Returns a substr as a String, only the pieces of the substr are read
+     * @param i The starting index
+     * @param size The lenght of the substr
+     */
+    Strazzle::String Substr(std::size_t i, std::size_t size = SIZE_MAX) const {
+        if(i >= _len) throw std::out_of_range("Index is out of bounds! << Strazzle::PieceTable::Substr()\n");
+
+        size = std::min(_len - i, size);
+
+        Strazzle::String str;
+
+        str.Reserve(size + 1);
+
+        auto [k, pos] = PieceTable::Find(i);
+
+        for(std::size_t skip = i - pos; str.Len() < size; k++) {
+            const Piece& piece = _pieces[k];
+
+            str.AppendRaw(PieceTable::Data(piece) + skip, std::min(piece.len - skip, size - str.Len()));
+
+            skip = 0;
+        }
+
+        return str;
+    }
+
+    /**
+     * @brief Streams the text into file piece by piece
+     * @param file A file opened for writing
+     */
+    void Write(FILE* file) const {
+        for(const Piece& piece : _pieces) {
+            if(fwrite(PieceTable::Data(piece), 1, piece.len, file) != piece.len)
+                throw std::runtime_error("Could not write file! << Strazzle::PieceTable::Write()\n");
+        }
+    }
+
+    /**
+     * @brief Streams the text into a new file at path, which may be the file the table was opened from
+     *        The text is written to path.tmp first and renamed over path, so the mapped original stays intact until it's replaced
+     * @param path Path of the file
+     */
+    void Write(const char* path) const {
+        Strazzle::String tmp(path);
+
+        tmp.Append(".tmp");
+
+        FILE* file = fopen(tmp.Cstr(), "wb");
+
+        if(file == nullptr) throw std::runtime_error("Could not open file! << Strazzle::PieceTable::Write()\n");
+
+        try {
+            PieceTable::Write(file);
+        } catch(...) {
+            fclose(file);
+            remove(tmp.Cstr());
+            throw;
+        }
+
+        if(fclose(file) != 0 || rename(tmp.Cstr(), path) != 0) {
+            remove(tmp.Cstr());
+            throw std::runtime_error("Could not write file! << Strazzle::PieceTable::Write()\n");
+        }
+    }
+
+    /**
+     * @brief Get the length of the text.
+     */
+    std::size_t Len() const {
+        return _len;
+    }
+
+    /**
+     * @brief Get the number of pieces, every edit adds at most two
+     */
+    std::size_t Pieces() const {
+        return _pieces.size();
+    }
+
+#ifndef STRAZZLE_DEBUG_ALL_PUBLIC
+  private:
+#endif
+    /**
+     * @brief Get a pointer to the bytes of a piece
+     */
+    const char* Data(const Piece& piece) const {
+        return (piece.source == Source::ORIGINAL ? _original : _added.Data()) + piece.off;
+    }
+
+    /**
+     * @brief Finds the piece position i of the text falls into, searching from the cursor
+     * @return The index of the piece and its position in the text, or the number of pieces and the length if i is the end of the text
+     */
+    std::pair<std::size_t, std::size_t> Find(std::size_t i) const {
+        std::size_t k   = _cursor_k;
+        std::size_t pos = _cursor_pos;
+
+        while(pos > i) {
+            k   = k - 1;
+            pos = pos - _pieces[k].len;
+        }
+
+        while(k < _pieces.size() && pos + _pieces[k].len <= i) {
+            pos = pos + _pieces[k].len;
+            k   = k + 1;
+        }
+
+        return {k, pos};
+    }
+
+    /**
+     * @brief Makes a piece start at position i of the text by splitting the piece i falls into
+     * @return The index of the piece that starts at i, or the number of pieces if i is the end of the text
+     */
+    std::size_t Split(std::size_t i) {
+        auto [k, pos] = PieceTable::Find(i);
+
+        if(pos != i) {
+            Piece& piece = _pieces[k];
+
+            std::size_t head = i - pos;
+
+            Piece tail = {piece.source, piece.off + head, piece.len - head};
+
+            piece.len = head;
+
+            _pieces.insert(_pieces.begin() + k + 1, tail);
+
+            k = k + 1;
+        }
+
+        _cursor_k   = k;
+        _cursor_pos = i;
+
+        return k;
+    }
+
+    /**
+     * @brief Takes over the mapping and the pieces of table and leaves it empty, the current mapping has to be unmapped already
+     */
+    void Steal(PieceTable& table) {
+        _original     = std::exchange(table._original, nullptr);
+        _original_len = std::exchange(table._original_len, 0);
+#ifndef __linux__
+        // A short file is stored inline in the String so the pointer has to follow it
+        _file     = std::move(table._file);
+        _original = _file.Data();
+#endif
+        _added  = std::move(table._added);
+        _pieces     = std::move(table._pieces);
+        _len        = std::exchange(table._len, 0);
+        _cursor_k   = std::exchange(table._cursor_k, 0);
+        _cursor_pos = std::exchange(table._cursor_pos, 0);
+
+        table._pieces.clear();
+    }
+
+    /**
+     * @brief Unmaps the original file
+     */
+    void Unmap() {
+#ifdef __linux__
+        if(_original != nullptr) munmap(const_cast<char*>(_original), _original_len);
+#endif
+
+        _original     = nullptr;
+        _original_len = 0;
+    }
+};
+} // namespace Strazzle
@@ -0,0 +1,452 @@
+#pragma once
+
+#include <cinttypes>
+#include <cstddef>
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+#ifdef STRAZZLE_PROFILE
+    #include <algorithm>
+    #include <atomic>
+    #include <chrono>
+    #include <mutex>
+    #include <unordered_map>
+#endif
+
+namespace Strazzle {
+// Log2 of the number of sampled heap buffers whose lifetime can be followed at the same time
+const std::size_t PROFILE_SLOTS_EXP = 10;
+
+/**
+ * @brief What the sampled heap buffers of one call site cost, counts and bytes are estimates (samples times the sample rate)
+ */
+struct ProfileSite {
+    // Tag of the site, see Strazzle::ProfileScope, nullptr if the site is a return address
+    const char* tag;
+
+    // Return address of the outermost string call that allocated, see Strazzle::_CallerScope. nullptr if the site is a tag
+    const void* address;
+
+    // Estimated number of allocations
+    std::size_t allocations;
+
+    // Estimated number of bytes allocated
+    std::size_t bytes;
+
+    // Estimated number of SMALL_STRING <-> LARGE_STRING transitions of the buffers of the site
+    std::size_t mode_changes;
+
+    // Number of sampled buffers that were freed, the lifetimes are measured from them
+    std::size_t freed;
+
+    // Sum of the lifetimes of the freed samples in nanoseconds
+    uint64_t total_lifetime_ns;
+
+    // Longest lifetime of a freed sample in nanoseconds
+    uint64_t max_lifetime_ns;
+};
+
+/**
+ * @brief Tag of the innermost Strazzle::ProfileScope of the current thread
+ */
+inline const char*& _ProfileTag() {
+    static thread_local const char* tag = nullptr;
+
+    return tag;
+}
+
+/**
+ * @brief Return address of the outermost Strazzle::_CallerScope of the current thread, nullptr outside of string calls
+ */
+inline const void*& _ProfileCaller() {
+    static thread_local const void* caller = nullptr;
+
+    return caller;
+}
+
+// Marks the public string calls that open a Strazzle::_CallerScope. They are not inlined while sites are recorded, so their return
+// address is the call of the user and not the one of the function the call would have been inlined into
+#if defined(STRAZZLE_PROFILE) || defined(STRAZZLE_LENGTH_HISTOGRAM)
+    #define STRAZZLE_ENTRY_POINT [[gnu::noinline]]
+#else
+    #define STRAZZLE_ENTRY_POINT
+#endif
+
+/**
+ * @brief Makes the return address of a public string call the site of the allocations and growths below it
+ *        Only the outermost scope of a thread sets it, so calls that call each other (eg Append calling AppendRaw) keep the site of
+ *        the call of the user. The calls are STRAZZLE_ENTRY_POINTs, so the address is never taken in a frame they were inlined into
+ * @param address __builtin_return_address(0) of the public call
+ */
+class _CallerScope {
+#ifdef STRAZZLE_DEBUG_ALL_PUBLIC
+  public:
+#endif
+    // Whether this scope set the caller
+    [[maybe_unused]] bool _outermost = false;
+
+  public:
+    explicit _CallerScope([[maybe_unused]] const void* address) {
+#if defined(STRAZZLE_PROFILE) || defined(STRAZZLE_LENGTH_HISTOGRAM)
+        _outermost = Strazzle::_ProfileCaller() == nullptr;
+
+        if(_outermost) Strazzle::_ProfileCaller() = address;
+#endif
+    }
+
+    _CallerScope(const _CallerScope&) = delete;
+
+    _CallerScope& operator=(const _CallerScope&) = delete;
+
+    ~_CallerScope() {
+#if defined(STRAZZLE_PROFILE) || defined(STRAZZLE_LENGTH_HISTOGRAM)
+        if(_outermost) Strazzle::_ProfileCaller() = nullptr;
+#endif
+    }
+};
+
+#ifdef STRAZZLE_PROFILE
+/**
+ * @brief A sampled heap buffer that is still alive
+ */
+struct _ProfileSample {
+    // Site that allocated the buffer, see Strazzle::ProfileSite
+    const char* tag;
+    const void* address;
+
+    // When the buffer was allocated
+    std::chrono::steady_clock::time_point birth;
+};
+
+/**
+ * @brief State of the profiler, the sampled paths take the lock
+ */
+struct _Profiler {
+    std::mutex mutex;
+
+    // One in sample_rate allocations is recorded, 0 records none
+    std::atomic<std::size_t> sample_rate = 1024;
+
+    // The samples of the buffers in Strazzle::_ProfileBuffers, same index
+    Strazzle::_ProfileSample samples[1UL << Strazzle::PROFILE_SLOTS_EXP];
+
+    // Aggregates by site, the key is the tag or the return address
+    std::unordered_map<const void*, Strazzle::ProfileSite> sites;
+};
+
+/**
+ * @brief Get the profiler, it is never destroyed so strings may still be freed while static objects are destroyed
+ */
+inline Strazzle::_Profiler& _GetProfiler() {
+    static Strazzle::_Profiler* profiler = new Strazzle::_Profiler();
+
+    return *profiler;
+}
+
+/**
+ * @brief The sampled buffers by slot, nullptr if the slot is free
+ *        Every free looks up its slot without the lock, so the slots are a constant initialized array apart from the profiler
+ */
+inline std::atomic<const char*>* _ProfileBuffers() {
+    static std::atomic<const char*> buffers[1UL << Strazzle::PROFILE_SLOTS_EXP] = {};
+
+    return buffers;
+}
+
+/**
+ * @brief Allocations of the current thread left until the next sample
+ */
+inline std::size_t& _ProfileCountdown() {
+    static thread_local std::size_t countdown = 0;
+
+    return countdown;
+}
+
+/**
+ * @brief Get the slot a buffer is tracked in
+ */
+inline std::size_t _ProfileSlotOf(const char* data) {
+    uint64_t h = (reinterpret_cast<uintptr_t>(data) >> 4) * 0x9E3779B97F4A7C15ULL;
+
+    return h >> (64 - Strazzle::PROFILE_SLOTS_EXP);
+}
+
+/**
+ * @brief Get the aggregate of a site, the lock has to be held
+ */
+inline Strazzle::ProfileSite& _ProfileSiteOf(Strazzle::_Profiler& profiler, const char* tag, const void* address) {
+    auto [it, inserted] = profiler.sites.try_emplace(tag != nullptr ? static_cast<const void*>(tag) : address);
+
+    if(inserted) it->second = {tag, address, 0, 0, 0, 0, 0, 0};
+
+    return it->second;
+}
+
+/**
+ * @brief Slow path of Strazzle::_ProfileAllocate, the countdown ran out
+ *        The distance to the next sample is random with a mean of the sample rate so periodic allocation patterns don't alias
+ */
+__attribute__((noinline, cold)) inline void _ProfileSampleAllocation(const char* data, std::size_t bytes) {
+    static thread_local uint32_t state = 2463534242U;
+
+    Strazzle::_Profiler& profiler = Strazzle::_GetProfiler();
+
+    std::size_t& countdown = Strazzle::_ProfileCountdown();
+    std::size_t  rate      = profiler.sample_rate.load(std::memory_order_relaxed);
+
+    // Sampling is off, look at the rate again later
+    if(rate == 0) {
+        countdown = 1UL << 16;
+        return;
+    }
+
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+
+    bool sample = countdown == 1;
+
+    countdown = 1 + state % (2 * rate - 1);
+
+    if(!sample) return;
+
+    const char* tag     = Strazzle::_ProfileTag();
+    const void* address = tag == nullptr ? Strazzle::_ProfileCaller() : nullptr;
+
+    std::lock_guard lock(profiler.mutex);
+
+    Strazzle::ProfileSite& stats = Strazzle::_ProfileSiteOf(profiler, tag, address);
+
+    stats.allocations = stats.allocations + rate;
+    stats.bytes       = stats.bytes + bytes * rate;
+
+    // The lifetime of a buffer is only followed if its slot is free
+    std::size_t k = Strazzle::_ProfileSlotOf(data);
+
+    if(Strazzle::_ProfileBuffers()[k].load(std::memory_order_relaxed) == nullptr) {
+        profiler.samples[k] = {tag, address, std::chrono::steady_clock::now()};
+
+        Strazzle::_ProfileBuffers()[k].store(data, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Slow path of Strazzle::_ProfileFree, the buffer may be sampled
+ */
+__attribute__((noinline, cold)) inline void _ProfileEndSample(const char* data, std::size_t k) {
+    Strazzle::_Profiler& profiler = Strazzle::_GetProfiler();
+
+    std::lock_guard lock(profiler.mutex);
+
+    if(Strazzle::_ProfileBuffers()[k].load(std::memory_order_relaxed) != data) return;
+
+    Strazzle::_ProfileSample& sample = profiler.samples[k];
+
+    uint64_t lifetime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - sample.birth).count();
+
+    Strazzle::ProfileSite& stats = Strazzle::_ProfileSiteOf(profiler, sample.tag, sample.address);
+
+    stats.freed             = stats.freed + 1;
+    stats.total_lifetime_ns = stats.total_lifetime_ns + lifetime;
+    stats.max_lifetime_ns   = std::max(stats.max_lifetime_ns, lifetime);
+
+    Strazzle::_ProfileBuffers()[k].store(nullptr, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Slow path of Strazzle::_ProfileMove, the old buffer may be sampled
+ */
+__attribute__((noinline, cold)) inline void _ProfileMoveSample(const char* old_data, const char* new_data, std::size_t k) {
+    Strazzle::_Profiler& profiler = Strazzle::_GetProfiler();
+
+    std::lock_guard lock(profiler.mutex);
+
+    if(Strazzle::_ProfileBuffers()[k].load(std::memory_order_relaxed) != old_data) return;
+
+    std::size_t new_k = Strazzle::_ProfileSlotOf(new_data);
+
+    if(Strazzle::_ProfileBuffers()[new_k].load(std::memory_order_relaxed) == nullptr) {
+        profiler.samples[new_k] = profiler.samples[k];
+
+        Strazzle::_ProfileBuffers()[new_k].store(new_data, std::memory_order_relaxed);
+    }
+
+    Strazzle::_ProfileBuffers()[k].store(nullptr, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Slow path of Strazzle::_ProfileModeChange, the buffer may be sampled
+ */
+__attribute__((noinline, cold)) inline void _ProfileCountModeChange(const char* data, std::size_t k) {
+    Strazzle::_Profiler& profiler = Strazzle::_GetProfiler();
+
+    std::lock_guard lock(profiler.mutex);
+
+    if(Strazzle::_ProfileBuffers()[k].load(std::memory_order_relaxed) != data) return;
+
+    Strazzle::ProfileSite& stats = Strazzle::_ProfileSiteOf(profiler, profiler.samples[k].tag, profiler.samples[k].address);
+
+    stats.mode_changes = stats.mode_changes + profiler.sample_rate.load(std::memory_order_relaxed);
+}
+#endif
+
+/**
+ * @brief Records a new heap buffer if it is sampled, does nothing if STRAZZLE_PROFILE is not defined
+ *        Unsampled allocations only count down a thread local counter
+ *        The site is the tag of the innermost Strazzle::ProfileScope, or the caller of the outermost Strazzle::_CallerScope
+ * @param data The buffer
+ * @param bytes Size of the buffer
+ */
+inline void _ProfileAllocate([[maybe_unused]] const char* data, [[maybe_unused]] std::size_t bytes) {
+#ifdef STRAZZLE_PROFILE
+    std::size_t& countdown = Strazzle::_ProfileCountdown();
+
+    if(countdown > 1) [[likely]] {
+        countdown = countdown - 1;
+        return;
+    }
+
+    Strazzle::_ProfileSampleAllocation(data, bytes);
+#endif
+}
+
+/**
+ * @brief Ends the lifetime of a buffer that is about to be freed, an unsampled buffer costs one load of its slot
+ */
+inline void _ProfileFree([[maybe_unused]] const char* data) {
+#ifdef STRAZZLE_PROFILE
+    std::size_t k = Strazzle::_ProfileSlotOf(data);
+
+    if(Strazzle::_ProfileBuffers()[k].load(std::memory_order_relaxed) == data) [[unlikely]] {
+        Strazzle::_ProfileEndSample(data, k);
+    }
+#endif
+}
+
+/**
+ * @brief Follows a sampled buffer that was moved by the Reallocate of the allocator
+ */
+inline void _ProfileMove([[maybe_unused]] const char* old_data, [[maybe_unused]] const char* new_data) {
+#ifdef STRAZZLE_PROFILE
+    std::size_t k = Strazzle::_ProfileSlotOf(old_data);
+
+    if(old_data != new_data && Strazzle::_ProfileBuffers()[k].load(std::memory_order_relaxed) == old_data) [[unlikely]] {
+        Strazzle::_ProfileMoveSample(old_data, new_data, k);
+    }
+#endif
+}
+
+/**
+ * @brief Counts a SMALL_STRING <-> LARGE_STRING transition of a buffer, does nothing if it isn't sampled
+ */
+inline void _ProfileModeChange([[maybe_unused]] const char* data) {
+#ifdef STRAZZLE_PROFILE
+    std::size_t k = Strazzle::_ProfileSlotOf(data);
+
+    if(Strazzle::_ProfileBuffers()[k].load(std::memory_order_relaxed) == data) [[unlikely]] {
+        Strazzle::_ProfileCountModeChange(data, k);
+    }
+#endif
+}
+
+/**
+ * @brief Attributes the string allocations and growths of the current thread to tag while the scope is alive, scopes nest
+ *        Sites are the return addresses of the string calls otherwise, see Strazzle::_CallerScope
+ *        Used by STRAZZLE_PROFILE and by the growth sites of STRAZZLE_LENGTH_HISTOGRAM
+ * @param tag A string literal, it's compared by address
+ */
+class ProfileScope {
+#ifdef STRAZZLE_DEBUG_ALL_PUBLIC
+  public:
+#endif
+    // Tag of the enclosing scope
+    [[maybe_unused]] const char* _previous = nullptr;
+
+  public:
+    explicit ProfileScope([[maybe_unused]] const char* tag) {
+#if defined(STRAZZLE_PROFILE) || defined(STRAZZLE_LENGTH_HISTOGRAM)
+        _previous = std::exchange(Strazzle::_ProfileTag(), tag);
+#endif
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+    ~ProfileScope() {
+#if defined(STRAZZLE_PROFILE) || defined(STRAZZLE_LENGTH_HISTOGRAM)
+        Strazzle::_ProfileTag() = _previous;
+#endif
+    }
+};
+
+/**
+ * @brief Sets how many string allocations there are per sample on average, 0 stops sampling. The default is 1024
+ *        Threads pick the new rate up after their next sample, or within 65536 allocations if sampling was off
+ */
+inline void SetProfileSampleRate([[maybe_unused]] std::size_t rate) {
+#ifdef STRAZZLE_PROFILE
+    Strazzle::_GetProfiler().sample_rate.store(rate, std::memory_order_relaxed);
+#endif
+}
+
+/**
+ * @brief Get the sites sorted by estimated bytes allocated, empty if STRAZZLE_PROFILE is not defined
+ */
+inline std::vector<Strazzle::ProfileSite> GetProfile() {
+    std::vector<Strazzle::ProfileSite> sites;
+
+#ifdef STRAZZLE_PROFILE
+    Strazzle::_Profiler& profiler = Strazzle::_GetProfiler();
+
+    {
+        std::lock_guard lock(profiler.mutex);
+
+        for(const auto& [site, stats] : profiler.sites) {
+            sites.push_back(stats);
+        }
+    }
+
+    std::sort(sites.begin(), sites.end(), [](const ProfileSite& a, const ProfileSite& b) { return a.bytes > b.bytes; });
+#endif
+
+    return sites;
+}
+
+/**
+ * @brief Drops all sites, buffers that are still followed keep being followed
+ */
+inline void ResetProfile() {
+#ifdef STRAZZLE_PROFILE
+    Strazzle::_Profiler& profiler = Strazzle::_GetProfiler();
+
+    std::lock_guard lock(profiler.mutex);
+
+    profiler.sites.clear();
+#endif
+}
+
+/**
+ * @brief Writes the sites sorted by estimated bytes allocated as a table, addresses can be resolved with addr2line
+ * @param file A file opened for writing, eg stderr
+ */
+inline void DumpProfile(FILE* file) {
+    fprintf(file, "%-32s %14s %16s %12s %14s %14s\n", "site", "allocations", "bytes", "mode_changes", "avg_life_us", "max_life_us");
+
+    for(const Strazzle::ProfileSite& site : Strazzle::GetProfile()) {
+        char name[64];
+
+        if(site.tag != nullptr) {
+            snprintf(name, sizeof(name), "%s", site.tag);
+        } else {
+            snprintf(name, sizeof(name), "%p", site.address);
+        }
+
+        double avg = site.freed != 0 ? site.total_lifetime_ns / 1000.0 / site.freed : 0.0;
+
+        fprintf(file, "%-32s %14zu %16zu %12zu %14.1f %14.1f\n", name, site.allocations, site.bytes, site.mode_changes, avg,
+                site.max_lifetime_ns / 1000.0);
+    }
+}
+} // namespace Strazzle
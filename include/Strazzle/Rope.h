@@ -0,0 +1,610 @@
+#pragma once
+
+#include "Strazzle/String.h"
+
+#include <cinttypes>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace Strazzle {
+// Size of the allocation behind a leaf, a leaf holds at most ROPE_LEAF_SIZE - 1 chars
+const std::size_t ROPE_LEAF_SIZE = 2048;
+
+/**
+ * @brief Utility function to get a pseudo random priority for a rope node (xorshift32)
+ * @return The priority
+ */
+inline uint32_t _RopePriority() {
+    static thread_local uint32_t state = 2463534242U;
+
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+
+    return state;
+}
+
+/**
+ * @brief Rope for "large" strings, a balanced tree (treap) of pieces that point into Strazzle::String leaves
+ *        Insert, Erase and Substr are O(log n). Nodes and leaves are immutable and shared, so copies and substrs don't copy any text
+ */
+class Rope {
+#ifdef STRAZZLE_DEBUG_ALL_PUBLIC
+  public:
+#endif
+    struct Node;
+
+    using NodePtr = std::shared_ptr<const Strazzle::Rope::Node>;
+    using LeafPtr = std::shared_ptr<const Strazzle::String>;
+
+  public:
+    /**
+     * @brief Reference to a Rope ie a view of a range of the base, the range may span any number of leaves
+     */
+    struct Reference {
+        friend Rope;
+
+#ifndef STRAZZLE_DEBUG_ALL_PUBLIC
+      private:
+#endif
+        Reference(const Strazzle::Rope& base, std::size_t i, std::size_t len) : _base(base), _i(i), _len(len) {
+        }
+
+#ifndef STRAZZLE_DEBUG_ALL_PUBLIC
+      private:
+#endif
+        // The base
+        const Strazzle::Rope& _base;
+
+        // Start of substr in base
+        std::size_t _i;
+        // Len of substr
+        std::size_t _len;
+
+        /**
+         * @brief Checks if the reference is still within bounds of the base
+         */
+        void CheckBounds() const {
+            if(_i + _len > _base.Len())
+                throw std::out_of_range("Reference is not within bounds of base! << Strazzle::Rope::Reference::CheckBounds()");
+        }
+
+#ifndef STRAZZLE_DEBUG_ALL_PUBLIC
+      public:
+#endif
+        /**
+         * @brief Get the length of the reference.
+         * @return The length of the reference.
+         */
+        std::size_t Len() const {
+            return _len;
+        }
+
+        /**
+         * @brief Get the char at the given index of the reference
+         * @param i The index
+         * @return The char
+         */
+        char At(std::size_t i) const {
+            if(i >= _len) throw std::out_of_range("Index is out of bounds! << Strazzle::Rope::Reference::At()\n");
+
+            return _base.At(_i + i);
+        }
+
+        /**
+         * @brief Calls fn(const char* str, std::size_t size) for every contiguous chunk of the reference in order
+         * @param fn The function to call
+         */
+        template<typename Fn>
+        void ForEachChunk(Fn&& fn) const {
+            CheckBounds();
+
+            Strazzle::Rope::VisitRange(_base._root, _i, _len, fn);
+        }
+
+        /**
+         * @brief Copies the referenced range into a contiguous string
+         * @return The string
+         */
+        STRAZZLE_ENTRY_POINT Strazzle::String ToString() const {
+            Strazzle::_CallerScope caller(__builtin_return_address(0));
+
+            CheckBounds();
+
+            return Strazzle::Rope::Flatten(_base._root, _i, _len);
+        }
+    };
+
+#ifndef STRAZZLE_DEBUG_ALL_PUBLIC
+  public:
+#endif
+    Rope() {
+    }
+
+    Rope(const char* str, std::size_t size = SIZE_MAX) {
+        Strazzle::Rope::Append(str, size);
+    }
+
+    Rope(const Strazzle::String& str, std::size_t size = SIZE_MAX) {
+        Strazzle::Rope::Append(str, size);
+    }
+
+    /**
+     * @brief Adopts the buffer of str as a single leaf in O(1), edits split it into pieces without copying
+     */
+    Rope(Strazzle::String&& str) {
+        std::size_t size = str.Len();
+
+        if(size == 0) return;
+
+        _root = std::make_shared<const Strazzle::Rope::Node>(
+            nullptr, std::make_shared<const Strazzle::String>(std::move(str)), 0, size, nullptr, Strazzle::_RopePriority());
+    }
+
+    Rope(const Strazzle::Rope::Reference& ref, std::size_t size = SIZE_MAX) {
+        ref.CheckBounds();
+
+        _root = Strazzle::Rope::Slice(ref._base._root, ref._i, std::min(ref._len, size));
+    }
+
+#ifndef STRAZZLE_DEBUG_ALL_PUBLIC
+  private:
+#endif
+    /**
+     * @brief A piece of a leaf, ordered in the tree by position and in a heap by priority
+     */
+    struct Node {
+        Node(NodePtr left, LeafPtr leaf, std::size_t off, std::size_t size, NodePtr right, uint32_t priority) :
+            _left(std::move(left)), _right(std::move(right)), _leaf(std::move(leaf)), _off(off), _size(size), _priority(priority) {
+            _len = Strazzle::Rope::Len(_left) + _size + Strazzle::Rope::Len(_right);
+        }
+
+        NodePtr _left;
+        NodePtr _right;
+
+        // The leaf this piece points into
+        LeafPtr _leaf;
+        // Start of the piece in the leaf
+        std::size_t _off;
+        // Len of the piece
+        std::size_t _size;
+
+        // Len of the whole subtree
+        std::size_t _len;
+
+        uint32_t _priority;
+
+        /**
+         * @brief Get a pointer to the first char of the piece
+         */
+        const char* Data() const {
+            return _leaf->Cstr() + _off;
+        }
+    };
+
+    // Root of the tree, nullptr if the rope is empty
+    NodePtr _root;
+
+#ifndef STRAZZLE_DEBUG_ALL_PUBLIC
+  public:
+#endif
+    /**
+     * @brief Append a string to the end of the rope.
+     * @param str The string to append.
+     * @param size Maximum size to append (default is SIZE_MAX).
+     */
+    void Append(const char* str, std::size_t size = SIZE_MAX) {
+        size = std::min(strlen(str), size);
+
+        Strazzle::Rope::InsertRaw(str, Strazzle::Rope::Len(), size);
+    }
+
+    /**
+     * @brief String version of Append
+     * @param str The string to append.
+     * @param size Maximum size to append (default is SIZE_MAX).
+     */
+    void Append(const Strazzle::String& str, std::size_t size = SIZE_MAX) {
+        size = std::min(str.Len(), size);
+
+        Strazzle::Rope::InsertRaw(str.Cstr(), Strazzle::Rope::Len(), size);
+    }
+
+    /**
+     * @brief Rope version of Append, shares the nodes of rope
+     * @param rope The rope to append.
+     */
+    void Append(const Strazzle::Rope& rope) {
+        _root = Strazzle::Rope::Merge(_root, rope._root);
+    }
+
+    /**
+     * @brief Insert a string at a specified position in the rope.
+     * @param str The string to insert.
+     * @param i The position to insert at.
+     * @param size Maximum size to insert (default is SIZE_MAX).
+     */
+    void Insert(const char* str, std::size_t i, std::size_t size = SIZE_MAX) {
+        if(i > Strazzle::Rope::Len()) throw std::out_of_range("Index is out of bounds!\n << Strazzle::Rope::Insert()");
+
+        size = std::min(strlen(str), size);
+
+        Strazzle::Rope::InsertRaw(str, i, size);
+    }
+
+    /**
+     * @brief String version of Insert
+     * @param str The string to insert.
+     * @param i The position to insert at.
+     * @param size Maximum size to insert (default is SIZE_MAX).
+     */
+    void Insert(const Strazzle::String& str, std::size_t i, std::size_t size = SIZE_MAX) {
+        if(i > Strazzle::Rope::Len()) throw std::out_of_range("Index is out of bounds!\n << Strazzle::Rope::Insert()");
+
+        size = std::min(str.Len(), size);
+
+        Strazzle::Rope::InsertRaw(str.Cstr(), i, size);
+    }
+
+    /**
+     * @brief Rope version of Insert, shares the nodes of rope
+     * @param rope The rope to insert.
+     * @param i The position to insert at.
+     */
+    void Insert(const Strazzle::Rope& rope, std::size_t i) {
+        if(i > Strazzle::Rope::Len()) throw std::out_of_range("Index is out of bounds!\n << Strazzle::Rope::Insert()");
+
+        auto [left, right] = Strazzle::Rope::Split(_root, i);
+
+        _root = Strazzle::Rope::Merge(Strazzle::Rope::Merge(left, rope._root), right);
+    }
+
+    /**
+     * @brief Reference version of Insert, shares the nodes of the base
+     * @param ref The reference to insert.
+     * @param i The position to insert at.
+     */
+    void Insert(const Strazzle::Rope::Reference& ref, std::size_t i) {
+        Strazzle::Rope::Insert(Strazzle::Rope(ref), i);
+    }
+
+    /**
+     * @brief Erase a portion of the rope starting from a specified position.
+     * @param i The starting position for erasing.
+     * @param size Maximum size to erase (default is SIZE_MAX).
+     */
+    void Erase(std::size_t i, std::size_t size = SIZE_MAX) {
+        if(i >= Strazzle::Rope::Len()) throw std::out_of_range("Index is out of bounds!\n << Strazzle::Rope::Erase()");
+
+        size = std::min(Strazzle::Rope::Len() - i, size);
+
+        auto [left, rest]  = Strazzle::Rope::Split(_root, i);
+        auto [mid, right] = Strazzle::Rope::Split(rest, size);
+
+        _root = Strazzle::Rope::Merge(left, right);
+    }
+
+    /**
+     * @brief Get the length of the rope.
+     * @return The length of the rope.
+     */
+    std::size_t Len() const {
+        return Strazzle::Rope::Len(_root);
+    }
+
+    /**
+     * @brief Get the char at the given index
+     * @param i The index
+     * @return The char
+     */
+    char At(std::size_t i) const {
+        if(i >= Strazzle::Rope::Len()) throw std::out_of_range("Index is out of bounds! << Strazzle::Rope::At()\n");
+
+        const Strazzle::Rope::Node* node = _root.get();
+
+        while(true) {
+            std::size_t left_len = Strazzle::Rope::Len(node->_left);
+
+            if(i < left_len) {
+                node = node->_left.get();
+            } else if(i < left_len + node->_size) {
+                return node->Data()[i - left_len];
+            } else {
+                i    = i - left_len - node->_size;
+                node = node->_right.get();
+            }
+        }
+    }
+
+    /**
+     * @brief Returns a substr, the substr shares its leaves with this rope
+     * @param i The starting index
+     * @param size The lenght of the substr
+     */
+    Strazzle::Rope Substr(std::size_t i, std::size_t size = SIZE_MAX) const {
+        if(i >= Strazzle::Rope::Len()) throw std::out_of_range("Index is out of bounds! << Strazzle::Rope::Substr()\n");
+
+        size = std::min(Strazzle::Rope::Len() - i, size);
+
+        Strazzle::Rope rope;
+
+        rope._root = Strazzle::Rope::Slice(_root, i, size);
+
+        return rope;
+    }
+
+    /**
+     * @brief Returns a reference substr
+     * @param i The starting index
+     * @param size The lenght of the substr
+     */
+    Strazzle::Rope::Reference RefSubstr(std::size_t i, std::size_t size = SIZE_MAX) const {
+        if(i >= Strazzle::Rope::Len()) throw std::out_of_range("Index is out of bounds! << Strazzle::Rope::RefSubstr()\n");
+
+        size = std::min(Strazzle::Rope::Len() - i, size);
+
+        return Strazzle::Rope::Reference(*this, i, size);
+    }
+
+    /**
+     * @brief Calls fn(const char* str, std::size_t size) for every contiguous chunk of the rope in order
+     * @param fn The function to call
+     */
+    template<typename Fn>
+    void ForEachChunk(Fn&& fn) const {
+        Strazzle::Rope::VisitRange(_root, 0, Strazzle::Rope::Len(), fn);
+    }
+
+    /**
+     * @brief Copies the rope into a contiguous string
+     * @return The string
+     */
+    STRAZZLE_ENTRY_POINT Strazzle::String ToString() const {
+        Strazzle::_CallerScope caller(__builtin_return_address(0));
+
+        return Strazzle::Rope::Flatten(_root, 0, Strazzle::Rope::Len());
+    }
+
+#ifndef STRAZZLE_DEBUG_ALL_PUBLIC
+  private:
+#endif
+    /**
+     * @brief Inserts size bytes of str at i, str does not need to be null terminated
+     * @param str The bytes to insert.
+     * @param i The position to insert at.
+     * @param size The number of bytes to insert.
+     */
+    void InsertRaw(const char* str, std::size_t i, std::size_t size) {
+        if(size == 0) return;
+
+        // Small inserts are merged into the piece at i when it has room, this keeps leaves from fragmenting on char by char edits
+        if(size < Strazzle::ROPE_LEAF_SIZE) {
+            Strazzle::Rope::NodePtr local = Strazzle::Rope::InsertLocal(_root, i, str, size);
+
+            if(local) {
+                _root = std::move(local);
+                return;
+            }
+        }
+
+        auto [left, right] = Strazzle::Rope::Split(_root, i);
+
+        _root = Strazzle::Rope::Merge(Strazzle::Rope::Merge(left, Strazzle::Rope::Build(str, size)), right);
+    }
+
+    /**
+     * @brief Get the length of a subtree
+     * @param node The root of the subtree, may be nullptr
+     */
+    static std::size_t Len(const NodePtr& node) {
+        return node ? node->_len : 0;
+    }
+
+    /**
+     * @brief Creates a copy of node with different children
+     */
+    static NodePtr WithChildren(const NodePtr& node, NodePtr left, NodePtr right) {
+        return std::make_shared<const Strazzle::Rope::Node>(std::move(left), node->_leaf, node->_off, node->_size, std::move(right), node->_priority);
+    }
+
+    /**
+     * @brief Creates a leaf holding a copy of size bytes of str
+     */
+    static LeafPtr MakeLeaf(const char* str, std::size_t size) {
+        auto leaf = std::make_shared<Strazzle::String>();
+
+        leaf->AppendRaw(str, size);
+
+        return leaf;
+    }
+
+    /**
+     * @brief Builds a balanced subtree from size bytes of str, split into leaves of at most ROPE_LEAF_SIZE - 1 chars
+     * @return The root of the subtree
+     */
+    static NodePtr Build(const char* str, std::size_t size) {
+        const std::size_t leaf_len = Strazzle::ROPE_LEAF_SIZE - 1;
+
+        return Strazzle::Rope::BuildRange(str, size, 0, (size + leaf_len - 1) / leaf_len);
+    }
+
+    /**
+     * @brief Builds the subtree of the leaves [lo, hi) of str
+     */
+    static NodePtr BuildRange(const char* str, std::size_t size, std::size_t lo, std::size_t hi) {
+        if(lo >= hi) return nullptr;
+
+        const std::size_t leaf_len = Strazzle::ROPE_LEAF_SIZE - 1;
+
+        std::size_t mid = lo + (hi - lo) / 2;
+
+        NodePtr left  = Strazzle::Rope::BuildRange(str, size, lo, mid);
+        NodePtr right = Strazzle::Rope::BuildRange(str, size, mid + 1, hi);
+
+        std::size_t off   = mid * leaf_len;
+        std::size_t chunk = std::min(leaf_len, size - off);
+
+        // Keep the heap order, the tree is already balanced by construction
+        uint32_t priority = Strazzle::_RopePriority();
+
+        if(left) priority = std::max(priority, left->_priority);
+        if(right) priority = std::max(priority, right->_priority);
+
+        return std::make_shared<const Strazzle::Rope::Node>(left, Strazzle::Rope::MakeLeaf(str + off, chunk), 0, chunk, right, priority);
+    }
+
+    /**
+     * @brief Inserts into the piece containing i by creating a new leaf, only done if the result fits into a leaf
+     * @return The new root or nullptr if the piece has no room
+     */
+    static NodePtr InsertLocal(const NodePtr& node, std::size_t i, const char* str, std::size_t size) {
+        if(!node) return nullptr;
+
+        std::size_t left_len = Strazzle::Rope::Len(node->_left);
+
+        if(i < left_len) {
+            NodePtr left = Strazzle::Rope::InsertLocal(node->_left, i, str, size);
+
+            return left ? Strazzle::Rope::WithChildren(node, std::move(left), node->_right) : nullptr;
+        }
+
+        if(i > left_len + node->_size) {
+            NodePtr right = Strazzle::Rope::InsertLocal(node->_right, i - left_len - node->_size, str, size);
+
+            return right ? Strazzle::Rope::WithChildren(node, node->_left, std::move(right)) : nullptr;
+        }
+
+        if(node->_size + size >= Strazzle::ROPE_LEAF_SIZE) return nullptr;
+
+        std::size_t off = i - left_len;
+
+        auto leaf = std::make_shared<Strazzle::String>();
+
+        leaf->AppendRaw(node->Data(), off);
+        leaf->AppendRaw(str, size);
+        leaf->AppendRaw(node->Data() + off, node->_size - off);
+
+        return std::make_shared<const Strazzle::Rope::Node>(node->_left, std::move(leaf), 0, node->_size + size, node->_right, node->_priority);
+    }
+
+    /**
+     * @brief Splits a subtree into the first i chars and the rest, a piece containing i is split without copying
+     * @return The roots of both parts
+     */
+    static std::pair<NodePtr, NodePtr> Split(const NodePtr& node, std::size_t i) {
+        if(!node) return {nullptr, nullptr};
+
+        std::size_t left_len = Strazzle::Rope::Len(node->_left);
+
+        if(i <= left_len) {
+            auto [left, right] = Strazzle::Rope::Split(node->_left, i);
+
+            // right may start with a split off piece that has a higher priority than node, so it is merged instead of attached
+            return {std::move(left), Strazzle::Rope::Merge(right, Strazzle::Rope::WithChildren(node, nullptr, node->_right))};
+        }
+
+        if(i >= left_len + node->_size) {
+            auto [left, right] = Strazzle::Rope::Split(node->_right, i - left_len - node->_size);
+
+            return {Strazzle::Rope::WithChildren(node, node->_left, std::move(left)), std::move(right)};
+        }
+
+        std::size_t off = i - left_len;
+
+        // The second half gets a new priority, reusing the old one would degrade repeated splits in one place into a list
+        NodePtr second = std::make_shared<const Strazzle::Rope::Node>(
+            nullptr, node->_leaf, node->_off + off, node->_size - off, nullptr, Strazzle::_RopePriority());
+
+        return {
+            std::make_shared<const Strazzle::Rope::Node>(node->_left, node->_leaf, node->_off, off, nullptr, node->_priority),
+            Strazzle::Rope::Merge(second, node->_right),
+        };
+    }
+
+    /**
+     * @brief Concatenates two subtrees
+     * @return The root of the result
+     */
+    static NodePtr Merge(const NodePtr& left, const NodePtr& right) {
+        if(!left) return right;
+        if(!right) return left;
+
+        if(left->_priority >= right->_priority) {
+            return Strazzle::Rope::WithChildren(left, left->_left, Strazzle::Rope::Merge(left->_right, right));
+        }
+
+        return Strazzle::Rope::WithChildren(right, Strazzle::Rope::Merge(left, right->_left), right->_right);
+    }
+
+    /**
+     * @brief Returns the subtree of the range [i, i + size)
+     */
+    static NodePtr Slice(const NodePtr& node, std::size_t i, std::size_t size) {
+        auto [left, rest]  = Strazzle::Rope::Split(node, i);
+        auto [mid, right] = Strazzle::Rope::Split(rest, size);
+
+        return mid;
+    }
+
+    /**
+     * @brief Calls fn for every chunk of the range [i, i + size) of a subtree
+     */
+    template<typename Fn>
+    static void VisitRange(const NodePtr& node, std::size_t i, std::size_t size, Fn&& fn) {
+        if(!node || size == 0) return;
+
+        std::size_t left_len = Strazzle::Rope::Len(node->_left);
+
+        if(i < left_len) {
+            std::size_t n = std::min(size, left_len - i);
+
+            Strazzle::Rope::VisitRange(node->_left, i, n, fn);
+
+            i    = i + n;
+            size = size - n;
+        }
+
+        if(size == 0) return;
+
+        std::size_t off = i - left_len;
+
+        if(off < node->_size) {
+            std::size_t n = std::min(size, node->_size - off);
+
+            fn(node->Data() + off, n);
+
+            off  = off + n;
+            size = size - n;
+        }
+
+        Strazzle::Rope::VisitRange(node->_right, off - node->_size, size, fn);
+    }
+
+    /**
+     * @brief Copies the range [i, i + size) of a subtree into a contiguous string
+     */
+    static Strazzle::String Flatten(const NodePtr& node, std::size_t i, std::size_t size) {
+        Strazzle::String str;
+
+        str.ResizeAllocation(size + 1);
+
+        char*       data = str.Buffer();
+        std::size_t len  = 0;
+
+        Strazzle::Rope::VisitRange(node, i, size, [data, &len](const char* chunk, std::size_t chunk_size) {
+            std::memcpy(data + len, chunk, chunk_size);
+
+            len = len + chunk_size;
+        });
+
+        str.SetLen(len);
+
+        data[len] = '\0';
+
+        return str;
+    }
+};
+
+} // namespace Strazzle
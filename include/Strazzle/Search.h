@@ -0,0 +1,713 @@
+#pragma once
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+    #define STRAZZLE_SEARCH_X86
+    #include <immintrin.h>
+#endif
+
+namespace Strazzle {
+// Returned by the search functions if nothing was found
+const std::size_t NPOS = SIZE_MAX;
+
+/**
+ * @brief Search kernels of one instruction set, str/size is the haystack and needle/needle_size the needle
+ *        The substr kernels expect 2 <= needle_size <= size
+ */
+struct _SearchKernels {
+    std::size_t (*find_char)(const char* str, std::size_t size, char c);
+    std::size_t (*rfind_char)(const char* str, std::size_t size, char c);
+    std::size_t (*count_char)(const char* str, std::size_t size, char c);
+    std::size_t (*find)(const char* str, std::size_t size, const char* needle, std::size_t needle_size);
+    std::size_t (*rfind)(const char* str, std::size_t size, const char* needle, std::size_t needle_size);
+    std::size_t (*find_any)(const char* str, std::size_t size, const char* set, std::size_t set_size);
+    std::size_t (*mismatch)(const char* a, const char* b, std::size_t size);
+};
+
+// Maximum number of chars the find_any kernels search for at once
+const std::size_t FIND_ANY_MAX = 8;
+
+// Scalar kernels, used when no vector instruction set is available and for the tails of the vector kernels
+
+inline std::size_t _FindCharScalar(const char* str, std::size_t size, char c) {
+    for(std::size_t i = 0; i < size; i++) {
+        if(str[i] == c) return i;
+    }
+
+    return Strazzle::NPOS;
+}
+
+inline std::size_t _RFindCharScalar(const char* str, std::size_t size, char c) {
+    for(std::size_t i = size; i > 0; i--) {
+        if(str[i - 1] == c) return i - 1;
+    }
+
+    return Strazzle::NPOS;
+}
+
+inline std::size_t _CountCharScalar(const char* str, std::size_t size, char c) {
+    std::size_t count = 0;
+
+    for(std::size_t i = 0; i < size; i++) {
+        count = count + (str[i] == c);
+    }
+
+    return count;
+}
+
+inline std::size_t _FindScalar(const char* str, std::size_t size, const char* needle, std::size_t needle_size) {
+    for(std::size_t i = 0; i + needle_size <= size; i++) {
+        if(str[i] == needle[0] && std::memcmp(str + i + 1, needle + 1, needle_size - 1) == 0) return i;
+    }
+
+    return Strazzle::NPOS;
+}
+
+inline std::size_t _RFindScalar(const char* str, std::size_t size, const char* needle, std::size_t needle_size) {
+    for(std::size_t i = size - needle_size + 1; i > 0; i--) {
+        if(str[i - 1] == needle[0] && std::memcmp(str + i, needle + 1, needle_size - 1) == 0) return i - 1;
+    }
+
+    return Strazzle::NPOS;
+}
+
+inline std::size_t _FindAnyScalar(const char* str, std::size_t size, const char* set, std::size_t set_size) {
+    for(std::size_t i = 0; i < size; i++) {
+        for(std::size_t j = 0; j < set_size; j++) {
+            if(str[i] == set[j]) return i;
+        }
+    }
+
+    return Strazzle::NPOS;
+}
+
+inline std::size_t _MismatchScalar(const char* a, const char* b, std::size_t size) {
+    for(std::size_t i = 0; i < size; i++) {
+        if(a[i] != b[i]) return i;
+    }
+
+    return size;
+}
+
+#ifdef STRAZZLE_SEARCH_X86
+// The substr kernels compare the first and the last char of the needle against two shifted loads of the haystack
+// and only memcmp the positions where both match (Mula, "SIMD-friendly algorithms for substring searching")
+
+// SSE2, 16 bytes per step
+
+__attribute__((target("sse2"))) inline std::size_t _FindCharSse2(const char* str, std::size_t size, char c) {
+    const __m128i target = _mm_set1_epi8(c);
+
+    std::size_t i = 0;
+
+    for(; i + 16 <= size; i += 16) {
+        uint32_t mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(str + i)), target));
+
+        if(mask != 0) return i + __builtin_ctz(mask);
+    }
+
+    std::size_t found = Strazzle::_FindCharScalar(str + i, size - i, c);
+
+    return found != Strazzle::NPOS ? i + found : Strazzle::NPOS;
+}
+
+__attribute__((target("sse2"))) inline std::size_t _RFindCharSse2(const char* str, std::size_t size, char c) {
+    const __m128i target = _mm_set1_epi8(c);
+
+    std::size_t end = size;
+
+    for(; end >= 16; end -= 16) {
+        uint32_t mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(str + end - 16)), target));
+
+        if(mask != 0) return end - 16 + (31 - __builtin_clz(mask));
+    }
+
+    return Strazzle::_RFindCharScalar(str, end, c);
+}
+
+__attribute__((target("sse2"))) inline std::size_t _CountCharSse2(const char* str, std::size_t size, char c) {
+    const __m128i target = _mm_set1_epi8(c);
+
+    std::size_t count = 0;
+    std::size_t i     = 0;
+
+    for(; i + 16 <= size; i += 16) {
+        uint32_t mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(str + i)), target));
+
+        count = count + __builtin_popcount(mask);
+    }
+
+    return count + Strazzle::_CountCharScalar(str + i, size - i, c);
+}
+
+__attribute__((target("sse2"))) inline std::size_t _FindSse2(const char* str, std::size_t size, const char* needle, std::size_t needle_size) {
+    const __m128i first = _mm_set1_epi8(needle[0]);
+    const __m128i last  = _mm_set1_epi8(needle[needle_size - 1]);
+
+    std::size_t i = 0;
+
+    for(; i + needle_size - 1 + 16 <= size; i += 16) {
+        __m128i block_first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + i));
+        __m128i block_last  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + i + needle_size - 1));
+
+        uint32_t mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(block_first, first), _mm_cmpeq_epi8(block_last, last)));
+
+        for(; mask != 0; mask = mask & (mask - 1)) {
+            std::size_t pos = i + __builtin_ctz(mask);
+
+            if(std::memcmp(str + pos + 1, needle + 1, needle_size - 2) == 0) return pos;
+        }
+    }
+
+    std::size_t found = Strazzle::_FindScalar(str + i, size - i, needle, needle_size);
+
+    return found != Strazzle::NPOS ? i + found : Strazzle::NPOS;
+}
+
+__attribute__((target("sse2"))) inline std::size_t _RFindSse2(const char* str, std::size_t size, const char* needle, std::size_t needle_size) {
+    const __m128i first = _mm_set1_epi8(needle[0]);
+    const __m128i last  = _mm_set1_epi8(needle[needle_size - 1]);
+
+    // End of the remaining candidate start positions
+    std::size_t end = size - needle_size + 1;
+
+    for(; end >= 16; end -= 16) {
+        __m128i block_first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + end - 16));
+        __m128i block_last  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + end - 16 + needle_size - 1));
+
+        uint32_t mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(block_first, first), _mm_cmpeq_epi8(block_last, last)));
+
+        while(mask != 0) {
+            uint32_t bit = 31 - __builtin_clz(mask);
+
+            if(std::memcmp(str + end - 16 + bit + 1, needle + 1, needle_size - 2) == 0) return end - 16 + bit;
+
+            mask = mask & ~(1U << bit);
+        }
+    }
+
+    return end != 0 ? Strazzle::_RFindScalar(str, end + needle_size - 1, needle, needle_size) : Strazzle::NPOS;
+}
+
+__attribute__((target("sse2"))) inline std::size_t _FindAnySse2(const char* str, std::size_t size, const char* set, std::size_t set_size) {
+    __m128i targets[Strazzle::FIND_ANY_MAX];
+
+    for(std::size_t j = 0; j < set_size; j++) {
+        targets[j] = _mm_set1_epi8(set[j]);
+    }
+
+    std::size_t i = 0;
+
+    for(; i + 16 <= size; i += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + i));
+        __m128i hits  = _mm_cmpeq_epi8(block, targets[0]);
+
+        for(std::size_t j = 1; j < set_size; j++) {
+            hits = _mm_or_si128(hits, _mm_cmpeq_epi8(block, targets[j]));
+        }
+
+        uint32_t mask = _mm_movemask_epi8(hits);
+
+        if(mask != 0) return i + __builtin_ctz(mask);
+    }
+
+    std::size_t found = Strazzle::_FindAnyScalar(str + i, size - i, set, set_size);
+
+    return found != Strazzle::NPOS ? i + found : Strazzle::NPOS;
+}
+
+__attribute__((target("sse2"))) inline std::size_t _MismatchSse2(const char* a, const char* b, std::size_t size) {
+    if(size < 16) return Strazzle::_MismatchScalar(a, b, size);
+
+    std::size_t i = 0;
+
+    // Two blocks per step, the loop is bound by the branch on the result otherwise
+    for(; i + 32 <= size; i += 32) {
+        uint32_t mask_0 = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)),
+                                                           _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)))) ^
+                          0xFFFF;
+        uint32_t mask_1 = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i + 16)),
+                                                           _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i + 16)))) ^
+                          0xFFFF;
+
+        if((mask_0 | mask_1) != 0) return mask_0 != 0 ? i + __builtin_ctz(mask_0) : i + 16 + __builtin_ctz(mask_1);
+    }
+
+    // The last block overlaps the one before it instead of falling back to a narrower kernel
+    while(i != size) {
+        i = std::min(i, size - 16);
+
+        uint32_t mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)),
+                                                           _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)))) ^
+                          0xFFFF;
+
+        if(mask != 0) return i + __builtin_ctz(mask);
+
+        i = i + 16;
+    }
+
+    return size;
+}
+
+// AVX2, 32 bytes per step
+
+__attribute__((target("avx2"))) inline std::size_t _FindCharAvx2(const char* str, std::size_t size, char c) {
+    const __m256i target = _mm256_set1_epi8(c);
+
+    std::size_t i = 0;
+
+    for(; i + 32 <= size; i += 32) {
+        uint32_t mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(str + i)), target));
+
+        if(mask != 0) return i + __builtin_ctz(mask);
+    }
+
+    std::size_t found = Strazzle::_FindCharSse2(str + i, size - i, c);
+
+    return found != Strazzle::NPOS ? i + found : Strazzle::NPOS;
+}
+
+__attribute__((target("avx2"))) inline std::size_t _RFindCharAvx2(const char* str, std::size_t size, char c) {
+    const __m256i target = _mm256_set1_epi8(c);
+
+    std::size_t end = size;
+
+    for(; end >= 32; end -= 32) {
+        uint32_t mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(str + end - 32)), target));
+
+        if(mask != 0) return end - 32 + (31 - __builtin_clz(mask));
+    }
+
+    return Strazzle::_RFindCharSse2(str, end, c);
+}
+
+__attribute__((target("avx2"))) inline std::size_t _CountCharAvx2(const char* str, std::size_t size, char c) {
+    const __m256i target = _mm256_set1_epi8(c);
+
+    std::size_t count = 0;
+    std::size_t i     = 0;
+
+    for(; i + 32 <= size; i += 32) {
+        uint32_t mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(str + i)), target));
+
+        count = count + __builtin_popcount(mask);
+    }
+
+    return count + Strazzle::_CountCharSse2(str + i, size - i, c);
+}
+
+__attribute__((target("avx2"))) inline std::size_t _FindAvx2(const char* str, std::size_t size, const char* needle, std::size_t needle_size) {
+    const __m256i first = _mm256_set1_epi8(needle[0]);
+    const __m256i last  = _mm256_set1_epi8(needle[needle_size - 1]);
+
+    std::size_t i = 0;
+
+    for(; i + needle_size - 1 + 32 <= size; i += 32) {
+        __m256i block_first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str + i));
+        __m256i block_last  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str + i + needle_size - 1));
+
+        uint32_t mask = _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(block_first, first), _mm256_cmpeq_epi8(block_last, last)));
+
+        for(; mask != 0; mask = mask & (mask - 1)) {
+            std::size_t pos = i + __builtin_ctz(mask);
+
+            if(std::memcmp(str + pos + 1, needle + 1, needle_size - 2) == 0) return pos;
+        }
+    }
+
+    if(i + needle_size > size) return Strazzle::NPOS;
+
+    std::size_t found = Strazzle::_FindSse2(str + i, size - i, needle, needle_size);
+
+    return found != Strazzle::NPOS ? i + found : Strazzle::NPOS;
+}
+
+__attribute__((target("avx2"))) inline std::size_t _RFindAvx2(const char* str, std::size_t size, const char* needle, std::size_t needle_size) {
+    const __m256i first = _mm256_set1_epi8(needle[0]);
+    const __m256i last  = _mm256_set1_epi8(needle[needle_size - 1]);
+
+    std::size_t end = size - needle_size + 1;
+
+    for(; end >= 32; end -= 32) {
+        __m256i block_first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str + end - 32));
+        __m256i block_last  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str + end - 32 + needle_size - 1));
+
+        uint32_t mask = _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(block_first, first), _mm256_cmpeq_epi8(block_last, last)));
+
+        while(mask != 0) {
+            uint32_t bit = 31 - __builtin_clz(mask);
+
+            if(std::memcmp(str + end - 32 + bit + 1, needle + 1, needle_size - 2) == 0) return end - 32 + bit;
+
+            mask = mask & ~(1U << bit);
+        }
+    }
+
+    return end != 0 ? Strazzle::_RFindSse2(str, end + needle_size - 1, needle, needle_size) : Strazzle::NPOS;
+}
+
+__attribute__((target("avx2"))) inline std::size_t _FindAnyAvx2(const char* str, std::size_t size, const char* set, std::size_t set_size) {
+    __m256i targets[Strazzle::FIND_ANY_MAX];
+
+    for(std::size_t j = 0; j < set_size; j++) {
+        targets[j] = _mm256_set1_epi8(set[j]);
+    }
+
+    std::size_t i = 0;
+
+    for(; i + 32 <= size; i += 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str + i));
+        __m256i hits  = _mm256_cmpeq_epi8(block, targets[0]);
+
+        for(std::size_t j = 1; j < set_size; j++) {
+            hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(block, targets[j]));
+        }
+
+        uint32_t mask = _mm256_movemask_epi8(hits);
+
+        if(mask != 0) return i + __builtin_ctz(mask);
+    }
+
+    std::size_t found = Strazzle::_FindAnySse2(str + i, size - i, set, set_size);
+
+    return found != Strazzle::NPOS ? i + found : Strazzle::NPOS;
+}
+
+__attribute__((target("avx2"))) inline std::size_t _MismatchAvx2(const char* a, const char* b, std::size_t size) {
+    if(size < 32) return Strazzle::_MismatchSse2(a, b, size);
+
+    std::size_t i = 0;
+
+    // Two blocks per step, the loop is bound by the branch on the result otherwise
+    for(; i + 64 <= size; i += 64) {
+        uint32_t mask_0 = ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)),
+                                                                                       _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)))));
+        uint32_t mask_1 = ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i + 32)),
+                                                                                       _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i + 32)))));
+
+        if((mask_0 | mask_1) != 0) return mask_0 != 0 ? i + __builtin_ctz(mask_0) : i + 32 + __builtin_ctz(mask_1);
+    }
+
+    // The last block overlaps the one before it instead of falling back to a narrower kernel
+    while(i != size) {
+        i = std::min(i, size - 32);
+
+        uint32_t mask = ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)),
+                                                                                       _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)))));
+
+        if(mask != 0) return i + __builtin_ctz(mask);
+
+        i = i + 32;
+    }
+
+    return size;
+}
+
+// AVX-512 (BW), 64 bytes per step
+
+__attribute__((target("avx512f,avx512bw"))) inline std::size_t _FindCharAvx512(const char* str, std::size_t size, char c) {
+    const __m512i target = _mm512_set1_epi8(c);
+
+    std::size_t i = 0;
+
+    for(; i + 64 <= size; i += 64) {
+        uint64_t mask = _mm512_cmpeq_epi8_mask(_mm512_loadu_si512(str + i), target);
+
+        if(mask != 0) return i + __builtin_ctzll(mask);
+    }
+
+    std::size_t found = Strazzle::_FindCharAvx2(str + i, size - i, c);
+
+    return found != Strazzle::NPOS ? i + found : Strazzle::NPOS;
+}
+
+__attribute__((target("avx512f,avx512bw"))) inline std::size_t _RFindCharAvx512(const char* str, std::size_t size, char c) {
+    const __m512i target = _mm512_set1_epi8(c);
+
+    std::size_t end = size;
+
+    for(; end >= 64; end -= 64) {
+        uint64_t mask = _mm512_cmpeq_epi8_mask(_mm512_loadu_si512(str + end - 64), target);
+
+        if(mask != 0) return end - 64 + (63 - __builtin_clzll(mask));
+    }
+
+    return Strazzle::_RFindCharAvx2(str, end, c);
+}
+
+__attribute__((target("avx512f,avx512bw"))) inline std::size_t _CountCharAvx512(const char* str, std::size_t size, char c) {
+    const __m512i target = _mm512_set1_epi8(c);
+
+    std::size_t count = 0;
+    std::size_t i     = 0;
+
+    for(; i + 64 <= size; i += 64) {
+        count = count + __builtin_popcountll(_mm512_cmpeq_epi8_mask(_mm512_loadu_si512(str + i), target));
+    }
+
+    return count + Strazzle::_CountCharAvx2(str + i, size - i, c);
+}
+
+__attribute__((target("avx512f,avx512bw"))) inline std::size_t _FindAvx512(const char* str, std::size_t size, const char* needle, std::size_t needle_size) {
+    const __m512i first = _mm512_set1_epi8(needle[0]);
+    const __m512i last  = _mm512_set1_epi8(needle[needle_size - 1]);
+
+    std::size_t i = 0;
+
+    for(; i + needle_size - 1 + 64 <= size; i += 64) {
+        uint64_t mask = _mm512_cmpeq_epi8_mask(_mm512_loadu_si512(str + i), first) &
+                        _mm512_cmpeq_epi8_mask(_mm512_loadu_si512(str + i + needle_size - 1), last);
+
+        for(; mask != 0; mask = mask & (mask - 1)) {
+            std::size_t pos = i + __builtin_ctzll(mask);
+
+            if(std::memcmp(str + pos + 1, needle + 1, needle_size - 2) == 0) return pos;
+        }
+    }
+
+    if(i + needle_size > size) return Strazzle::NPOS;
+
+    std::size_t found = Strazzle::_FindAvx2(str + i, size - i, needle, needle_size);
+
+    return found != Strazzle::NPOS ? i + found : Strazzle::NPOS;
+}
+
+__attribute__((target("avx512f,avx512bw"))) inline std::size_t _RFindAvx512(const char* str, std::size_t size, const char* needle, std::size_t needle_size) {
+    const __m512i first = _mm512_set1_epi8(needle[0]);
+    const __m512i last  = _mm512_set1_epi8(needle[needle_size - 1]);
+
+    std::size_t end = size - needle_size + 1;
+
+    for(; end >= 64; end -= 64) {
+        uint64_t mask = _mm512_cmpeq_epi8_mask(_mm512_loadu_si512(str + end - 64), first) &
+                        _mm512_cmpeq_epi8_mask(_mm512_loadu_si512(str + end - 64 + needle_size - 1), last);
+
+        while(mask != 0) {
+            uint32_t bit = 63 - __builtin_clzll(mask);
+
+            if(std::memcmp(str + end - 64 + bit + 1, needle + 1, needle_size - 2) == 0) return end - 64 + bit;
+
+            mask = mask & ~(1ULL << bit);
+        }
+    }
+
+    return end != 0 ? Strazzle::_RFindAvx2(str, end + needle_size - 1, needle, needle_size) : Strazzle::NPOS;
+}
+__attribute__((target("avx512f,avx512bw"))) inline std::size_t _FindAnyAvx512(const char* str, std::size_t size, const char* set, std::size_t set_size) {
+    __m512i targets[Strazzle::FIND_ANY_MAX];
+
+    for(std::size_t j = 0; j < set_size; j++) {
+        targets[j] = _mm512_set1_epi8(set[j]);
+    }
+
+    std::size_t i = 0;
+
+    for(; i + 64 <= size; i += 64) {
+        __m512i block = _mm512_loadu_si512(str + i);
+
+        uint64_t mask = 0;
+
+        for(std::size_t j = 0; j < set_size; j++) {
+            mask = mask | _mm512_cmpeq_epi8_mask(block, targets[j]);
+        }
+
+        if(mask != 0) return i + __builtin_ctzll(mask);
+    }
+
+    std::size_t found = Strazzle::_FindAnyAvx2(str + i, size - i, set, set_size);
+
+    return found != Strazzle::NPOS ? i + found : Strazzle::NPOS;
+}
+__attribute__((target("avx512f,avx512bw"))) inline std::size_t _MismatchAvx512(const char* a, const char* b, std::size_t size) {
+    if(size < 64) return Strazzle::_MismatchAvx2(a, b, size);
+
+    std::size_t i = 0;
+
+    // Two blocks per step, the loop is bound by the branch on the result otherwise
+    for(; i + 128 <= size; i += 128) {
+        uint64_t mask_0 = _mm512_cmpneq_epi8_mask(_mm512_loadu_si512(a + i), _mm512_loadu_si512(b + i));
+        uint64_t mask_1 = _mm512_cmpneq_epi8_mask(_mm512_loadu_si512(a + i + 64), _mm512_loadu_si512(b + i + 64));
+
+        if((mask_0 | mask_1) != 0) return mask_0 != 0 ? i + __builtin_ctzll(mask_0) : i + 64 + __builtin_ctzll(mask_1);
+    }
+
+    // The last block overlaps the one before it instead of falling back to a narrower kernel
+    while(i != size) {
+        i = std::min(i, size - 64);
+
+        uint64_t mask = _mm512_cmpneq_epi8_mask(_mm512_loadu_si512(a + i), _mm512_loadu_si512(b + i));
+
+        if(mask != 0) return i + __builtin_ctzll(mask);
+
+        i = i + 64;
+    }
+
+    return size;
+}
+#endif
+
+/**
+ * @brief Picks the kernels of the best instruction set the cpu supports (cpuid)
+ * @return The kernels
+ */
+inline Strazzle::_SearchKernels _SelectSearchKernels() {
+#ifdef STRAZZLE_SEARCH_X86
+    __builtin_cpu_init();
+
+    if(__builtin_cpu_supports("avx512bw")) {
+        return {Strazzle::_FindCharAvx512, Strazzle::_RFindCharAvx512, Strazzle::_CountCharAvx512, Strazzle::_FindAvx512, Strazzle::_RFindAvx512,
+                Strazzle::_FindAnyAvx512, Strazzle::_MismatchAvx512};
+    }
+
+    if(__builtin_cpu_supports("avx2")) {
+        return {Strazzle::_FindCharAvx2, Strazzle::_RFindCharAvx2, Strazzle::_CountCharAvx2, Strazzle::_FindAvx2, Strazzle::_RFindAvx2,
+                Strazzle::_FindAnyAvx2, Strazzle::_MismatchAvx2};
+    }
+
+    if(__builtin_cpu_supports("sse2")) {
+        return {Strazzle::_FindCharSse2, Strazzle::_RFindCharSse2, Strazzle::_CountCharSse2, Strazzle::_FindSse2, Strazzle::_RFindSse2,
+                Strazzle::_FindAnySse2, Strazzle::_MismatchSse2};
+    }
+#endif
+
+    return {Strazzle::_FindCharScalar, Strazzle::_RFindCharScalar, Strazzle::_CountCharScalar, Strazzle::_FindScalar, Strazzle::_RFindScalar,
+            Strazzle::_FindAnyScalar, Strazzle::_MismatchScalar};
+}
+
+/**
+ * @brief Get the kernels picked for this cpu, they are selected once
+ */
+inline const Strazzle::_SearchKernels& _GetSearchKernels() {
+    static const Strazzle::_SearchKernels kernels = Strazzle::_SelectSearchKernels();
+
+    return kernels;
+}
+
+/**
+ * @brief Finds the first c in str at or after pos
+ * @return The index or Strazzle::NPOS
+ */
+inline std::size_t _FindChar(const char* str, std::size_t size, char c, std::size_t pos = 0) {
+    if(pos >= size) return Strazzle::NPOS;
+
+    std::size_t found = Strazzle::_GetSearchKernels().find_char(str + pos, size - pos, c);
+
+    return found != Strazzle::NPOS ? pos + found : Strazzle::NPOS;
+}
+
+/**
+ * @brief Finds the last c in str at or before pos
+ * @return The index or Strazzle::NPOS
+ */
+inline std::size_t _RFindChar(const char* str, std::size_t size, char c, std::size_t pos = Strazzle::NPOS) {
+    if(size == 0) return Strazzle::NPOS;
+
+    return Strazzle::_GetSearchKernels().rfind_char(str, std::min(pos, size - 1) + 1, c);
+}
+
+/**
+ * @brief Counts the occurrences of c in str
+ */
+inline std::size_t _CountChar(const char* str, std::size_t size, char c) {
+    return Strazzle::_GetSearchKernels().count_char(str, size, c);
+}
+
+/**
+ * @brief Finds the first char of str at or after pos that is one of the chars of set
+ * @param set The chars to find, at most Strazzle::FIND_ANY_MAX
+ * @return The index or Strazzle::NPOS
+ */
+inline std::size_t _FindAny(const char* str, std::size_t size, const char* set, std::size_t set_size, std::size_t pos = 0) {
+    if(pos >= size || set_size == 0) return Strazzle::NPOS;
+
+    std::size_t found = Strazzle::_GetSearchKernels().find_any(str + pos, size - pos, set, set_size);
+
+    return found != Strazzle::NPOS ? pos + found : Strazzle::NPOS;
+}
+
+/**
+ * @brief Finds the first occurrence of needle in str that starts at or after pos
+ * @return The index or Strazzle::NPOS, an empty needle is found at pos
+ */
+inline std::size_t _Find(const char* str, std::size_t size, const char* needle, std::size_t needle_size, std::size_t pos = 0) {
+    if(pos > size || needle_size > size - pos) return Strazzle::NPOS;
+
+    if(needle_size == 0) return pos;
+
+    if(needle_size == 1) return Strazzle::_FindChar(str, size, needle[0], pos);
+
+    std::size_t found = Strazzle::_GetSearchKernels().find(str + pos, size - pos, needle, needle_size);
+
+    return found != Strazzle::NPOS ? pos + found : Strazzle::NPOS;
+}
+
+/**
+ * @brief Finds the last occurrence of needle in str that starts at or before pos
+ * @return The index or Strazzle::NPOS, an empty needle is found at min(pos, size)
+ */
+inline std::size_t _RFind(const char* str, std::size_t size, const char* needle, std::size_t needle_size, std::size_t pos = Strazzle::NPOS) {
+    if(needle_size > size) return Strazzle::NPOS;
+
+    if(needle_size == 0) return std::min(pos, size);
+
+    if(needle_size == 1) return Strazzle::_RFindChar(str, size, needle[0], pos);
+
+    // Only the haystack up to the end of a match starting at pos matters
+    std::size_t end = std::min(pos, size - needle_size) + needle_size;
+
+    return Strazzle::_GetSearchKernels().rfind(str, end, needle, needle_size);
+}
+
+/**
+ * @brief Checks if a and b are equal, both have size bytes
+ */
+inline bool _Equal(const char* a, const char* b, std::size_t size) {
+    // Short buffers are not worth the indirect call
+    if(size < 16) return std::memcmp(a, b, size) == 0;
+
+    return Strazzle::_GetSearchKernels().mismatch(a, b, size) == size;
+}
+
+/**
+ * @brief Compares a and b lexicographically as unsigned bytes, a prefix is less than the longer string
+ * @return Less than, equal to or greater than 0 like memcmp
+ */
+inline int _Compare(const char* a, std::size_t a_size, const char* b, std::size_t b_size) {
+    std::size_t size = std::min(a_size, b_size);
+
+    if(size < 16) {
+        int result = std::memcmp(a, b, size);
+
+        if(result != 0) return result;
+    } else {
+        std::size_t i = Strazzle::_GetSearchKernels().mismatch(a, b, size);
+
+        if(i != size) return static_cast<int>(static_cast<uint8_t>(a[i])) - static_cast<int>(static_cast<uint8_t>(b[i]));
+    }
+
+    return (a_size > b_size) - (a_size < b_size);
+}
+
+/**
+ * @brief Counts the non overlapping occurrences of needle in str
+ * @return The count, 0 for an empty needle
+ */
+inline std::size_t _Count(const char* str, std::size_t size, const char* needle, std::size_t needle_size) {
+    if(needle_size == 0) return 0;
+
+    if(needle_size == 1) return Strazzle::_CountChar(str, size, needle[0]);
+
+    std::size_t count = 0;
+
+    for(std::size_t pos = Strazzle::_Find(str, size, needle, needle_size); pos != Strazzle::NPOS;
+        pos             = Strazzle::_Find(str, size, needle, needle_size, pos + needle_size)) {
+        count = count + 1;
+    }
+
+    return count;
+}
+
+} // namespace Strazzle
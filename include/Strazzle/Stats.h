@@ -0,0 +1,182 @@
+#pragma once
+
+#include <atomic>
+#include <cinttypes>
+#include <cstddef>
+
+#ifdef STRAZZLE_STATS
+    #include <algorithm>
+    #include <mutex>
+    #include <vector>
+#endif
+
+namespace Strazzle {
+/**
+ * @brief The counters of Strazzle::StringStats, the indices of the per thread counters
+ */
+enum class Stat : uint8_t {
+    ALLOCATIONS    = 0,
+    DEALLOCATIONS  = 1,
+    REALLOCATIONS  = 2,
+    BYTES_COPIED   = 3,
+    BYTES_MOVED    = 4,
+    SMALL_TO_LARGE = 5,
+    LARGE_TO_SMALL = 6,
+    RESERVE_HITS   = 7,
+    COUNT          = 8
+};
+
+/**
+ * @brief Snapshot of what the strings of all threads cost so far, see Strazzle::GetStringStats
+ *        Only counted if STRAZZLE_STATS is defined, it must be defined the same way in every translation unit
+ */
+struct StringStats {
+    // Heap buffers allocated, by ToLarge, by a Realloc without Reallocate and by the copy of a shared copy-on-write buffer
+    std::size_t allocations = 0;
+
+    // Heap buffers freed
+    std::size_t deallocations = 0;
+
+    // Heap buffers grown or shrunk in place by the Reallocate of the allocator
+    std::size_t reallocations = 0;
+
+    // Bytes copied into strings by Append, Insert, Resize with a fill string and EditBatch::Apply, and from one buffer to another by
+    // ToLarge, ToSmall, Realloc and copy-on-write
+    std::size_t bytes_copied = 0;
+
+    // Bytes moved inside a buffer by Insert, Erase and Substr
+    std::size_t bytes_moved = 0;
+
+    // Transitions from SMALL_STRING to LARGE_STRING
+    std::size_t small_to_large = 0;
+
+    // Transitions from LARGE_STRING to SMALL_STRING
+    std::size_t large_to_small = 0;
+
+    // Reallocations that were skipped because the string was reserved to a larger size
+    std::size_t reserve_hits = 0;
+
+    /**
+     * @brief Calls f(name, value) for every counter, eg to export them to a metrics system
+     */
+    template<typename F>
+    void ForEach(F&& f) const {
+        f("allocations", allocations);
+        f("deallocations", deallocations);
+        f("reallocations", reallocations);
+        f("bytes_copied", bytes_copied);
+        f("bytes_moved", bytes_moved);
+        f("small_to_large", small_to_large);
+        f("large_to_small", large_to_small);
+        f("reserve_hits", reserve_hits);
+    }
+};
+
+#ifdef STRAZZLE_STATS
+/**
+ * @brief Counters of one thread, only written by their thread so counting is a plain load and store
+ *        They are atomic so a snapshot may read them from another thread
+ */
+struct _ThreadStats {
+    std::atomic<std::size_t> counters[static_cast<std::size_t>(Strazzle::Stat::COUNT)] = {};
+
+    _ThreadStats();
+
+    ~_ThreadStats();
+};
+
+/**
+ * @brief The counters of all running threads and the sums of the threads that exited
+ */
+struct _StatsRegistry {
+    std::mutex mutex;
+
+    std::vector<Strazzle::_ThreadStats*> threads;
+
+    std::size_t exited[static_cast<std::size_t>(Strazzle::Stat::COUNT)] = {};
+};
+
+/**
+ * @brief Get the registry, it is never destroyed so threads may still exit while static objects are destroyed
+ */
+inline Strazzle::_StatsRegistry& _GetStatsRegistry() {
+    static Strazzle::_StatsRegistry* registry = new Strazzle::_StatsRegistry();
+
+    return *registry;
+}
+
+inline _ThreadStats::_ThreadStats() {
+    Strazzle::_StatsRegistry& registry = Strazzle::_GetStatsRegistry();
+
+    std::lock_guard lock(registry.mutex);
+
+    registry.threads.push_back(this);
+}
+
+inline _ThreadStats::~_ThreadStats() {
+    Strazzle::_StatsRegistry& registry = Strazzle::_GetStatsRegistry();
+
+    std::lock_guard lock(registry.mutex);
+
+    for(std::size_t k = 0; k < static_cast<std::size_t>(Strazzle::Stat::COUNT); k++) {
+        registry.exited[k] = registry.exited[k] + counters[k].load(std::memory_order_relaxed);
+    }
+
+    registry.threads.erase(std::find(registry.threads.begin(), registry.threads.end(), this));
+}
+
+/**
+ * @brief Get the counters of the current thread
+ */
+inline Strazzle::_ThreadStats& _GetThreadStats() {
+    static thread_local Strazzle::_ThreadStats stats;
+
+    return stats;
+}
+#endif
+
+/**
+ * @brief Adds n to a counter of the current thread, does nothing if STRAZZLE_STATS is not defined
+ */
+inline void _CountStat([[maybe_unused]] Strazzle::Stat stat, [[maybe_unused]] std::size_t n = 1) {
+#ifdef STRAZZLE_STATS
+    std::atomic<std::size_t>& counter = Strazzle::_GetThreadStats().counters[static_cast<std::size_t>(stat)];
+
+    counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+#endif
+}
+
+/**
+ * @brief Sums up the counters of all threads, including the ones that exited. All zero if STRAZZLE_STATS is not defined
+ */
+inline Strazzle::StringStats GetStringStats() {
+    std::size_t sums[static_cast<std::size_t>(Strazzle::Stat::COUNT)] = {};
+
+#ifdef STRAZZLE_STATS
+    Strazzle::_StatsRegistry& registry = Strazzle::_GetStatsRegistry();
+
+    std::lock_guard lock(registry.mutex);
+
+    for(std::size_t k = 0; k < static_cast<std::size_t>(Strazzle::Stat::COUNT); k++) {
+        sums[k] = registry.exited[k];
+
+        for(Strazzle::_ThreadStats* thread : registry.threads) {
+            sums[k] = sums[k] + thread->counters[k].load(std::memory_order_relaxed);
+        }
+    }
+#endif
+
+    Strazzle::StringStats stats;
+
+    stats.allocations    = sums[static_cast<std::size_t>(Strazzle::Stat::ALLOCATIONS)];
+    stats.deallocations  = sums[static_cast<std::size_t>(Strazzle::Stat::DEALLOCATIONS)];
+    stats.reallocations  = sums[static_cast<std::size_t>(Strazzle::Stat::REALLOCATIONS)];
+    stats.bytes_copied   = sums[static_cast<std::size_t>(Strazzle::Stat::BYTES_COPIED)];
+    stats.bytes_moved    = sums[static_cast<std::size_t>(Strazzle::Stat::BYTES_MOVED)];
+    stats.small_to_large = sums[static_cast<std::size_t>(Strazzle::Stat::SMALL_TO_LARGE)];
+    stats.large_to_small = sums[static_cast<std::size_t>(Strazzle::Stat::LARGE_TO_SMALL)];
+    stats.reserve_hits   = sums[static_cast<std::size_t>(Strazzle::Stat::RESERVE_HITS)];
+
+    return stats;
+}
+} // namespace Strazzle
@@ -1,10 +1,30 @@
 #pragma once
 
+#include "Strazzle/Hash.h"
+#include "Strazzle/LengthHistogram.h"
+#include "Strazzle/Profiler.h"
+#include "Strazzle/Search.h"
+#include "Strazzle/Stats.h"
+
+#include <algorithm>
+#include <atomic>
 #include <cinttypes>
+#include <compare>
+#include <cstddef>
 #include <cstdio>
 #include <cstdlib>
+#include <concepts>
 #include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#ifdef __linux__
+    #include <sys/mman.h>
+#endif
 
 namespace Strazzle {
 /**
@@ -36,24 +56,203 @@ inline uint8_t _GetExponent(std::size_t x) {
     return ((clz_x != Strazzle::_clz(x - 1)) && (x != 0)) ? (63 - clz_x) : (64 - clz_x);
 }
 
-const std::size_t SSO_SIZE = 16;
+// Default size of the Small String Optimization buffer including the null terminator, see the SSOSize parameter of Strazzle::BasicString
+// A Strazzle::String is exactly this large and holds up to 23 bytes inline
+const std::size_t SSO_SIZE = 24;
+
+// Buffers of at least this size are mapped directly so growing them remaps pages instead of copying them
+const std::size_t MMAP_THRESHOLD = 1UL << 21;
+
+/**
+ * @brief Pointers to C strings, the pointer overloads are templates so the string literal overloads are preferred over them
+ */
+template<typename T>
+concept CStringPointer = std::same_as<T, const char*> || std::same_as<T, char*>;
+
+/**
+ * @brief Byte ranges, ie Strazzle::BasicString and Strazzle::BasicString::Reference (which is not null terminated)
+ */
+template<typename T>
+concept ByteRange = requires(const T& range) {
+    { range.Data() } -> std::same_as<const char*>;
+    { range.Len() } -> std::same_as<std::size_t>;
+};
+
+/**
+ * @brief Get the bytes of a needle of the search and comparison functions, the lengths follow the Append overloads
+ * @return Pointer and length of the needle
+ */
+template<Strazzle::CStringPointer T>
+std::pair<const char*, std::size_t> _Bytes(T str) {
+    return {str, strlen(str)};
+}
+
+template<std::size_t N>
+std::pair<const char*, std::size_t> _Bytes(const char (&str)[N]) {
+    return {str, N - 1};
+}
+
+template<std::size_t N>
+std::pair<const char*, std::size_t> _Bytes(char (&str)[N]) {
+    return {str, strnlen(str, N)};
+}
+
+template<Strazzle::ByteRange Range>
+std::pair<const char*, std::size_t> _Bytes(const Range& range) {
+    return {range.Data(), range.Len()};
+}
+
+/**
+ * @brief Trait for types that can be moved to a new address with memcpy, the source is then dropped without running its destructor
+ *        Trivially copyable types are, other types opt in by specializing it (eg Strazzle::BasicString)
+ */
+template<typename T>
+struct IsTriviallyRelocatable : std::is_trivially_copyable<T> {};
+
+template<typename T>
+concept TriviallyRelocatable = Strazzle::IsTriviallyRelocatable<T>::value;
+
+/**
+ * @brief Moves count objects from src to uninitialized memory at dst and ends the lifetime of the objects at src
+ *        Trivially relocatable types are copied with a single memcpy, the ranges must not overlap
+ */
+template<typename T>
+void _Relocate(T* dst, T* src, std::size_t count) {
+    if constexpr(Strazzle::TriviallyRelocatable<T>) {
+        std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), count * sizeof(T));
+    } else {
+        for(std::size_t i = 0; i < count; i++) {
+            std::construct_at(dst + i, std::move(src[i]));
+            std::destroy_at(src + i);
+        }
+    }
+}
+
+/**
+ * @brief Requirements for the allocator of a Strazzle::BasicString
+ *        Allocate(size) returns a buffer of size bytes, Deallocate(p, size) gets the size the buffer was allocated with
+ */
+template<typename T>
+concept StringAllocator = requires(T allocator, char* p, std::size_t size) {
+    { allocator.Allocate(size) } -> std::same_as<char*>;
+    allocator.Deallocate(p, size);
+};
+
+/**
+ * @brief Allocators that can resize a buffer, possibly in place. Reallocate(p, old_size, new_size) keeps the first
+ *        min(old_size, new_size) bytes and returns the (possibly moved) buffer
+ */
+template<typename T>
+concept ReallocatingAllocator = Strazzle::StringAllocator<T> && requires(T allocator, char* p, std::size_t size) {
+    { allocator.Reallocate(p, size, size) } -> std::same_as<char*>;
+};
+
+/**
+ * @brief Default allocator of Strazzle::BasicString, uses malloc, realloc and free
+ *        On linux buffers of at least Strazzle::MMAP_THRESHOLD bytes are mapped and grown with mremap
+ */
+struct MallocAllocator {
+    char* Allocate(std::size_t size) {
+#ifdef __linux__
+        if(size >= Strazzle::MMAP_THRESHOLD) {
+            void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+            return p != MAP_FAILED ? static_cast<char*>(p) : nullptr;
+        }
+#endif
+
+        return static_cast<char*>(malloc(size));
+    }
+
+    char* Reallocate(char* p, std::size_t old_size, std::size_t new_size) {
+#ifdef __linux__
+        if(old_size >= Strazzle::MMAP_THRESHOLD && new_size >= Strazzle::MMAP_THRESHOLD) {
+            void* new_p = mremap(p, old_size, new_size, MREMAP_MAYMOVE);
+
+            return new_p != MAP_FAILED ? static_cast<char*>(new_p) : nullptr;
+        }
+
+        if(old_size >= Strazzle::MMAP_THRESHOLD || new_size >= Strazzle::MMAP_THRESHOLD) {
+            char* new_p = Strazzle::MallocAllocator::Allocate(new_size);
+
+            std::memcpy(new_p, p, std::min(old_size, new_size));
+
+            Strazzle::MallocAllocator::Deallocate(p, old_size);
+
+            return new_p;
+        }
+#endif
+
+        return static_cast<char*>(realloc(p, new_size));
+    }
+
+    void Deallocate(char* p, std::size_t size) {
+#ifdef __linux__
+        if(size >= Strazzle::MMAP_THRESHOLD) {
+            munmap(p, size);
+            return;
+        }
+#endif
+
+        free(p);
+    }
+};
+
+/**
+ * @brief Allocators whose strings share their heap buffers between copies, see Strazzle::CopyOnWrite
+ */
+template<typename T>
+concept CopyOnWriteAllocator = Strazzle::StringAllocator<T> && requires { requires T::COPY_ON_WRITE; };
+
+/**
+ * @brief Makes the strings of an allocator copy-on-write. Copies of a LARGE_STRING share its heap buffer, which has an atomic reference
+ *        count in front of it, and the first Append, Insert, Erase, Resize or Reserve of a copy makes a private copy of the buffer
+ *        SMALL_STRINGs are still copied. Pays off when large strings are copied far more often than they are modified
+ */
+template<Strazzle::StringAllocator Allocator>
+struct CopyOnWrite : Allocator {
+    using Allocator::Allocator;
+
+    static constexpr bool COPY_ON_WRITE = true;
+};
+
+class Rope;
+
+class EditBatch;
+
+template<std::size_t N>
+class Concat;
 
 /**
  * @brief String class with Small String Optimization (SSO)
  *        Intended for use with "small" strings, "large" strings will be handled in a different class
+ *        The SSO buffer and the heap pointer, length and capacity share the same bytes and the mode lives in the last byte, so with
+ *        the defaults a string is 24 bytes. There is no pointer into the object, strings are trivially relocatable
+ * @tparam Allocator Allocator for the heap buffer, stateful allocators are stored in the string and move along with the buffer
+ * @tparam SSOSize Size of the SSO buffer including the null terminator, strings of up to SSOSize - 1 bytes are never allocated.
+ *         Every byte more is a byte more per object, so pick it from the lengths the string actually holds
  */
-class String {
+template<Strazzle::StringAllocator Allocator = Strazzle::MallocAllocator, std::size_t SSOSize = Strazzle::SSO_SIZE>
+class BasicString {
+    friend Strazzle::Rope;
+    friend Strazzle::EditBatch;
+
   public:
     /**
      * @brief Reference to a String ie a pointer to the base that acts as a substr
+     *        With STRAZZLE_CHECK_REFERENCES every access also checks that the base was not edited under the reference since it was created
+     *        Appending does not invalidate a reference, every other modification does
      */
     struct Reference {
-        friend String;
+        friend BasicString;
 
 #ifndef STRAZZLE_DEBUG_ALL_PUBLIC
       private:
 #endif
-        Reference(Strazzle::String& base, std::size_t i, std::size_t len) : _base(base), _i(i), _len(len) {
+        Reference(BasicString& base, std::size_t i, std::size_t len) : _i(i), _len(len), _base(base) {
+#ifdef STRAZZLE_CHECK_REFERENCES
+            _generation = base._generation;
+#endif
         }
 
 #ifndef STRAZZLE_DEBUG_ALL_PUBLIC
@@ -64,394 +263,1644 @@ class String {
         // Len of substr
         std::size_t _len;
 
-        // The base
-        const Strazzle::String& _base;
+        // The base
+        const BasicString& _base;
+
+#ifdef STRAZZLE_CHECK_REFERENCES
+        // Generation of the base when the reference was created
+        uint32_t _generation;
+#endif
+
+#ifndef STRAZZLE_DEBUG_ALL_PUBLIC
+      private:
+#endif
+        /**
+         * @brief Checks if the reference is still within bounds of the base, and with STRAZZLE_CHECK_REFERENCES that the base was not edited
+         */
+        void CheckBounds() const {
+#ifdef STRAZZLE_CHECK_REFERENCES
+            if(_generation != _base._generation)
+                throw std::logic_error("Base was modified after the reference was created! << Strazzle::BasicString::Reference::CheckBounds()");
+#endif
+            if(_i + _len > _base.Len())
+                throw std::out_of_range("Reference is not within bounds of base! << Strazzle::BasicString::Reference::CheckBounds()");
+        }
+
+#ifndef STRAZZLE_DEBUG_ALL_PUBLIC
+      public:
+#endif
+        /**
+         * @brief Checks if the reference can still be used without throwing, a stale reference is best replaced by a new RefSubstr
+         */
+        bool Valid() const {
+#ifdef STRAZZLE_CHECK_REFERENCES
+            if(_generation != _base._generation) return false;
+#endif
+            return _i + _len <= _base.Len();
+        }
+
+        /**
+         * @brief Get a pointer to the start of the substr, the substr is not null terminated
+         */
+        const char* Data() const {
+            Reference::CheckBounds();
+
+            return _base.Data() + _i;
+        }
+
+        /**
+         * @brief Get the length of the substr
+         */
+        std::size_t Len() const {
+            return _len;
+        }
+
+        /**
+         * @brief Finds the first c in the substr at or after pos
+         * @return The index in the substr or Strazzle::NPOS
+         */
+        std::size_t Find(char c, std::size_t pos = 0) const {
+            Reference::CheckBounds();
+
+            return Strazzle::_FindChar(_base.Data() + _i, _len, c, pos);
+        }
+
+        /**
+         * @brief Finds the first occurrence of needle in the substr that starts at or after pos
+         * @param needle A C string, string literal, char buffer, String or Reference
+         * @return The index in the substr or Strazzle::NPOS
+         */
+        template<typename Needle>
+        std::size_t Find(Needle&& needle, std::size_t pos = 0) const {
+            Reference::CheckBounds();
+
+            auto [str, size] = Strazzle::_Bytes(std::forward<Needle>(needle));
+
+            return Strazzle::_Find(_base.Data() + _i, _len, str, size, pos);
+        }
+
+        /**
+         * @brief Finds the last c in the substr at or before pos
+         * @return The index in the substr or Strazzle::NPOS
+         */
+        std::size_t RFind(char c, std::size_t pos = Strazzle::NPOS) const {
+            Reference::CheckBounds();
+
+            return Strazzle::_RFindChar(_base.Data() + _i, _len, c, pos);
+        }
+
+        /**
+         * @brief Finds the last occurrence of needle in the substr that starts at or before pos
+         * @param needle A C string, string literal, char buffer, String or Reference
+         * @return The index in the substr or Strazzle::NPOS
+         */
+        template<typename Needle>
+        std::size_t RFind(Needle&& needle, std::size_t pos = Strazzle::NPOS) const {
+            Reference::CheckBounds();
+
+            auto [str, size] = Strazzle::_Bytes(std::forward<Needle>(needle));
+
+            return Strazzle::_RFind(_base.Data() + _i, _len, str, size, pos);
+        }
+
+        /**
+         * @brief Checks if the substr contains c or needle
+         */
+        template<typename Needle>
+        bool Contains(Needle&& needle) const {
+            return Reference::Find(std::forward<Needle>(needle)) != Strazzle::NPOS;
+        }
+
+        /**
+         * @brief Counts the occurrences of c in the substr
+         */
+        std::size_t Count(char c) const {
+            Reference::CheckBounds();
+
+            return Strazzle::_CountChar(_base.Data() + _i, _len, c);
+        }
+
+        /**
+         * @brief Counts the non overlapping occurrences of needle in the substr, an empty needle is counted 0 times
+         */
+        template<typename Needle>
+        std::size_t Count(Needle&& needle) const {
+            Reference::CheckBounds();
+
+            auto [str, size] = Strazzle::_Bytes(std::forward<Needle>(needle));
+
+            return Strazzle::_Count(_base.Data() + _i, _len, str, size);
+        }
+
+        /**
+         * @brief Hashes the bytes of the substr, the hash equals the one of a String with the same bytes
+         */
+        std::size_t Hash() const {
+            return Strazzle::_Hash(Reference::Data(), _len);
+        }
+
+        /**
+         * @brief Three way comparison of the bytes of the substr with other
+         * @param other A C string, string literal, char buffer, String or Reference
+         * @return Less than, equal to or greater than 0 like memcmp
+         */
+        template<typename Other>
+        int Compare(Other&& other) const {
+            auto [str, size] = Strazzle::_Bytes(std::forward<Other>(other));
+
+            return Strazzle::_Compare(Reference::Data(), _len, str, size);
+        }
+
+        /**
+         * @brief Equality, substrs of different length are rejected without looking at their bytes
+         *        Strings and References are taken by const reference so the reversed candidates of C++20 don't make a == b ambiguous
+         */
+        template<Strazzle::ByteRange Other>
+        bool operator==(const Other& other) const {
+            return _len == other.Len() && Strazzle::_Equal(Reference::Data(), other.Data(), _len);
+        }
+
+        template<typename Other>
+            requires(!Strazzle::ByteRange<std::remove_cvref_t<Other>>)
+        bool operator==(Other&& other) const {
+            auto [str, size] = Strazzle::_Bytes(std::forward<Other>(other));
+
+            return _len == size && Strazzle::_Equal(Reference::Data(), str, size);
+        }
+
+        template<Strazzle::ByteRange Other>
+        std::strong_ordering operator<=>(const Other& other) const {
+            return Reference::Compare(other) <=> 0;
+        }
+
+        template<typename Other>
+            requires(!Strazzle::ByteRange<std::remove_cvref_t<Other>>)
+        std::strong_ordering operator<=>(Other&& other) const {
+            return Reference::Compare(std::forward<Other>(other)) <=> 0;
+        }
+    };
+
+#ifndef STRAZZLE_DEBUG_ALL_PUBLIC
+  public:
+#endif
+    BasicString(const Allocator& allocator = Allocator()) : _allocator(allocator) {
+        BasicString::InitSmall();
+    }
+
+    STRAZZLE_ENTRY_POINT BasicString(const char* str, std::size_t size = SIZE_MAX, const Allocator& allocator = Allocator()) : _allocator(allocator) {
+        Strazzle::_CallerScope caller(__builtin_return_address(0));
+
+        BasicString::InitSmall();
+        BasicString::Append(str, size);
+    }
+
+    /**
+     * @brief Copy constructor, the copy uses the allocator of str. A full copy of a copy-on-write LARGE_STRING shares its buffer
+     */
+    STRAZZLE_ENTRY_POINT BasicString(const BasicString& str, std::size_t size = SIZE_MAX) : _allocator(str._allocator) {
+        Strazzle::_CallerScope caller(__builtin_return_address(0));
+
+        size = std::min(str.Len(), size);
+
+        if constexpr(Strazzle::CopyOnWriteAllocator<Allocator>) {
+            if(str.GetMode() == BasicString::Mode::LARGE_STRING && size == str.Len()) {
+                BasicString::Share(str);
+                return;
+            }
+        }
+
+        BasicString::InitSmall();
+        BasicString::AppendRaw(str.Data(), size);
+    }
+
+    STRAZZLE_ENTRY_POINT BasicString(const BasicString::Reference& ref, std::size_t size = SIZE_MAX, const Allocator& allocator = Allocator()) :
+        _allocator(allocator) {
+        Strazzle::_CallerScope caller(__builtin_return_address(0));
+
+        BasicString::InitSmall();
+        BasicString::Append(ref, size);
+    }
+
+    /**
+     * @brief Copies the bytes of any byte range, eg a Strazzle::InplaceString or a string with another SSO size
+     */
+    template<Strazzle::ByteRange Range>
+    STRAZZLE_ENTRY_POINT explicit BasicString(const Range& range, std::size_t size = SIZE_MAX, const Allocator& allocator = Allocator()) :
+        _allocator(allocator) {
+        Strazzle::_CallerScope caller(__builtin_return_address(0));
+
+        BasicString::InitSmall();
+        BasicString::Append(range, size);
+    }
+
+    /**
+     * @brief Move constructor, steals the heap buffer and the allocator of str in O(1). str is left empty
+     */
+    BasicString(BasicString&& str) noexcept : _allocator(str._allocator) {
+        BasicString::Steal(str);
+    }
+
+    ~BasicString() {
+        Strazzle::_CountLength(BasicString::Len());
+
+        BasicString::Free();
+    }
+
+    /**
+     * @brief Copy assignment, reuses the current buffer if possible. A copy-on-write LARGE_STRING is shared instead
+     */
+    STRAZZLE_ENTRY_POINT BasicString& operator=(const BasicString& str) {
+        Strazzle::_CallerScope caller(__builtin_return_address(0));
+
+        if(this == &str) return *this;
+
+        if constexpr(Strazzle::CopyOnWriteAllocator<Allocator>) {
+            if(str.GetMode() == BasicString::Mode::LARGE_STRING) {
+                BasicString::Free();
+
+                _allocator = str._allocator;
+
+                BasicString::Share(str);
+                BasicString::BumpGeneration();
+
+                return *this;
+            }
+        }
+
+        BasicString::SetLen(0);
+        BasicString::BumpGeneration();
+
+        BasicString::AppendRaw(str.Data(), str.Len());
+
+        return *this;
+    }
+
+    /**
+     * @brief Move assignment, frees the current buffer and steals the heap buffer and the allocator of str in O(1). str is left empty
+     */
+    BasicString& operator=(BasicString&& str) noexcept {
+        if(this == &str) return *this;
+
+        BasicString::Free();
+
+        _allocator = str._allocator;
+
+        BasicString::Steal(str);
+        BasicString::BumpGeneration();
+
+        return *this;
+    }
+
+#ifndef STRAZZLE_DEBUG_ALL_PUBLIC
+  private:
+#endif
+    enum class Mode : uint8_t { NONE = 0, SMALL_STRING = 1, LARGE_STRING = 2 };
+
+    // Set in the last byte of LARGE_STRINGs, SMALL_STRINGs keep their spare capacity there which is always below it
+    static constexpr uint8_t LARGE_FLAG = 0x80;
+
+    // Bytes in front of a heap buffer, the reference count of copy-on-write strings
+    static constexpr std::size_t HEADER_SIZE = Strazzle::CopyOnWriteAllocator<Allocator> ? sizeof(std::atomic<std::size_t>) : 0;
+
+    /**
+     * @brief The heap buffer of a LARGE_STRING, shares its bytes with the SSO buffer
+     */
+    struct Large {
+        // Pointer to the heap buffer
+        char* _data;
+
+        // Length of the string
+        std::size_t _len;
+
+        // Exponent of the heap allocation, which includes the reference count of a copy-on-write string
+        uint8_t _allocated_exp;
+
+        // Exponent that is reserved to
+        // allocated memory will ALWAYS be more or equal to this value
+        uint8_t _reserved_exp;
+
+#ifdef STRAZZLE_LENGTH_HISTOGRAM
+        // Number of times the heap buffer grew to a larger exponent, saturates at UINT8_MAX
+        uint8_t _grows;
+#endif
+    };
+
+    static_assert(offsetof(Large, _reserved_exp) + 1 < SSOSize, "The heap pointer, length and capacity have to fit before the mode byte");
+#ifdef STRAZZLE_LENGTH_HISTOGRAM
+    static_assert(offsetof(Large, _grows) + 1 < SSOSize, "The growth count has to fit before the mode byte");
+#endif
+    static_assert(SSOSize <= BasicString::LARGE_FLAG, "The spare capacity has to fit in the mode byte");
+
+    union {
+        // Small String Optimization buffer, zeroed so the comparison fast path never loads uninitialized bytes
+        // The last byte is the spare capacity (SSOSize - 1 - length) of a SMALL_STRING so it doubles as the null terminator of a
+        // full buffer, and LARGE_FLAG for a LARGE_STRING
+        char _sso_buffer[SSOSize] = {};
+
+        // Heap buffer of a LARGE_STRING
+        Large _large;
+    };
+
+    // Allocator of the heap buffer
+    [[no_unique_address]] Allocator _allocator;
+
+#ifdef STRAZZLE_CACHE_HASH
+    // Hash of the string, 0 if it was not computed since the last modification
+    // Relaxed atomic so Hash() may be called concurrently on a shared string
+    mutable std::atomic<std::size_t> _hash = 0;
+#endif
+
+#ifdef STRAZZLE_CHECK_REFERENCES
+    // Bumped by every modification that moves or overwrites bytes of the string, References compare it to the one they were created at
+    // Not part of the contents, it is neither copied nor stolen
+    uint32_t _generation = 0;
+#endif
+
+#ifndef STRAZZLE_DEBUG_ALL_PUBLIC
+  public:
+#endif
+    /**
+     * @brief Append exactly size bytes of str to the end of the current string. Binary safe, str does not need to be null terminated
+     * @param str The bytes to append.
+     * @param size The number of bytes to append.
+     */
+    STRAZZLE_ENTRY_POINT BasicString& AppendRaw(const char* str, std::size_t size) & {
+        Strazzle::_CallerScope caller(__builtin_return_address(0));
+
+        // str may point into this string, its offset stays valid over the reallocation
+        bool        aliased = BasicString::Owns(str);
+        std::size_t off     = aliased ? str - BasicString::Data() : 0;
+        std::size_t len     = BasicString::Len();
+
+        BasicString::MakeUnique(size + len + 1);
+        BasicString::ResizeAllocation(size + len + 1);
+
+        char* data = BasicString::Buffer();
+
+        if(aliased) str = data + off;
+
+        // ResizeAllocation only keeps a SMALL_STRING if the bytes fit. GCC can't see that and warns (-Wstringop-overflow) about
+        // constant sizes that made the string a LARGE_STRING, so the copy is bounded by the SSO buffer too, which never cuts it short
+        if(BasicString::GetMode() == BasicString::Mode::SMALL_STRING) size = std::min(size, SSOSize - 1 - len);
+
+        std::memcpy(data + len, str, size);
+
+        Strazzle::_CountStat(Strazzle::Stat::BYTES_COPIED, size);
+
+        len = size + len;
+
+        BasicString::SetLen(len);
+
+        data[len] = '\0';
+
+        BasicString::InvalidateHash();
+
+        return *this;
+    }
+
+    /**
+     * @brief Append a string to the end of the current string.
+     * @param str The string to append.
+     * @param size Maximum size to append (default is SIZE_MAX).
+     */
+    template<Strazzle::CStringPointer T>
+    STRAZZLE_ENTRY_POINT BasicString& Append(T str, std::size_t size = SIZE_MAX) & {
+        Strazzle::_CallerScope caller(__builtin_return_address(0));
+
+        size = std::min(strlen(str), size);
+
+        return BasicString::AppendRaw(str, size);
+    }
+
+    /**
+     * @brief String literal version of Append, the length is known from the array type so no strlen is needed
+     * @param str The string literal to append.
+     * @param size Maximum size to append (default is SIZE_MAX).
+     */
+    template<std::size_t N>
+    STRAZZLE_ENTRY_POINT BasicString& Append(const char (&str)[N], std::size_t size = SIZE_MAX) & {
+        Strazzle::_CallerScope caller(__builtin_return_address(0));
+
+        size = std::min(N - 1, size);
+
+        return BasicString::AppendRaw(str, size);
+    }
+
+    /**
+     * @brief Char buffer version of Append, a buffer is not necessarily filled so its length is not taken from the array type
+     * @param str The buffer to append.
+     * @param size Maximum size to append (default is SIZE_MAX).
+     */
+    template<std::size_t N>
+    STRAZZLE_ENTRY_POINT BasicString& Append(char (&str)[N], std::size_t size = SIZE_MAX) & {
+        Strazzle::_CallerScope caller(__builtin_return_address(0));
+
+        size = std::min(strnlen(str, N), size);
+
+        return BasicString::AppendRaw(str, size);
+    }
+
+    /**
+     * @brief String version of Append
+     * @param str The string to append.
+     * @param size Maximum size to append (default is SIZE_MAX).
+     */
+    STRAZZLE_ENTRY_POINT BasicString& Append(const BasicString& str, std::size_t size = SIZE_MAX) & {
+        Strazzle::_CallerScope caller(__builtin_return_address(0));
+
+        size = std::min(str.Len(), size);
+
+        return BasicString::AppendRaw(str.Data(), size);
+    }
+
+    /**
+     * @brief Reference version of Append
+     * @param str The reference to append.
+     * @param size Maximum size to append (default is SIZE_MAX).
+     */
+    STRAZZLE_ENTRY_POINT BasicString& Append(const BasicString::Reference& ref, std::size_t size = SIZE_MAX) & {
+        Strazzle::_CallerScope caller(__builtin_return_address(0));
+
+        ref.CheckBounds();
+
+        size = std::min(ref._len, size);
+
+        return BasicString::AppendRaw(ref._base.Data() + ref._i, size);
+    }
+
+    /**
+     * @brief Byte range version of Append, ie strings with other allocators or SSO sizes and Strazzle::InplaceString
+     * @param range The bytes to append.
+     * @param size Maximum size to append (default is SIZE_MAX).
+     */
+    template<Strazzle::ByteRange Range>
+    STRAZZLE_ENTRY_POINT BasicString& Append(const Range& range, std::size_t size = SIZE_MAX) & {
+        Strazzle::_CallerScope caller(__builtin_return_address(0));
+
+        size = std::min(range.Len(), size);
+
+        return BasicString::AppendRaw(range.Data(), size);
+    }
+
+    /**
+     * @brief Concatenation version of Append, grows the buffer once for all pieces of a + b + ... and copies each piece once
+     * @param concat The pieces to append, they may point into the current string
+     */
+    template<std::size_t N>
+    STRAZZLE_ENTRY_POINT BasicString& Append(const Strazzle::Concat<N>& concat) & {
+        Strazzle::_CallerScope caller(__builtin_return_address(0));
+
+        std::size_t len  = BasicString::Len();
+        std::size_t size = concat._len;
+
+        // Pieces that point into this string are kept as offsets over the reallocation
+        bool        aliased[N];
+        std::size_t off[N];
+
+        for(std::size_t k = 0; k < N; k++) {
+            aliased[k] = BasicString::Owns(concat._data[k]);
+            off[k]     = aliased[k] ? concat._data[k] - BasicString::Data() : 0;
+        }
+
+        BasicString::MakeUnique(size + len + 1);
+        BasicString::ResizeAllocation(size + len + 1);
+
+        char* data = BasicString::Buffer();
+        char* dst  = data + len;
+
+        for(std::size_t k = 0; k < N; k++) {
+            std::memcpy(dst, aliased[k] ? data + off[k] : concat._data[k], concat._lens[k]);
+
+            dst = dst + concat._lens[k];
+        }
+
+        Strazzle::_CountStat(Strazzle::Stat::BYTES_COPIED, size);
+
+        len = size + len;
+
+        BasicString::SetLen(len);
+
+        data[len] = '\0';
+
+        BasicString::InvalidateHash();
+
+        return *this;
+    }
+
+    /**
+     * @brief Rvalue version of Append and AppendRaw, appends into the buffer of the temporary so chains don't allocate again
+     *        The result is moved out by value like std::string::substr() &&, so binding it to a reference doesn't dangle
+     * @param args The arguments of any lvalue version.
+     */
+    template<typename... Args>
+    STRAZZLE_ENTRY_POINT BasicString Append(Args&&... args) && {
+        Strazzle::_CallerScope caller(__builtin_return_address(0));
+
+        BasicString::Append(std::forward<Args>(args)...);
+
+        return std::move(*this);
+    }
+
+    template<typename... Args>
+    STRAZZLE_ENTRY_POINT BasicString AppendRaw(Args&&... args) && {
+        Strazzle::_CallerScope caller(__builtin_return_address(0));
+
+        BasicString::AppendRaw(std::forward<Args>(args)...);
+
+        return std::move(*this);
+    }
+
+    /**
+     * @brief Insert exactly size bytes of str at a specified position. Binary safe, str does not need to be null terminated
+     * @param str The bytes to insert.
+     * @param i The position to insert at.
+     * @param size The number of bytes to insert.
+     */
+    STRAZZLE_ENTRY_POINT void InsertRaw(const char* str, std::size_t i, std::size_t size) {
+        Strazzle::_CallerScope caller(__builtin_return_address(0));
+
+        std::size_t len = BasicString::Len();
+
+        if(i > len) throw std::out_of_range("Index is out of bounds!\n << Strazzle::BasicString::InsertRaw()");
+
+        // str may point into this string, the part behind i gets moved so insert a copy
+        if(BasicString::Owns(str)) {
+            BasicString copy(_allocator);
+
+            copy.AppendRaw(str, size);
+
+            BasicString::InsertRaw(copy.Data(), i, size);
+            return;
+        }
+
+        BasicString::MakeUnique(size + len + 1);
+        BasicString::ResizeAllocation(size + len + 1);
+
+        char* data = BasicString::Buffer();
+
+        std::memmove(data + i + size, data + i, len - i);
+
+        Strazzle::_CountStat(Strazzle::Stat::BYTES_MOVED, len - i);
+
+        std::memcpy(data + i, str, size);
+
+        Strazzle::_CountStat(Strazzle::Stat::BYTES_COPIED, size);
+
+        len = size + len;
+
+        BasicString::SetLen(len);
+
+        data[len] = '\0';
+
+        BasicString::InvalidateHash();
+        BasicString::BumpGeneration();
+    }
+
+    /**
+     * @brief Insert a string at a specified position in the current string.
+     * @param str The string to insert.
+     * @param i The position to insert at.
+     * @param size Maximum size to insert (default is SIZE_MAX).
+     */
+    template<Strazzle::CStringPointer T>
+    STRAZZLE_ENTRY_POINT void Insert(T str, std::size_t i, std::size_t size = SIZE_MAX) {
+        Strazzle::_CallerScope caller(__builtin_return_address(0));
+
+        size = std::min(strlen(str), size);
+
+        BasicString::InsertRaw(str, i, size);
+    }
+
+    /**
+     * @brief String literal version of Insert, the length is known from the array type so no strlen is needed
+     * @param str The string literal to insert.
+     * @param i The position to insert at.
+     * @param size Maximum size to insert (default is SIZE_MAX).
+     */
+    template<std::size_t N>
+    STRAZZLE_ENTRY_POINT void Insert(const char (&str)[N], std::size_t i, std::size_t size = SIZE_MAX) {
+        Strazzle::_CallerScope caller(__builtin_return_address(0));
+
+        size = std::min(N - 1, size);
+
+        BasicString::InsertRaw(str, i, size);
+    }
+
+    /**
+     * @brief Char buffer version of Insert, a buffer is not necessarily filled so its length is not taken from the array type
+     * @param str The buffer to insert.
+     * @param i The position to insert at.
+     * @param size Maximum size to insert (default is SIZE_MAX).
+     */
+    template<std::size_t N>
+    STRAZZLE_ENTRY_POINT void Insert(char (&str)[N], std::size_t i, std::size_t size = SIZE_MAX) {
+        Strazzle::_CallerScope caller(__builtin_return_address(0));
+
+        size = std::min(strnlen(str, N), size);
+
+        BasicString::InsertRaw(str, i, size);
+    }
+
+    /**
+     * @brief String version of Insert
+     * @param str The string to insert.
+     * @param i The position to insert at.
+     * @param size Maximum size to insert (default is SIZE_MAX).
+     */
+    STRAZZLE_ENTRY_POINT void Insert(const BasicString& str, std::size_t i, std::size_t size = SIZE_MAX) {
+        Strazzle::_CallerScope caller(__builtin_return_address(0));
+
+        size = std::min(str.Len(), size);
+
+        BasicString::InsertRaw(str.Data(), i, size);
+    }
+
+    /**
+     * @brief Reference version of Insert
+     * @param ref The reference to insert.
+     * @param i The position to insert at.
+     * @param size Maximum size to insert (default is SIZE_MAX).
+     */
+    STRAZZLE_ENTRY_POINT void Insert(const BasicString::Reference& ref, std::size_t i, std::size_t size = SIZE_MAX) {
+        Strazzle::_CallerScope caller(__builtin_return_address(0));
+
+        ref.CheckBounds();
+
+        size = std::min(ref._len, size);
+
+        BasicString::InsertRaw(ref._base.Data() + ref._i, i, size);
+    }
+
+    /**
+     * @brief Byte range version of Insert, ie strings with other allocators or SSO sizes and Strazzle::InplaceString
+     * @param range The bytes to insert.
+     * @param i The position to insert at.
+     * @param size Maximum size to insert (default is SIZE_MAX).
+     */
+    template<Strazzle::ByteRange Range>
+    STRAZZLE_ENTRY_POINT void Insert(const Range& range, std::size_t i, std::size_t size = SIZE_MAX) {
+        Strazzle::_CallerScope caller(__builtin_return_address(0));
+
+        size = std::min(range.Len(), size);
+
+        BasicString::InsertRaw(range.Data(), i, size);
+    }
+
+    /**
+     * @brief Erase a portion of the string starting from a specified position.
+     * @param i The starting position for erasing.
+     * @param size Maximum size to erase (default is SIZE_MAX).
+     */
+    STRAZZLE_ENTRY_POINT void Erase(std::size_t i, std::size_t size = SIZE_MAX) {
+        Strazzle::_CallerScope caller(__builtin_return_address(0));
+
+        std::size_t len = BasicString::Len();
+
+        if(i >= len) throw std::out_of_range("Index is out of bounds!\n << Strazzle::BasicString::Erase()");
+
+        size = std::min(len - i, size);
+
+        BasicString::MakeUnique();
+
+        char* data = BasicString::Buffer();
+
+        std::memmove(data + i, data + i + size, len - i - size);
+
+        Strazzle::_CountStat(Strazzle::Stat::BYTES_MOVED, len - i - size);
+
+        len = len - size;
+
+        BasicString::SetLen(len);
+
+        BasicString::ResizeAllocation(len + 1);
+
+        BasicString::Buffer()[len] = '\0';
+
+        BasicString::InvalidateHash();
+        BasicString::BumpGeneration();
+    }
+
+    /**
+     * @brief Resize the string to a specified size, filling with a character.
+     * @param size The new size of the string.
+     * @param fill The character to fill with (default is a space).
+     */
+    STRAZZLE_ENTRY_POINT void Resize(std::size_t size, char fill = ' ') {
+        Strazzle::_CallerScope caller(__builtin_return_address(0));
+
+        BasicString::MakeUnique(size + 1);
+        BasicString::ResizeAllocation(size + 1);
+
+        std::size_t len  = BasicString::Len();
+        char*       data = BasicString::Buffer();
+
+        if(size > len) {
+            std::memset(data + len, fill, size - len);
+        } else {
+            BasicString::BumpGeneration();
+        }
+
+        BasicString::SetLen(size);
+
+        data[size] = '\0';
+
+        BasicString::InvalidateHash();
+    }
+
+    /**
+     * @brief Resize the string to a specified size, filling with a given string.
+     * @param size The new size of the string.
+     * @param fill The string to fill with, growing with an empty fill throws std::invalid_argument and leaves the string unchanged.
+     */
+    STRAZZLE_ENTRY_POINT void Resize(std::size_t size, const char* fill) {
+        Strazzle::_CallerScope caller(__builtin_return_address(0));
+
+        std::size_t str_len = strlen(fill);
+
+        if(str_len == 0 && size > BasicString::Len()) throw std::invalid_argument("Fill is empty! << Strazzle::BasicString::Resize()\n");
+
+        BasicString::MakeUnique(size + 1);
+        BasicString::ResizeAllocation(size + 1);
+
+        std::size_t len  = BasicString::Len();
+        char*       data = BasicString::Buffer();
+
+        if(size > len) {
+            Strazzle::_CountStat(Strazzle::Stat::BYTES_COPIED, size - len);
+
+            while(len < size) {
+                std::memcpy(data + len, fill, len + str_len <= size ? str_len : size - len);
+                len = std::min(len + str_len, size);
+            }
+        } else {
+            len = size;
+
+            BasicString::BumpGeneration();
+        }
+
+        BasicString::SetLen(len);
+
+        data[len] = '\0';
+
+        BasicString::InvalidateHash();
+    }
+
+    /**
+     * @brief Get a pointer to the C-style string.
+     * @return A pointer to the C-style string.
+     */
+    const char* Cstr() const {
+        return BasicString::Data();
+    }
+
+    /**
+     * @brief Get a pointer to the bytes of the string, same as Cstr
+     */
+    const char* Data() const {
+        return BasicString::GetMode() == BasicString::Mode::SMALL_STRING ? _sso_buffer : _large._data;
+    }
+
+    /**
+     * @brief Get the length of the string.
+     * @return The length of the string.
+     */
+    std::size_t Len() const {
+        if(BasicString::GetMode() == BasicString::Mode::SMALL_STRING) {
+            return SSOSize - 1 - static_cast<uint8_t>(_sso_buffer[SSOSize - 1]);
+        }
+
+        return _large._len;
+    }
+
+    /**
+     * @brief Returns a substr
+     * @param i The starting index
+     * @param size The lenght of the substr
+     */
+    STRAZZLE_ENTRY_POINT BasicString Substr(std::size_t i, std::size_t size = SIZE_MAX) const& {
+        Strazzle::_CallerScope caller(__builtin_return_address(0));
+
+        std::size_t len = BasicString::Len();
+
+        if(i >= len) throw std::out_of_range("Index is out of bounds! << Strazzle::BasicString::Substr()\n");
+
+        size = std::min(len - i, size);
+
+        return BasicString(_allocator).AppendRaw(BasicString::Data() + i, size);
+    }
+
+    /**
+     * @brief Rvalue version of Substr, cuts the substr out of the buffer of the temporary instead of copying it
+     *        The result is moved out by value, see the rvalue Append
+     * @param i The starting index
+     * @param size The lenght of the substr
+     */
+    STRAZZLE_ENTRY_POINT BasicString Substr(std::size_t i, std::size_t size = SIZE_MAX) && {
+        Strazzle::_CallerScope caller(__builtin_return_address(0));
+
+        std::size_t len = BasicString::Len();
+
+        if(i >= len) throw std::out_of_range("Index is out of bounds! << Strazzle::BasicString::Substr()\n");
+
+        size = std::min(len - i, size);
+
+        BasicString::MakeUnique();
+
+        char* data = BasicString::Buffer();
+
+        std::memmove(data, data + i, size);
+
+        Strazzle::_CountStat(Strazzle::Stat::BYTES_MOVED, size);
+
+        BasicString::SetLen(size);
+
+        BasicString::ResizeAllocation(size + 1);
+
+        BasicString::Buffer()[size] = '\0';
+
+        BasicString::InvalidateHash();
+        BasicString::BumpGeneration();
+
+        return std::move(*this);
+    }
+
+    /**
+     * @brief Returns a reference substr
+     * @param i The starting index
+     * @param size The lenght of the substr
+     */
+    BasicString::Reference RefSubstr(std::size_t i, std::size_t size = SIZE_MAX) {
+        std::size_t len = BasicString::Len();
+
+        if(i >= len) throw std::out_of_range("Index is out of bounds! << Strazzle::BasicString::RefSubstr()\n");
+
+        size = std::min(len - i, size);
+
+        return BasicString::Reference(*this, i, size);
+    }
+
+    /**
+     * @brief Reserves to the given size. Reserving means that there will never be less allocated than reserved
+     *        A SMALL_STRING always has SSOSize bytes, so reserving up to that is a no-op
+     * @param size The size to reserve to
+     */
+    STRAZZLE_ENTRY_POINT void Reserve(std::size_t size) {
+        Strazzle::_CallerScope caller(__builtin_return_address(0));
+
+        uint8_t reserved_exp = BasicString::GetBufferExp(size);
+
+        uint8_t cur_exp = BasicString::GetBufferExp(BasicString::Len());
+
+        BasicString::MakeUnique();
+
+        if(cur_exp < reserved_exp) {
+            BasicString::ResizeAllocation(size);
+        }
+
+        if(BasicString::GetMode() == BasicString::Mode::LARGE_STRING) {
+            _large._reserved_exp = reserved_exp;
+        }
+    }
+
+    /**
+     * @brief Finds the first c at or after pos
+     * @param c The char to find
+     * @param pos The index to start at
+     * @return The index or Strazzle::NPOS
+     */
+    std::size_t Find(char c, std::size_t pos = 0) const {
+        return Strazzle::_FindChar(BasicString::Data(), BasicString::Len(), c, pos);
+    }
+
+    /**
+     * @brief Finds the first occurrence of needle that starts at or after pos
+     * @param needle A C string, string literal, char buffer, String or Reference
+     * @param pos The index to start at
+     * @return The index or Strazzle::NPOS, an empty needle is found at pos
+     */
+    template<typename Needle>
+    std::size_t Find(Needle&& needle, std::size_t pos = 0) const {
+        auto [str, size] = Strazzle::_Bytes(std::forward<Needle>(needle));
+
+        return Strazzle::_Find(BasicString::Data(), BasicString::Len(), str, size, pos);
+    }
+
+    /**
+     * @brief Finds the last c at or before pos
+     * @param c The char to find
+     * @param pos The index to start at (default is the end)
+     * @return The index or Strazzle::NPOS
+     */
+    std::size_t RFind(char c, std::size_t pos = Strazzle::NPOS) const {
+        return Strazzle::_RFindChar(BasicString::Data(), BasicString::Len(), c, pos);
+    }
+
+    /**
+     * @brief Finds the last occurrence of needle that starts at or before pos
+     * @param needle A C string, string literal, char buffer, String or Reference
+     * @param pos The index to start at (default is the end)
+     * @return The index or Strazzle::NPOS
+     */
+    template<typename Needle>
+    std::size_t RFind(Needle&& needle, std::size_t pos = Strazzle::NPOS) const {
+        auto [str, size] = Strazzle::_Bytes(std::forward<Needle>(needle));
+
+        return Strazzle::_RFind(BasicString::Data(), BasicString::Len(), str, size, pos);
+    }
+
+    /**
+     * @brief Checks if the string contains c or needle
+     */
+    template<typename Needle>
+    bool Contains(Needle&& needle) const {
+        return BasicString::Find(std::forward<Needle>(needle)) != Strazzle::NPOS;
+    }
+
+    /**
+     * @brief Counts the occurrences of c
+     */
+    std::size_t Count(char c) const {
+        return Strazzle::_CountChar(BasicString::Data(), BasicString::Len(), c);
+    }
+
+    /**
+     * @brief Counts the non overlapping occurrences of needle, an empty needle is counted 0 times
+     * @param needle A C string, string literal, char buffer, String or Reference
+     */
+    template<typename Needle>
+    std::size_t Count(Needle&& needle) const {
+        auto [str, size] = Strazzle::_Bytes(std::forward<Needle>(needle));
+
+        return Strazzle::_Count(BasicString::Data(), BasicString::Len(), str, size);
+    }
+
+    /**
+     * @brief Hashes the bytes of the string, equal strings and References have equal hashes
+     *        With STRAZZLE_CACHE_HASH the hash is computed once and kept until the string is modified
+     * @return The hash
+     */
+    std::size_t Hash() const {
+#ifdef STRAZZLE_CACHE_HASH
+        std::size_t hash = _hash.load(std::memory_order_relaxed);
+
+        if(hash == 0) {
+            hash = Strazzle::_Hash(BasicString::Data(), BasicString::Len());
+
+            _hash.store(hash, std::memory_order_relaxed);
+        }
+
+        return hash;
+#else
+        return Strazzle::_Hash(BasicString::Data(), BasicString::Len());
+#endif
+    }
+
+    /**
+     * @brief Three way comparison of the bytes of the string with other, binary safe
+     * @param other A C string, string literal, char buffer, String or Reference
+     * @return Less than, equal to or greater than 0 like memcmp
+     */
+    int Compare(const BasicString& other) const {
+        if(BasicString::GetMode() == BasicString::Mode::SMALL_STRING && other.GetMode() == BasicString::Mode::SMALL_STRING) {
+            return BasicString::CompareSmall(other);
+        }
+
+        return Strazzle::_Compare(BasicString::Data(), BasicString::Len(), other.Data(), other.Len());
+    }
+
+    template<typename Other>
+        requires(!std::same_as<std::remove_cvref_t<Other>, BasicString>)
+    int Compare(Other&& other) const {
+        auto [str, size] = Strazzle::_Bytes(std::forward<Other>(other));
+
+        return Strazzle::_Compare(BasicString::Data(), BasicString::Len(), str, size);
+    }
+
+    /**
+     * @brief Equality, strings of different length are rejected without looking at their bytes
+     */
+    bool operator==(const BasicString& other) const {
+        std::size_t len = BasicString::Len();
+
+        if(len != other.Len()) return false;
 
-#ifndef STRAZZLE_DEBUG_ALL_PUBLIC
-      private:
+#ifdef STRAZZLE_CACHE_HASH
+        // Strings with different cached hashes differ
+        std::size_t hash       = _hash.load(std::memory_order_relaxed);
+        std::size_t other_hash = other._hash.load(std::memory_order_relaxed);
+
+        if(hash != 0 && other_hash != 0 && hash != other_hash) return false;
 #endif
-        /**
-         * @brief Checks if the reference is still within bounds of the base
-         */
-        void CheckBounds() const {
-            if(_i + _len > _base._len)
-                throw std::out_of_range("Reference is not within bounds of base! << Strazzle::String::Reference::CheckBounds()");
+
+        if(BasicString::GetMode() == BasicString::Mode::SMALL_STRING && other.GetMode() == BasicString::Mode::SMALL_STRING) {
+            return BasicString::CompareSmall(other) == 0;
         }
-    };
 
-#ifndef STRAZZLE_DEBUG_ALL_PUBLIC
-  public:
-#endif
-    String() : _data(_sso_buffer) {
-        _data[0] = 0;
+        return Strazzle::_Equal(BasicString::Data(), other.Data(), len);
+    }
+
+    /**
+     * @brief Equality with strings of other allocators and References, taken by const reference so the reversed candidates of C++20
+     *        don't make a == b ambiguous
+     */
+    template<Strazzle::ByteRange Other>
+    bool operator==(const Other& other) const {
+        std::size_t len = BasicString::Len();
+
+        return len == other.Len() && Strazzle::_Equal(BasicString::Data(), other.Data(), len);
     }
 
-    String(const char* str, std::size_t size = SIZE_MAX) : _data(_sso_buffer) {
-        Strazzle::String::Append(str, size);
+    template<typename Other>
+        requires(!Strazzle::ByteRange<std::remove_cvref_t<Other>>)
+    bool operator==(Other&& other) const {
+        auto [str, size] = Strazzle::_Bytes(std::forward<Other>(other));
+
+        return BasicString::Len() == size && Strazzle::_Equal(BasicString::Data(), str, size);
     }
 
-    String(const Strazzle::String& str, std::size_t size = SIZE_MAX) : _data(_sso_buffer) {
-        size = std::min(str._len, size);
+    std::strong_ordering operator<=>(const BasicString& other) const {
+        return BasicString::Compare(other) <=> 0;
+    }
 
-        Append(str._data, size);
+    template<Strazzle::ByteRange Other>
+    std::strong_ordering operator<=>(const Other& other) const {
+        return BasicString::Compare(other) <=> 0;
     }
 
-    String(const Strazzle::String::Reference& ref, std::size_t size = SIZE_MAX) : _data(_sso_buffer) {
-        Append(ref, size);
+    template<typename Other>
+        requires(!Strazzle::ByteRange<std::remove_cvref_t<Other>>)
+    std::strong_ordering operator<=>(Other&& other) const {
+        return BasicString::Compare(std::forward<Other>(other)) <=> 0;
     }
 
 #ifndef STRAZZLE_DEBUG_ALL_PUBLIC
   private:
 #endif
-    enum class Mode : uint8_t { NONE = 0, SMALL_STRING = 1, LARGE_STRING = 2 };
 
-    // Small String Optimization buffer
-    char _sso_buffer[Strazzle::SSO_SIZE];
-    // Pointer to the string buffer
-    char* _data = nullptr;
+    /**
+     * @brief Compares two SMALL_STRINGs. With the default 24 byte (or a 32 byte) SSO buffer the whole buffers are compared with two
+     *        loads each and the bytes behind the shorter length are masked out
+     * @return Less than, equal to or greater than 0 like memcmp
+     */
+    int CompareSmall(const BasicString& other) const {
+        std::size_t a_len = BasicString::Len();
+        std::size_t b_len = other.Len();
+        std::size_t len   = std::min(a_len, b_len);
+
+#ifdef __SSE2__
+        if constexpr(SSOSize == 24 || SSOSize == 32) {
+            const char* a = _sso_buffer;
+            const char* b = other._sso_buffer;
+
+            __m128i a_lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a));
+            __m128i b_lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b));
+            __m128i a_hi;
+            __m128i b_hi;
+
+            if constexpr(SSOSize == 24) {
+                a_hi = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(a + 16));
+                b_hi = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(b + 16));
+            } else {
+                a_hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + 16));
+                b_hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + 16));
+            }
 
-    // Length of the string
-    std::size_t _len = 0;
+            uint32_t equal = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(a_lo, b_lo))) |
+                             (static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(a_hi, b_hi))) << 16);
 
-    // Current mode of the string (should NEVER be NONE)
-    Strazzle::String::Mode _mode = Strazzle::String::Mode::SMALL_STRING;
+            uint32_t diff = ~equal & ((1U << len) - 1);
 
-    // Exponent that is reserved to
-    // allocated memory will ALWAYS be more or equal to this value
-    uint8_t _reserved_exp = 0;
+            if(diff != 0) {
+                std::size_t i = __builtin_ctz(diff);
 
-#ifdef NDEBUG
-    // Size of allocated memory
-    uint8_t _allocated_exp = 0;
-#endif
+                return static_cast<int>(static_cast<uint8_t>(a[i])) - static_cast<int>(static_cast<uint8_t>(b[i]));
+            }
 
-#ifndef STRAZZLE_DEBUG_ALL_PUBLIC
-  public:
+            return (a_len > b_len) - (a_len < b_len);
+        }
 #endif
+
+        int result = std::memcmp(_sso_buffer, other._sso_buffer, len);
+
+        if(result != 0) return result;
+
+        return (a_len > b_len) - (a_len < b_len);
+    }
+
     /**
-     * @brief Append a string to the end of the current string.
-     * @param str The string to append.
-     * @param size Maximum size to append (default is SIZE_MAX).
+     * @brief Checks if str points into the buffer of this string
      */
-    void Append(const char* str, std::size_t size = SIZE_MAX) {
-        size = std::min(strlen(str), size);
+    bool Owns(const char* str) const {
+        const char* data = BasicString::Data();
 
-        Strazzle::String::ResizeAllocation(size + _len + 1);
+        return !std::less<const char*>()(str, data) && std::less<const char*>()(str, data + BasicString::Len() + 1);
+    }
 
-        std::memcpy(_data + _len, str, size);
+    /**
+     * @brief Get the current mode of the string from the last byte
+     */
+    BasicString::Mode GetMode() const {
+        return static_cast<uint8_t>(_sso_buffer[SSOSize - 1]) & BasicString::LARGE_FLAG ? BasicString::Mode::LARGE_STRING
+                                                                                         : BasicString::Mode::SMALL_STRING;
+    }
 
-        _len = size + _len;
+    /**
+     * @brief Get a writable pointer to the current buffer
+     */
+    char* Buffer() {
+        return BasicString::GetMode() == BasicString::Mode::SMALL_STRING ? _sso_buffer : _large._data;
+    }
 
-        _data[_len] = '\0';
+    /**
+     * @brief Sets the length, the null terminator is written by the caller
+     *        A full SMALL_STRING has a spare capacity of 0, which is its null terminator
+     */
+    void SetLen(std::size_t len) {
+        if(BasicString::GetMode() == BasicString::Mode::SMALL_STRING) {
+            BasicString::SetSmallLen(len);
+        } else {
+            _large._len = len;
+        }
     }
 
     /**
-     * @brief String version of Append
-     * @param str The string to append.
-     * @param size Maximum size to append (default is SIZE_MAX).
+     * @brief Makes the string an empty SMALL_STRING
      */
-    void Append(const Strazzle::String& str, std::size_t size = SIZE_MAX) {
-        size = std::min(str._len, size);
+    void InitSmall() {
+        _sso_buffer[0] = '\0';
 
-        Strazzle::String::Append(str._data, size);
+        BasicString::SetSmallLen(0);
     }
 
     /**
-     * @brief Reference version of Append
-     * @param str The reference to append.
-     * @param size Maximum size to append (default is SIZE_MAX).
+     * @brief Sets the length of a string that is (about to be) a SMALL_STRING, overwrites the mode byte
      */
-    void Append(const Strazzle::String::Reference& ref, std::size_t size = SIZE_MAX) {
-        ref.CheckBounds();
+    void SetSmallLen(std::size_t len) {
+        _sso_buffer[SSOSize - 1] = static_cast<char>(SSOSize - 1 - len);
+    }
 
-        size = std::min(ref._len, size);
+    /**
+     * @brief Get the exponent that is reserved to, a SMALL_STRING has no reservation
+     */
+    uint8_t ReservedExp() const {
+        return BasicString::GetMode() == BasicString::Mode::LARGE_STRING ? _large._reserved_exp : 0;
+    }
+
+    /**
+     * @brief Resize the current allocation, handles changing mode
+     * @param size The size to alloc to (will allo to the next exp)
+     */
+    void ResizeAllocation(std::size_t size) {
+        std::size_t new_exp = BasicString::GetBufferExp(size);
+
+        if(new_exp < BasicString::ReservedExp()) {
+            Strazzle::_CountStat(Strazzle::Stat::RESERVE_HITS);
+            return;
+        }
+
+        BasicString::Mode new_mode = GetNewMode(size);
+
+        if(new_mode != BasicString::Mode::NONE) {
+            ChangeMode(new_mode, new_exp);
+            return;
+        }
 
-        Strazzle::String::Append(ref._base._data + ref._i, size);
+        if(BasicString::GetMode() == BasicString::Mode::LARGE_STRING && new_exp != _large._allocated_exp) {
+            BasicString::Realloc(new_exp);
+        }
     }
 
     /**
-     * @brief Insert a string at a specified position in the current string.
-     * @param str The string to insert.
-     * @param i The position to insert at.
-     * @param size Maximum size to insert (default is SIZE_MAX).
+     * @brief Reallocate memory to the given exponent.
+     * @param exp The new exponent for memory allocation.
      */
-    void Insert(const char* str, std::size_t i, std::size_t size = SIZE_MAX) {
-        if(i > _len) throw std::out_of_range("Index is out of bounds!\n << Strazzle::String::Insert()");
+    void Realloc(uint8_t exp) {
+        std::size_t byte_c = Strazzle::_ExpToNum(exp);
 
-        size = std::min(strlen(str), size);
+        if constexpr(Strazzle::ReallocatingAllocator<Allocator>) {
+            // The buffer is not shared, a reference count in front of it moves along
+            char* p = _allocator.Reallocate(_large._data - BasicString::HEADER_SIZE, Strazzle::_ExpToNum(_large._allocated_exp), byte_c);
+
+            Strazzle::_ProfileMove(_large._data, p + BasicString::HEADER_SIZE);
+
+            _large._data = p + BasicString::HEADER_SIZE;
+
+            Strazzle::_CountStat(Strazzle::Stat::REALLOCATIONS);
+        } else {
+            char* p = BasicString::AllocateBuffer(exp);
 
-        Strazzle::String::ResizeAllocation(size + _len + 1);
+            std::memcpy(p, _large._data, std::min(byte_c - BasicString::HEADER_SIZE, _large._len + 1));
 
-        std::memmove(_data + i + size, _data + i, _len - i);
+            Strazzle::_CountStat(Strazzle::Stat::BYTES_COPIED, std::min(byte_c - BasicString::HEADER_SIZE, _large._len + 1));
 
-        std::memcpy(_data + i, str, size);
+            BasicString::DeallocateBuffer(_large._data, _large._allocated_exp);
 
-        _len = size + _len;
+            _large._data = p;
+        }
+
+        if(exp > _large._allocated_exp) BasicString::CountGrowth(exp);
 
-        _data[_len] = '\0';
+        _large._allocated_exp = exp;
     }
 
     /**
-     * @brief String version of Insert
-     * @param str The string to insert.
-     * @param i The position to insert at.
-     * @param size Maximum size to insert (default is SIZE_MAX).
+     * @brief Returns the mode that needs to be changed to when allocating to the given size
+     * @param size The size we want to allocate to in the calling function
+     * @return Returns a BasicString::Mode this indicates the mode we need to change to
+     *         if we dont need to change the mode BasicString::Mode::NONE is returned
      */
-    void Insert(const Strazzle::String& str, std::size_t i, std::size_t size = SIZE_MAX) {
-        size = std::min(str._len, size);
+    inline BasicString::Mode GetNewMode(std::size_t size) {
+        BasicString::Mode mode = BasicString::GetMode();
 
-        Strazzle::String::Insert(str._data, i, size);
+        if(mode == BasicString::Mode::LARGE_STRING && size <= SSOSize) {
+            return BasicString::Mode::SMALL_STRING;
+        }
+
+        if(mode == BasicString::Mode::SMALL_STRING && size > SSOSize) {
+            return BasicString::Mode::LARGE_STRING;
+        }
+
+        return BasicString::Mode::NONE;
     }
 
     /**
-     * @brief Reference version of Insert
-     * @param ref The reference to insert.
-     * @param i The position to insert at.
-     * @param size Maximum size to insert (default is SIZE_MAX).
+     * @brief Changes the current mode to the given mode
+     * @param mode The mode that will be changed to if this is BasicString::Mode::NONE nothing will be done
+     * @param size The size that will be allocated to when changing to a large string
      */
-    void Insert(const Strazzle::String::Reference& ref, std::size_t i, std::size_t size = SIZE_MAX) {
-        ref.CheckBounds();
+    inline void ChangeMode(BasicString::Mode mode, uint8_t exp) {
+        switch(mode) {
+            case BasicString::Mode::LARGE_STRING:
+                BasicString::ToLarge(exp);
+                break;
+            case BasicString::Mode::SMALL_STRING:
+                BasicString::ToSmall();
+                break;
+            default:
+                break;
+        }
+    }
 
-        size = std::min(ref._len, size);
+    /**
+     * @brief Changes the mode to LARGE_STRING and hadles moving to the new buffer, the null terminator is moved along
+     * @param exp the exponent of the size the heap allocation will be
+     */
+    inline void ToLarge(uint8_t exp) {
+        std::size_t len = BasicString::Len();
+
+        char* p = BasicString::AllocateBuffer(exp);
 
-        Strazzle::String::Insert(ref._base._data + ref._i, i, size);
+        // The heap buffer is always larger than the SSO buffer, the bound lets GCC see that the copy fits into it (-Wstringop-overflow)
+        memcpy(p, _sso_buffer, std::min(len + 1, Strazzle::_ExpToNum(exp) - BasicString::HEADER_SIZE));
+
+        Strazzle::_ProfileModeChange(p);
+        Strazzle::_CountStat(Strazzle::Stat::SMALL_TO_LARGE);
+        Strazzle::_CountStat(Strazzle::Stat::BYTES_COPIED, len + 1);
+
+        // The SSO buffer is overwritten from here on
+        _large._data          = p;
+        _large._len           = len;
+        _large._allocated_exp = exp;
+        _large._reserved_exp  = 0;
+#ifdef STRAZZLE_LENGTH_HISTOGRAM
+        _large._grows = 0;
+#endif
+
+        _sso_buffer[SSOSize - 1] = static_cast<char>(BasicString::LARGE_FLAG);
     }
 
     /**
-     * @brief Erase a portion of the string starting from a specified position.
-     * @param i The starting position for erasing.
-     * @param size Maximum size to erase (default is SIZE_MAX).
+     * @brief Changes the mode to SMALL_STRING and hadles moving to the new buffer, keeps at most SSOSize - 1 bytes
      */
-    void Erase(std::size_t i, std::size_t size = SIZE_MAX) {
-        if(i >= _len) throw std::out_of_range("Index is out of bounds!\n << Strazzle::String::Erase()");
+    inline void ToSmall() {
+        char*       data = _large._data;
+        std::size_t len  = std::min(SSOSize - 1, _large._len);
+        uint8_t     exp  = _large._allocated_exp;
 
-        size = std::min(_len - i, size);
+        memcpy(_sso_buffer, data, len);
 
-        std::memmove(_data + i, _data + i + size, _len - i);
+        Strazzle::_ProfileModeChange(data);
+        Strazzle::_CountStat(Strazzle::Stat::LARGE_TO_SMALL);
+        Strazzle::_CountStat(Strazzle::Stat::BYTES_COPIED, len);
 
-        Strazzle::String::ResizeAllocation(_len - size);
+        BasicString::DeallocateBuffer(data, exp);
 
-        _len = _len - size;
+        _sso_buffer[len] = '\0';
 
-        _data[_len] = '\0';
+        BasicString::SetSmallLen(len);
     }
 
     /**
-     * @brief Resize the string to a specified size, filling with a character.
-     * @param size The new size of the string.
-     * @param fill The character to fill with (default is a space).
+     * @brief Frees the heap buffer if there is one, leaves the string in an invalid state
      */
-    void Resize(std::size_t size, char fill = ' ') {
-        Strazzle::String::ResizeAllocation(size + 1);
-
-        if(size > _len) {
-            std::memset(_data + _len, fill, size - _len);
+    inline void Free() {
+        if(BasicString::GetMode() == BasicString::Mode::LARGE_STRING) {
+            BasicString::DeallocateBuffer(_large._data, _large._allocated_exp);
         }
+    }
 
-        _len = size;
-
-        _data[_len] = '\0';
+    /**
+     * @brief Get the exponent of a heap allocation that holds size bytes
+     *        The reference count of a copy-on-write string is counted in, so its allocations stay in the size classes of eg the pool
+     */
+    static uint8_t GetBufferExp(std::size_t size) {
+        return Strazzle::_GetExponent(size + BasicString::HEADER_SIZE);
     }
 
     /**
-     * @brief Resize the string to a specified size, filling with a given string.
-     * @param size The new size of the string.
-     * @param fill The string to fill with (default is a space).
+     * @brief Allocates a heap buffer of 2^exp bytes, the buffer of a copy-on-write string starts with a reference count of 1
+     *        and has HEADER_SIZE bytes less for the string
      */
-    void Resize(std::size_t size, const char* fill) {
-        Strazzle::String::ResizeAllocation(size + 1);
+    char* AllocateBuffer(uint8_t exp) {
+        // A heap buffer is always larger than the SSO buffer, unlike _ExpToNum this never yields 0 so GCC doesn't see an empty buffer
+        std::size_t size = std::size_t(1) << exp;
 
-        if(size > _len) {
-            std::size_t str_len = strlen(fill);
+        char* p = _allocator.Allocate(size);
 
-            while(_len < size) {
-                std::memcpy(_data + _len, fill, _len + str_len <= size ? str_len : size - _len);
-                _len += str_len;
-            }
-        } else {
-            _len = size;
+        Strazzle::_CountStat(Strazzle::Stat::ALLOCATIONS);
+        Strazzle::_ProfileAllocate(p + BasicString::HEADER_SIZE, size);
+
+        if constexpr(Strazzle::CopyOnWriteAllocator<Allocator>) {
+            new(p) std::atomic<std::size_t>(1);
         }
 
-        _data[_len] = '\0';
+        return p + BasicString::HEADER_SIZE;
     }
 
     /**
-     * @brief Get a pointer to the C-style string.
-     * @return A pointer to the C-style string.
+     * @brief Drops a heap buffer, a shared buffer is only freed by its last owner
      */
-    const char* Cstr() {
-        return _data;
+    void DeallocateBuffer(char* data, uint8_t exp) {
+        if constexpr(Strazzle::CopyOnWriteAllocator<Allocator>) {
+            if(BasicString::RefCount(data).fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+        }
+
+        Strazzle::_ProfileFree(data);
+
+        _allocator.Deallocate(data - BasicString::HEADER_SIZE, Strazzle::_ExpToNum(exp));
+
+        Strazzle::_CountStat(Strazzle::Stat::DEALLOCATIONS);
     }
 
     /**
-     * @brief Get the length of the string.
-     * @return The length of the string.
+     * @brief Get the reference count in front of the heap buffer of a copy-on-write string
      */
-    std::size_t Len() {
-        return _len;
+    static std::atomic<std::size_t>& RefCount(char* data) {
+        return *reinterpret_cast<std::atomic<std::size_t>*>(data - BasicString::HEADER_SIZE);
     }
 
     /**
-     * @brief Returns a substr
-     * @param i The starting index
-     * @param size The lenght of the substr
+     * @brief Takes a share of the heap buffer of a copy-on-write LARGE_STRING, the current buffer has to be freed already
      */
-    Strazzle::String Substr(std::size_t i, std::size_t size = SIZE_MAX) {
-        if(i >= _len) throw std::out_of_range("Index is out of bounds! << Strazzle::String::Substr()\n");
+    void Share(const BasicString& str) {
+        BasicString::RefCount(str._large._data).fetch_add(1, std::memory_order_relaxed);
+
+        std::memcpy(_sso_buffer, str._sso_buffer, SSOSize);
 
-        size = std::min(_len - i, size);
+        // Reservations are not copied, same as for a deep copy
+        _large._reserved_exp = 0;
 
-        return Strazzle::String(_data + i, size);
+#ifdef STRAZZLE_CACHE_HASH
+        _hash.store(str._hash.load(std::memory_order_relaxed), std::memory_order_relaxed);
+#endif
     }
 
     /**
-     * @brief Returns a reference substr
-     * @param i The starting index
-     * @param size The lenght of the substr
+     * @brief Gives a copy-on-write LARGE_STRING a private copy of a shared heap buffer, called before every mutation
+     *        Does nothing for other strings
+     * @param size The size the mutation is about to allocate to, the copy is made at least this large so growing doesn't copy twice
      */
-    Strazzle::String::Reference RefSubstr(std::size_t i, std::size_t size = SIZE_MAX) {
-        if(i >= _len) throw std::out_of_range("Index is out of bounds! << Strazzle::String::RefSubstr()\n");
+    void MakeUnique(std::size_t size = 0) {
+        if constexpr(Strazzle::CopyOnWriteAllocator<Allocator>) {
+            if(BasicString::GetMode() == BasicString::Mode::LARGE_STRING &&
+               BasicString::RefCount(_large._data).load(std::memory_order_acquire) != 1) {
+                uint8_t exp = std::max(_large._allocated_exp, BasicString::GetBufferExp(size));
+
+                char* p = BasicString::AllocateBuffer(exp);
+
+                std::memcpy(p, _large._data, _large._len + 1);
 
-        size = std::min(_len - i, size);
+                Strazzle::_CountStat(Strazzle::Stat::BYTES_COPIED, _large._len + 1);
 
-        return Strazzle::String::Reference(*this, i, size);
+                BasicString::DeallocateBuffer(_large._data, _large._allocated_exp);
+
+                _large._data          = p;
+                _large._allocated_exp = exp;
+            }
+        }
     }
 
     /**
-     * @brief Reserves to the given size. Reserving means that there will never be less allocated than reserved
-     * @param size The size to reserve to
+     * @brief Takes over the contents of str and leaves it as an empty SMALL_STRING, the current buffer has to be freed already
+     *        Nothing points into the object so both modes are taken over with one copy of the buffer
+     * @param str The string to steal from
      */
-    void Reserve(std::size_t size) {
-        _reserved_exp = Strazzle::_GetExponent(size);
+    inline void Steal(BasicString& str) {
+        std::memcpy(_sso_buffer, str._sso_buffer, SSOSize);
 
-        uint8_t cur_exp = Strazzle::_GetExponent(_len);
+#ifdef STRAZZLE_CACHE_HASH
+        _hash.store(str._hash.load(std::memory_order_relaxed), std::memory_order_relaxed);
+#endif
 
-        if(cur_exp < _reserved_exp) {
-            Strazzle::String::ResizeAllocation(size);
-        }
+        str.InitSmall();
+        str.InvalidateHash();
+        str.BumpGeneration();
     }
 
-    bool operator==(Strazzle::String& other) {
-        return std::strcmp(other._data, _data) == 0;
+    /**
+     * @brief Drops the cached hash after a modification, does nothing if STRAZZLE_CACHE_HASH is not defined
+     */
+    inline void InvalidateHash() {
+#ifdef STRAZZLE_CACHE_HASH
+        _hash.store(0, std::memory_order_relaxed);
+#endif
     }
 
-#ifndef STRAZZLE_DEBUG_ALL_PUBLIC
-  private:
+    /**
+     * @brief Counts a growth of the heap buffer to exp, does nothing if STRAZZLE_LENGTH_HISTOGRAM is not defined
+     */
+    inline void CountGrowth([[maybe_unused]] uint8_t exp) {
+#ifdef STRAZZLE_LENGTH_HISTOGRAM
+        if(_large._grows != UINT8_MAX) _large._grows = _large._grows + 1;
+
+        Strazzle::_CountGrowth(_large._grows, Strazzle::_ExpToNum(exp));
 #endif
+    }
 
     /**
-     * @brief Resize the current allocation, handles changing mode
-     * @param size The size to alloc to (will allo to the next exp)
+     * @brief Invalidates every Reference into the string, does nothing if STRAZZLE_CHECK_REFERENCES is not defined
      */
-    void ResizeAllocation(std::size_t size) {
-        std::size_t new_exp = Strazzle::_GetExponent(size);
+    inline void BumpGeneration() {
+#ifdef STRAZZLE_CHECK_REFERENCES
+        _generation = _generation + 1;
+#endif
+    }
+};
 
-        if(new_exp < _reserved_exp) {
-            return;
-        }
+/**
+ * @brief Strings hold no pointer into themselves, they can be relocated with memcpy as long as their allocator can
+ */
+template<Strazzle::StringAllocator Allocator, std::size_t SSOSize>
+struct IsTriviallyRelocatable<Strazzle::BasicString<Allocator, SSOSize>> : std::is_trivially_copyable<Allocator> {};
 
-        Strazzle::String::Mode new_mode = GetNewMode(size);
+using String = Strazzle::BasicString<>;
 
-        if(new_mode != Strazzle::String::Mode::NONE) {
-            ChangeMode(new_mode, new_exp);
-            return;
-        }
+using CowString = Strazzle::BasicString<Strazzle::CopyOnWrite<Strazzle::MallocAllocator>>;
 
-        if(_mode == Strazzle::String::Mode::LARGE_STRING) {
-            Strazzle::String::Realloc(new_exp);
-        }
-    }
+/**
+ * @brief String with an SSO buffer of N bytes, eg SSOString<48> keeps identifiers of up to 47 bytes off the heap
+ */
+template<std::size_t N>
+using SSOString = Strazzle::BasicString<Strazzle::MallocAllocator, N>;
 
-    /**
-     * @brief Reallocate memory to the given exponent.
-     * @param exp The new exponent for memory allocation.
-     */
-    void Realloc(uint8_t exp) {
-#ifdef NDEBUG
-        _allocated_exp = exp;
+/**
+ * @brief Lazy concatenation of N pieces built by operator+, eg String s = a + b + "lit" + ref + '\n'
+ *        Only a pointer and a length are kept per piece, the bytes are copied once when the total length is known: converting to a
+ *        string allocates exactly once and Append grows the buffer once. The pieces are not owned so a Concat has to be consumed in
+ *        the expression that built it, like a Reference it must not outlive or be kept over a modification of its pieces
+ */
+template<std::size_t N>
+class Concat {
+#ifdef STRAZZLE_DEBUG_ALL_PUBLIC
+  public:
 #endif
+    template<std::size_t M>
+    friend class Concat;
 
-        std::size_t byte_c = Strazzle::_ExpToNum(exp);
+    template<Strazzle::StringAllocator Allocator, std::size_t SSOSize>
+    friend class BasicString;
 
-        char* p = static_cast<char*>(malloc(byte_c));
+#ifndef STRAZZLE_DEBUG_ALL_PUBLIC
+  private:
+#endif
+    // Bytes of every piece, not null terminated
+    const char* _data[N];
 
-        std::memcpy(p, _data, std::min(byte_c, _len));
+    // Length of every piece
+    std::size_t _lens[N];
 
-        free(_data);
+    // Total length of the pieces
+    std::size_t _len;
 
-        _data = p;
-    }
+#ifndef STRAZZLE_DEBUG_ALL_PUBLIC
+  public:
+#endif
+    // Number of pieces
+    static constexpr std::size_t PIECES = N;
 
     /**
-     * @brief Returns the mode that needs to be changed to when allocating to the given size
-     * @param size The size we want to allocate to in the calling function
-     * @return Returns a Strazzle::String::Mode this indicates the mode we need to change to
-     *         if we dont need to change the mode Strazzle::String::Mode::NONE is returned
+     * @brief A single piece
      */
-    inline Strazzle::String::Mode GetNewMode(std::size_t size) {
-        if(_len >= Strazzle::SSO_SIZE && size < Strazzle::SSO_SIZE) {
-            return Strazzle::String::Mode::SMALL_STRING;
-        }
-
-        if(_len < Strazzle::SSO_SIZE && size > Strazzle::SSO_SIZE) {
-            return Strazzle::String::Mode::LARGE_STRING;
-        }
-
-        return Strazzle::String::Mode::NONE;
+    Concat(std::pair<const char*, std::size_t> piece)
+        requires(N == 1)
+    {
+        _data[0] = piece.first;
+        _lens[0] = piece.second;
+        _len     = piece.second;
     }
 
     /**
-     * @brief Changes the current mode to the given mode
-     * @param mode The mode that will be changed to if this is Strazzle::String::Mode::NONE nothing will be done
-     * @param size The size that will be allocated to when changing to a large string
+     * @brief The pieces of l followed by the pieces of r
      */
-    inline void ChangeMode(Strazzle::String::Mode mode, uint8_t exp) {
-        switch(mode) {
-            case Strazzle::String::Mode::LARGE_STRING:
-                Strazzle::String::ToLarge(exp);
-                break;
-            case Strazzle::String::Mode::SMALL_STRING:
-                Strazzle::String::ToSmall();
-                break;
-            default:
-                break;
-        }
+    template<std::size_t L>
+    Concat(const Concat<L>& l, const Concat<N - L>& r) {
+        std::copy_n(l._data, L, _data);
+        std::copy_n(l._lens, L, _lens);
+        std::copy_n(r._data, N - L, _data + L);
+        std::copy_n(r._lens, N - L, _lens + L);
+
+        _len = l._len + r._len;
     }
 
     /**
-     * @brief Changes the mode to LARGE_STRING and hadles moving to the new buffer
-     * @param exp the exponent of the size the heap allocation will be
+     * @brief Get the total length of the concatenation
      */
-    inline void ToLarge(uint8_t exp) {
-#ifdef NDEBUG
-        _allocated_exp = exp;
-#endif
+    std::size_t Len() const {
+        return _len;
+    }
 
-        char* p = static_cast<char*>(malloc(Strazzle::_ExpToNum(exp)));
+    /**
+     * @brief Copies the pieces into a new string, the buffer is allocated once at its final size
+     */
+    template<Strazzle::StringAllocator Allocator, std::size_t SSOSize>
+    STRAZZLE_ENTRY_POINT operator Strazzle::BasicString<Allocator, SSOSize>() const {
+        Strazzle::_CallerScope caller(__builtin_return_address(0));
 
-        memcpy(p, _data, _len);
+        Strazzle::BasicString<Allocator, SSOSize> str;
 
-        _data = p;
+        str.Append(*this);
 
-        _mode = Strazzle::String::Mode::LARGE_STRING;
+        return str;
     }
+};
 
-    /**
-     * @brief Changes the mode to SMALL_STRING and hadles moving to the new buffer
-     */
-    inline void ToSmall() {
-#ifdef NDEBUG
-        _allocated_exp = 0;
-#endif
+template<typename T>
+struct _IsConcat : std::false_type {};
+
+template<std::size_t N>
+struct _IsConcat<Strazzle::Concat<N>> : std::true_type {};
+
+/**
+ * @brief Operands of operator+: C strings, string literals, char buffers, single chars, byte ranges and concatenations
+ */
+template<typename T>
+concept ConcatOperand = std::same_as<std::remove_cvref_t<T>, char> || Strazzle::_IsConcat<std::remove_cvref_t<T>>::value ||
+                        requires(T&& piece) { Strazzle::_Bytes(std::forward<T>(piece)); };
+
+/**
+ * @brief Get an operand of operator+ as a concatenation, a char is kept as a pointer to itself which lives until the end of the expression
+ */
+template<std::size_t N>
+const Strazzle::Concat<N>& _ToConcat(const Strazzle::Concat<N>& concat) {
+    return concat;
+}
+
+inline Strazzle::Concat<1> _ToConcat(const char& c) {
+    return Strazzle::Concat<1>({&c, 1});
+}
+
+template<typename T>
+    requires(!std::same_as<std::remove_cvref_t<T>, char> && !Strazzle::_IsConcat<std::remove_cvref_t<T>>::value)
+Strazzle::Concat<1> _ToConcat(T&& piece) {
+    return Strazzle::Concat<1>(Strazzle::_Bytes(std::forward<T>(piece)));
+}
 
-        _len = std::min(Strazzle::SSO_SIZE, _len);
+/**
+ * @brief Concatenates strings lazily, at least one operand has to be a string, a Reference or a concatenation
+ *        The result converts to a string or is passed to Append, no intermediate string is built
+ */
+template<Strazzle::ConcatOperand L, Strazzle::ConcatOperand R>
+    requires(Strazzle::ByteRange<std::remove_cvref_t<L>> || Strazzle::ByteRange<std::remove_cvref_t<R>> ||
+             Strazzle::_IsConcat<std::remove_cvref_t<L>>::value || Strazzle::_IsConcat<std::remove_cvref_t<R>>::value)
+auto operator+(L&& l, R&& r) {
+    const auto& lc = Strazzle::_ToConcat(std::forward<L>(l));
+    const auto& rc = Strazzle::_ToConcat(std::forward<R>(r));
+
+    return Strazzle::Concat<std::remove_cvref_t<decltype(lc)>::PIECES + std::remove_cvref_t<decltype(rc)>::PIECES>(lc, rc);
+}
 
-        memcpy(_sso_buffer, _data, _len);
+/**
+ * @brief Transparent hash for unordered containers of strings, lets them be searched with References and C strings without a copy
+ *        (use together with std::equal_to<>)
+ */
+struct StringHash {
+    using is_transparent = void;
 
-        free(_data);
+    template<Strazzle::ByteRange Range>
+    std::size_t operator()(const Range& range) const {
+        return range.Hash();
+    }
 
-        _mode = Strazzle::String::Mode::SMALL_STRING;
+    std::size_t operator()(const char* str) const {
+        return Strazzle::_Hash(str, strlen(str));
     }
 };
 
-} // namespace Strazzle
\ No newline at end of file
+} // namespace Strazzle
+
+template<Strazzle::StringAllocator Allocator, std::size_t SSOSize>
+struct std::hash<Strazzle::BasicString<Allocator, SSOSize>> {
+    std::size_t operator()(const Strazzle::BasicString<Allocator, SSOSize>& str) const {
+        return str.Hash();
+    }
+};
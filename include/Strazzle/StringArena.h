@@ -0,0 +1,239 @@
+#pragma once
+
+#include "Strazzle/String.h"
+
+#include <cinttypes>
+#include <cstdlib>
+#include <cstring>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace Strazzle {
+// Default size of the blocks of a Strazzle::StringArena
+const std::size_t ARENA_BLOCK_SIZE = 64 * 1024;
+
+class StringArena;
+
+/**
+ * @brief Allocator for Strazzle::BasicString that takes its buffers from a Strazzle::StringArena
+ *        Buffers are only released when the arena is reset or destroyed, the arena has to outlive the strings
+ */
+struct ArenaAllocator {
+    ArenaAllocator(Strazzle::StringArena& arena) : _arena(&arena) {
+    }
+
+    char* Allocate(std::size_t size);
+
+    char* Reallocate(char* p, std::size_t old_size, std::size_t new_size);
+
+    void Deallocate(char* p, std::size_t size);
+
+    // The arena the buffers are taken from
+    Strazzle::StringArena* _arena;
+};
+
+using ArenaString = Strazzle::BasicString<Strazzle::ArenaAllocator>;
+
+/**
+ * @brief Monotonic allocator, hands out buffers from large blocks by bumping a pointer and frees all of them at once
+ *        Intended for request scoped strings, not thread safe
+ */
+class StringArena {
+#ifdef STRAZZLE_DEBUG_ALL_PUBLIC
+  public:
+#endif
+    /**
+     * @brief Header of a block, the buffers follow it
+     */
+    struct Block {
+        Block*      _prev;
+        std::size_t _size;
+    };
+
+    // Current block, the others are reachable through _prev
+    Block* _block = nullptr;
+
+    // Next free byte and end of the current block
+    char* _cur = nullptr;
+    char* _end = nullptr;
+
+    // Size of new blocks
+    std::size_t _block_size;
+
+    // Bytes handed out since the last reset
+    std::size_t _used = 0;
+
+#ifndef STRAZZLE_DEBUG_ALL_PUBLIC
+  public:
+#endif
+    StringArena(std::size_t block_size = Strazzle::ARENA_BLOCK_SIZE) : _block_size(block_size) {
+    }
+
+    StringArena(const Strazzle::StringArena&)                        = delete;
+    Strazzle::StringArena& operator=(const Strazzle::StringArena&) = delete;
+
+    ~StringArena() {
+        Strazzle::StringArena::FreeBlocks(_block);
+    }
+
+    /**
+     * @brief Hands out a buffer of size bytes, buffers are not aligned
+     * @param size The size of the buffer
+     * @return The buffer
+     */
+    char* Allocate(std::size_t size) {
+        if(static_cast<std::size_t>(_end - _cur) < size) {
+            Strazzle::StringArena::NewBlock(size);
+        }
+
+        char* p = _cur;
+
+        _cur  = _cur + size;
+        _used = _used + size;
+
+        return p;
+    }
+
+    /**
+     * @brief Resizes a buffer, the last buffer that was handed out grows in place if the block has room
+     * @param p The buffer
+     * @param old_size The current size of the buffer
+     * @param new_size The new size of the buffer
+     * @return The (possibly moved) buffer
+     */
+    char* Reallocate(char* p, std::size_t old_size, std::size_t new_size) {
+        if(p + old_size == _cur && static_cast<std::size_t>(_end - p) >= new_size) {
+            _cur  = p + new_size;
+            _used = _used - old_size + new_size;
+
+            return p;
+        }
+
+        char* new_p = Strazzle::StringArena::Allocate(new_size);
+
+        std::memcpy(new_p, p, std::min(old_size, new_size));
+
+        return new_p;
+    }
+
+    /**
+     * @brief Gives a buffer back, only the last buffer that was handed out is actually reused
+     * @param p The buffer
+     * @param size The size of the buffer
+     */
+    void Deallocate(char* p, std::size_t size) {
+        if(p + size == _cur) {
+            _cur  = p;
+            _used = _used - size;
+        }
+    }
+
+    /**
+     * @brief Makes sure the next size bytes can be handed out without allocating a new block
+     * @param size The number of bytes
+     */
+    void Reserve(std::size_t size) {
+        if(static_cast<std::size_t>(_end - _cur) < size) {
+            Strazzle::StringArena::NewBlock(size);
+        }
+    }
+
+    /**
+     * @brief Frees every buffer at once, all strings using the arena become invalid. The current block is kept for reuse
+     */
+    void Reset() {
+        if(_block == nullptr) return;
+
+        Strazzle::StringArena::FreeBlocks(_block->_prev);
+
+        _block->_prev = nullptr;
+
+        _cur  = reinterpret_cast<char*>(_block + 1);
+        _used = 0;
+    }
+
+    /**
+     * @brief Get the number of bytes handed out since the last reset
+     */
+    std::size_t Used() const {
+        return _used;
+    }
+
+    /**
+     * @brief Builds strings from (pointer, length) pairs, the heap buffers of all of them are taken from one block
+     *        The strings are binary safe, the pointers don't need to be null terminated
+     * @param strs The (pointer, length) pairs
+     * @return The strings
+     */
+    std::vector<Strazzle::ArenaString> MakeStrings(std::span<const std::pair<const char*, std::size_t>> strs) {
+        std::size_t total = 0;
+
+        for(const auto& [str, len] : strs) {
+            if(len + 1 > Strazzle::SSO_SIZE) {
+                total = total + Strazzle::_ExpToNum(Strazzle::_GetExponent(len + 1));
+            }
+        }
+
+        Strazzle::StringArena::Reserve(total);
+
+        std::vector<Strazzle::ArenaString> result;
+
+        result.reserve(strs.size());
+
+        for(const auto& [str, len] : strs) {
+            Strazzle::ArenaString& arena_str = result.emplace_back(Strazzle::ArenaAllocator(*this));
+
+            arena_str.AppendRaw(str, len);
+        }
+
+        return result;
+    }
+
+#ifndef STRAZZLE_DEBUG_ALL_PUBLIC
+  private:
+#endif
+    /**
+     * @brief Starts a new block that has room for at least size bytes
+     */
+    void NewBlock(std::size_t size) {
+        std::size_t block_size = std::max(_block_size, size);
+
+        Block* block = static_cast<Block*>(malloc(sizeof(Block) + block_size));
+
+        block->_prev = _block;
+        block->_size = block_size;
+
+        _block = block;
+
+        _cur = reinterpret_cast<char*>(block + 1);
+        _end = _cur + block_size;
+    }
+
+    /**
+     * @brief Frees block and all blocks before it
+     */
+    static void FreeBlocks(Block* block) {
+        while(block != nullptr) {
+            Block* prev = block->_prev;
+
+            free(block);
+
+            block = prev;
+        }
+    }
+};
+
+inline char* ArenaAllocator::Allocate(std::size_t size) {
+    return _arena->Allocate(size);
+}
+
+inline char* ArenaAllocator::Reallocate(char* p, std::size_t old_size, std::size_t new_size) {
+    return _arena->Reallocate(p, old_size, new_size);
+}
+
+inline void ArenaAllocator::Deallocate(char* p, std::size_t size) {
+    _arena->Deallocate(p, size);
+}
+
+} // namespace Strazzle
@@ -0,0 +1,332 @@
+#pragma once
+
+#include "Strazzle/Hash.h"
+#include "Strazzle/String.h"
+#include "Strazzle/StringArena.h"
+
+#include <atomic>
+#include <cinttypes>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+namespace Strazzle {
+// Number of shards of a Strazzle::StringInterner, a power of two. Each has its own lock for inserts
+const std::size_t INTERN_SHARD_COUNT = 64;
+// Initial number of slots of the table of a shard, a power of two
+const std::size_t INTERN_TABLE_SIZE = 16;
+// Exponent of the size of the first chunk of atom entries, chunk k holds 2^(k + INTERN_CHUNK_EXP) entries
+const uint8_t INTERN_CHUNK_EXP = 6;
+
+/**
+ * @brief Id of an interned string, equal atoms of one Strazzle::StringInterner mean equal strings
+ */
+struct Atom {
+    uint32_t id;
+
+    auto operator<=>(const Strazzle::Atom&) const = default;
+};
+
+/**
+ * @brief Maps strings to stable 32 bit atoms, every distinct string is stored once
+ *        Lookups of strings that are already interned are lock-free (one hash, a probe and a compare) and never copy,
+ *        inserts take the lock of one of Strazzle::INTERN_SHARD_COUNT shards. Atoms and their strings stay valid until the interner
+ *        is destroyed
+ */
+class StringInterner {
+#ifdef STRAZZLE_DEBUG_ALL_PUBLIC
+  public:
+#endif
+    /**
+     * @brief An interned string, the bytes are null terminated
+     */
+    struct Entry {
+        const char* _data;
+        std::size_t _len;
+    };
+
+    /**
+     * @brief Open addressing table of a shard. A slot is (tag << 32) | (atom + 1), 0 is empty. Tables are only replaced, never
+     *        freed while the interner lives, so readers may still probe a table that was grown
+     */
+    struct Table {
+        Table(std::size_t size) : _mask(size - 1), _slots(new std::atomic<uint64_t>[size]) {
+            for(std::size_t i = 0; i < size; i++) {
+                _slots[i].store(0, std::memory_order_relaxed);
+            }
+        }
+
+        std::size_t                             _mask;
+        std::unique_ptr<std::atomic<uint64_t>[]> _slots;
+    };
+
+    /**
+     * @brief A shard, aligned so the locks of neighbouring shards don't share a cache line
+     */
+    struct alignas(64) Shard {
+        // Guards everything but _table for readers
+        std::mutex _mutex;
+
+        // Current table
+        std::atomic<Table*> _table = nullptr;
+
+        // Number of strings in the shard
+        std::size_t _count = 0;
+
+        // Current and replaced tables
+        std::vector<std::unique_ptr<Table>> _tables;
+
+        // Bytes of the strings of the shard
+        Strazzle::StringArena _arena;
+    };
+
+    Shard _shards[Strazzle::INTERN_SHARD_COUNT];
+
+    // Entries of all atoms in chunks of growing size so they never move, chunk k starts at atom 2^(k + INTERN_CHUNK_EXP) - 2^INTERN_CHUNK_EXP
+    std::atomic<Entry*> _chunks[33 - Strazzle::INTERN_CHUNK_EXP] = {};
+
+    // Next atom id
+    std::atomic<uint32_t> _next_id = 0;
+
+#ifndef STRAZZLE_DEBUG_ALL_PUBLIC
+  public:
+#endif
+    StringInterner() {
+        for(Shard& shard : _shards) {
+            shard._tables.push_back(std::make_unique<Table>(Strazzle::INTERN_TABLE_SIZE));
+            shard._table.store(shard._tables.back().get(), std::memory_order_relaxed);
+        }
+    }
+
+    StringInterner(const Strazzle::StringInterner&)                        = delete;
+    Strazzle::StringInterner& operator=(const Strazzle::StringInterner&) = delete;
+
+    ~StringInterner() {
+        for(std::atomic<Entry*>& chunk : _chunks) {
+            delete[] chunk.load(std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Get the atom of a string, the string is copied into the interner the first time it is seen
+     * @param str The bytes, binary safe
+     * @param size The number of bytes
+     * @return The atom
+     */
+    Strazzle::Atom Intern(const char* str, std::size_t size) {
+        uint64_t hash = Strazzle::_Hash(str, size);
+
+        std::optional<Strazzle::Atom> atom = Strazzle::StringInterner::Find(str, size, hash);
+
+        if(atom.has_value()) return *atom;
+
+        return Strazzle::StringInterner::Insert(str, size, hash);
+    }
+
+    /**
+     * @brief C string version of Intern
+     */
+    Strazzle::Atom Intern(const char* str) {
+        return Strazzle::StringInterner::Intern(str, strlen(str));
+    }
+
+    /**
+     * @brief String and Reference version of Intern, a string that is already interned is not copied
+     */
+    template<Strazzle::ByteRange Range>
+    Strazzle::Atom Intern(const Range& range) {
+        return Strazzle::StringInterner::Intern(range.Data(), range.Len());
+    }
+
+    /**
+     * @brief Looks a string up without interning it, lock-free
+     * @param str The bytes, binary safe
+     * @param size The number of bytes
+     * @return The atom or nothing if the string was never interned
+     */
+    std::optional<Strazzle::Atom> Find(const char* str, std::size_t size) const {
+        return Strazzle::StringInterner::Find(str, size, Strazzle::_Hash(str, size));
+    }
+
+    std::optional<Strazzle::Atom> Find(const char* str) const {
+        return Strazzle::StringInterner::Find(str, strlen(str));
+    }
+
+    template<Strazzle::ByteRange Range>
+    std::optional<Strazzle::Atom> Find(const Range& range) const {
+        return Strazzle::StringInterner::Find(range.Data(), range.Len());
+    }
+
+    /**
+     * @brief Get the null terminated bytes of an atom
+     */
+    const char* Cstr(Strazzle::Atom atom) const {
+        return Strazzle::StringInterner::GetEntry(atom.id)._data;
+    }
+
+    /**
+     * @brief Get the length of the string of an atom
+     */
+    std::size_t Len(Strazzle::Atom atom) const {
+        return Strazzle::StringInterner::GetEntry(atom.id)._len;
+    }
+
+    /**
+     * @brief Get the number of interned strings
+     */
+    std::size_t Size() const {
+        return _next_id.load(std::memory_order_relaxed);
+    }
+
+#ifndef STRAZZLE_DEBUG_ALL_PUBLIC
+  private:
+#endif
+    /**
+     * @brief Get the shard of a hash, the low bits are the tag so the shard is taken from the high bits
+     */
+    static std::size_t ShardIndex(uint64_t hash) {
+        return (hash >> 32) & (Strazzle::INTERN_SHARD_COUNT - 1);
+    }
+
+    /**
+     * @brief Gets the chunk and the index in it of an atom
+     */
+    static std::pair<std::size_t, std::size_t> Locate(uint32_t id) {
+        uint64_t v   = static_cast<uint64_t>(id) + (1ULL << Strazzle::INTERN_CHUNK_EXP);
+        uint8_t  exp = 63 - __builtin_clzll(v);
+
+        return {exp - Strazzle::INTERN_CHUNK_EXP, v - (1ULL << exp)};
+    }
+
+    const Entry& GetEntry(uint32_t id) const {
+        auto [chunk, i] = Strazzle::StringInterner::Locate(id);
+
+        return _chunks[chunk].load(std::memory_order_acquire)[i];
+    }
+
+    /**
+     * @brief Probes the table of the shard of hash, lock-free
+     */
+    std::optional<Strazzle::Atom> Find(const char* str, std::size_t size, uint64_t hash) const {
+        const Shard& shard = _shards[Strazzle::StringInterner::ShardIndex(hash)];
+        const Table* table = shard._table.load(std::memory_order_acquire);
+
+        uint32_t tag = static_cast<uint32_t>(hash);
+
+        for(std::size_t i = tag & table->_mask;; i = (i + 1) & table->_mask) {
+            uint64_t slot = table->_slots[i].load(std::memory_order_acquire);
+
+            if(slot == 0) return std::nullopt;
+
+            if(static_cast<uint32_t>(slot >> 32) != tag) continue;
+
+            uint32_t     id    = static_cast<uint32_t>(slot) - 1;
+            const Entry& entry = Strazzle::StringInterner::GetEntry(id);
+
+            if(entry._len == size && std::memcmp(entry._data, str, size) == 0) return Strazzle::Atom{id};
+        }
+    }
+
+    /**
+     * @brief Interns a string that was not found, under the lock of its shard
+     */
+    Strazzle::Atom Insert(const char* str, std::size_t size, uint64_t hash) {
+        Shard& shard = _shards[Strazzle::StringInterner::ShardIndex(hash)];
+
+        std::lock_guard lock(shard._mutex);
+
+        // Another thread may have inserted it since the lock-free probe
+        std::optional<Strazzle::Atom> atom = Strazzle::StringInterner::Find(str, size, hash);
+
+        if(atom.has_value()) return *atom;
+
+        uint32_t id = _next_id.load(std::memory_order_relaxed);
+
+        do {
+            if(id == UINT32_MAX) throw std::length_error("Out of atoms! << Strazzle::StringInterner::Intern()\n");
+        } while(!_next_id.compare_exchange_weak(id, id + 1, std::memory_order_relaxed));
+
+        char* data = shard._arena.Allocate(size + 1);
+
+        std::memcpy(data, str, size);
+
+        data[size] = '\0';
+
+        auto [chunk, i] = Strazzle::StringInterner::Locate(id);
+
+        Strazzle::StringInterner::GetChunk(chunk)[i] = Entry{data, size};
+
+        if((shard._count + 1) * 2 > shard._table.load(std::memory_order_relaxed)->_mask + 1) {
+            Strazzle::StringInterner::Grow(shard);
+        }
+
+        Strazzle::StringInterner::Place(*shard._table.load(std::memory_order_relaxed), (hash << 32) | (static_cast<uint64_t>(id) + 1));
+
+        shard._count = shard._count + 1;
+
+        return Strazzle::Atom{id};
+    }
+
+    /**
+     * @brief Get a chunk of entries, allocates it if it does not exist yet
+     */
+    Entry* GetChunk(std::size_t chunk) {
+        Entry* entries = _chunks[chunk].load(std::memory_order_acquire);
+
+        if(entries != nullptr) return entries;
+
+        Entry* new_entries = new Entry[std::size_t(1) << (chunk + Strazzle::INTERN_CHUNK_EXP)];
+
+        // Entries of a chunk may be written by different shards, only one allocation wins
+        if(_chunks[chunk].compare_exchange_strong(entries, new_entries, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            return new_entries;
+        }
+
+        delete[] new_entries;
+
+        return entries;
+    }
+
+    /**
+     * @brief Stores a slot in the first empty slot of its probe sequence, publishing the entry of the atom
+     */
+    static void Place(Table& table, uint64_t slot) {
+        std::size_t i = static_cast<uint32_t>(slot >> 32) & table._mask;
+
+        while(table._slots[i].load(std::memory_order_relaxed) != 0) {
+            i = (i + 1) & table._mask;
+        }
+
+        table._slots[i].store(slot, std::memory_order_release);
+    }
+
+    /**
+     * @brief Replaces the table of a shard with one twice the size, the old table stays alive for readers that still probe it
+     */
+    static void Grow(Shard& shard) {
+        Table* table = shard._table.load(std::memory_order_relaxed);
+
+        std::unique_ptr<Table> new_table = std::make_unique<Table>((table->_mask + 1) * 2);
+
+        for(std::size_t i = 0; i <= table->_mask; i++) {
+            uint64_t slot = table->_slots[i].load(std::memory_order_relaxed);
+
+            if(slot != 0) Strazzle::StringInterner::Place(*new_table, slot);
+        }
+
+        shard._table.store(new_table.get(), std::memory_order_release);
+        shard._tables.push_back(std::move(new_table));
+    }
+};
+
+} // namespace Strazzle
+
+template<>
+struct std::hash<Strazzle::Atom> {
+    std::size_t operator()(Strazzle::Atom atom) const {
+        return atom.id;
+    }
+};
@@ -0,0 +1,405 @@
+#pragma once
+
+#include "Strazzle/String.h"
+
+#include <atomic>
+#include <cinttypes>
+#include <cstdlib>
+#include <mutex>
+#include <vector>
+
+namespace Strazzle {
+// Smallest exponent that is pooled, a free buffer has to hold a Strazzle::StringPool::Block
+const uint8_t POOL_MIN_EXP = 5;
+// Largest exponent that is pooled, larger buffers go straight to malloc
+const uint8_t POOL_MAX_EXP = 20;
+// Number of free buffers per exponent a thread keeps, half of them are returned to the shared free list when it is full
+const std::size_t POOL_CACHE_SIZE = 64;
+
+/**
+ * @brief Pool of heap buffers segregated by their power of two size class (the exponent used by Strazzle::BasicString)
+ *        Every thread keeps a cache of free buffers per exponent, full caches return batches to a shared free list from which
+ *        other threads refill one batch at a time. Buffers may be freed by any thread, also after the cache of the thread was
+ *        destroyed (eg by static or thread_local strings), those go straight to the shared free list
+ */
+class StringPool {
+  public:
+    /**
+     * @brief Allocation statistics of the pool, summed over all threads
+     */
+    struct Stats {
+        // Allocations served from the cache of the allocating thread
+        uint64_t cache_hits = 0;
+        // Allocations served from the shared free list
+        uint64_t shared_hits = 0;
+        // Allocations that had to go to malloc (including sizes that are not pooled)
+        uint64_t misses = 0;
+        // Deallocations
+        uint64_t frees = 0;
+
+        /**
+         * @brief Get the number of allocations
+         */
+        uint64_t Allocations() const {
+            return cache_hits + shared_hits + misses;
+        }
+
+        /**
+         * @brief Get the fraction of allocations that did not go to malloc
+         */
+        double HitRate() const {
+            return Allocations() != 0 ? static_cast<double>(cache_hits + shared_hits) / Allocations() : 0.0;
+        }
+    };
+
+#ifndef STRAZZLE_DEBUG_ALL_PUBLIC
+  private:
+#endif
+    /**
+     * @brief A free buffer, the batch fields are only valid in the first buffer of a batch on the shared free list
+     */
+    struct Block {
+        Block* _next;
+
+        // Next batch on the shared free list
+        Block* _next_batch;
+        // Last buffer of the batch
+        Block* _tail;
+        // Number of buffers in the batch
+        std::size_t _count;
+    };
+
+    /**
+     * @brief Free buffers of one exponent of a thread
+     */
+    struct CacheList {
+        Block*      _head  = nullptr;
+        std::size_t _count = 0;
+    };
+
+    struct ThreadCache;
+
+    /**
+     * @brief State shared by all threads, never destroyed so threads that exit late can still return their buffers
+     */
+    struct Shared {
+        // Stacks of batches per exponent, pushed lock-free
+        std::atomic<Block*> _batches[Strazzle::POOL_MAX_EXP + 1] = {};
+
+        // Serialize the pops of each stack, so a batch can't be popped and pushed again while another pop reads it (ABA)
+        std::mutex _pop_mutexes[Strazzle::POOL_MAX_EXP + 1];
+
+        // Guards _caches and _retired
+        std::mutex                 _mutex;
+        std::vector<ThreadCache*>  _caches;
+        Strazzle::StringPool::Stats _retired;
+    };
+
+    /**
+     * @brief Free buffers and counters of a thread, the counters are only written by the owning thread
+     */
+    struct ThreadCache {
+        ThreadCache() {
+            Strazzle::StringPool::Shared& shared = Strazzle::StringPool::GetShared();
+
+            std::lock_guard lock(shared._mutex);
+
+            shared._caches.push_back(this);
+        }
+
+        ~ThreadCache() {
+            Strazzle::StringPool::CacheDestroyed() = true;
+
+            for(uint8_t exp = Strazzle::POOL_MIN_EXP; exp <= Strazzle::POOL_MAX_EXP; exp++) {
+                Strazzle::StringPool::Flush(_lists[exp], exp, _lists[exp]._count);
+            }
+
+            Strazzle::StringPool::Shared& shared = Strazzle::StringPool::GetShared();
+
+            std::lock_guard lock(shared._mutex);
+
+            Strazzle::StringPool::AddStats(shared._retired, *this);
+
+            std::erase(shared._caches, this);
+        }
+
+        CacheList _lists[Strazzle::POOL_MAX_EXP + 1];
+
+        std::atomic<uint64_t> _cache_hits  = 0;
+        std::atomic<uint64_t> _shared_hits = 0;
+        std::atomic<uint64_t> _misses      = 0;
+        std::atomic<uint64_t> _frees       = 0;
+    };
+
+#ifndef STRAZZLE_DEBUG_ALL_PUBLIC
+  public:
+#endif
+    /**
+     * @brief Allocates a buffer of at least size bytes
+     * @param size The size of the buffer, sizes are rounded up to the next power of two
+     * @return The buffer
+     */
+    static char* Allocate(std::size_t size) {
+        uint8_t exp = Strazzle::_GetExponent(size);
+
+        ThreadCache* cache = Strazzle::StringPool::GetCache();
+
+        if(cache == nullptr) {
+            Strazzle::StringPool::CountRetired(&Strazzle::StringPool::Stats::misses);
+
+            return static_cast<char*>(malloc(exp < Strazzle::POOL_MIN_EXP || exp > Strazzle::POOL_MAX_EXP ? size : Strazzle::_ExpToNum(exp)));
+        }
+
+        if(exp < Strazzle::POOL_MIN_EXP || exp > Strazzle::POOL_MAX_EXP) {
+            Strazzle::StringPool::Increment(cache->_misses);
+
+            return static_cast<char*>(malloc(size));
+        }
+
+        CacheList& list = cache->_lists[exp];
+
+        if(list._head != nullptr) {
+            Strazzle::StringPool::Increment(cache->_cache_hits);
+
+            return Strazzle::StringPool::Pop(list);
+        }
+
+        if(Strazzle::StringPool::Refill(list, exp)) {
+            Strazzle::StringPool::Increment(cache->_shared_hits);
+
+            return Strazzle::StringPool::Pop(list);
+        }
+
+        Strazzle::StringPool::Increment(cache->_misses);
+
+        return static_cast<char*>(malloc(Strazzle::_ExpToNum(exp)));
+    }
+
+    /**
+     * @brief Returns a buffer to the pool, may be called from any thread
+     * @param p The buffer
+     * @param size The size that was passed to Allocate
+     */
+    static void Deallocate(char* p, std::size_t size) {
+        uint8_t exp = Strazzle::_GetExponent(size);
+
+        ThreadCache* cache = Strazzle::StringPool::GetCache();
+
+        if(cache == nullptr) {
+            Strazzle::StringPool::CountRetired(&Strazzle::StringPool::Stats::frees);
+        } else {
+            Strazzle::StringPool::Increment(cache->_frees);
+        }
+
+        if(exp < Strazzle::POOL_MIN_EXP || exp > Strazzle::POOL_MAX_EXP) {
+            free(p);
+            return;
+        }
+
+        Block* block = reinterpret_cast<Block*>(p);
+
+        // Without a cache the buffer is returned as a batch of its own
+        if(cache == nullptr) {
+            Strazzle::StringPool::PushBatch(exp, block, block, 1);
+            return;
+        }
+
+        CacheList& list = cache->_lists[exp];
+
+        block->_next = list._head;
+
+        list._head  = block;
+        list._count = list._count + 1;
+
+        if(list._count > Strazzle::POOL_CACHE_SIZE) {
+            Strazzle::StringPool::Flush(list, exp, Strazzle::POOL_CACHE_SIZE / 2);
+        }
+    }
+
+    /**
+     * @brief Get the statistics of all threads, including threads that already exited
+     * @return The statistics
+     */
+    static Strazzle::StringPool::Stats GetStats() {
+        Strazzle::StringPool::Shared& shared = Strazzle::StringPool::GetShared();
+
+        std::lock_guard lock(shared._mutex);
+
+        Strazzle::StringPool::Stats stats = shared._retired;
+
+        for(ThreadCache* cache : shared._caches) {
+            Strazzle::StringPool::AddStats(stats, *cache);
+        }
+
+        return stats;
+    }
+
+    /**
+     * @brief Frees the buffers cached by the calling thread and the buffers on the shared free list
+     */
+    static void Trim() {
+        ThreadCache* cache = Strazzle::StringPool::GetCache();
+
+        for(uint8_t exp = Strazzle::POOL_MIN_EXP; exp <= Strazzle::POOL_MAX_EXP; exp++) {
+            CacheList  own;
+            CacheList& list = cache != nullptr ? cache->_lists[exp] : own;
+
+            while(Strazzle::StringPool::Refill(list, exp)) {
+            }
+
+            while(list._head != nullptr) {
+                free(Strazzle::StringPool::Pop(list));
+            }
+        }
+    }
+
+#ifndef STRAZZLE_DEBUG_ALL_PUBLIC
+  private:
+#endif
+    static Strazzle::StringPool::Shared& GetShared() {
+        static Strazzle::StringPool::Shared& shared = *new Strazzle::StringPool::Shared();
+
+        return shared;
+    }
+
+    /**
+     * @brief Set once the cache of the calling thread is destroyed, trivially destructible so it stays readable until the thread exits
+     */
+    static bool& CacheDestroyed() {
+        thread_local bool destroyed = false;
+
+        return destroyed;
+    }
+
+    /**
+     * @brief Get the cache of the calling thread
+     * @return The cache or nullptr if it was destroyed already, ie a static or thread_local string is freed late
+     */
+    static ThreadCache* GetCache() {
+        if(Strazzle::StringPool::CacheDestroyed()) return nullptr;
+
+        thread_local ThreadCache cache;
+
+        return &cache;
+    }
+
+    /**
+     * @brief Increments a counter that is only written by the calling thread, no atomic read-modify-write needed
+     */
+    static void Increment(std::atomic<uint64_t>& counter) {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Counts an allocation or deallocation of a thread without a cache in the statistics of the exited threads
+     */
+    static void CountRetired(uint64_t Strazzle::StringPool::Stats::*counter) {
+        Strazzle::StringPool::Shared& shared = Strazzle::StringPool::GetShared();
+
+        std::lock_guard lock(shared._mutex);
+
+        shared._retired.*counter = shared._retired.*counter + 1;
+    }
+
+    static void AddStats(Strazzle::StringPool::Stats& stats, const ThreadCache& cache) {
+        stats.cache_hits  = stats.cache_hits + cache._cache_hits.load(std::memory_order_relaxed);
+        stats.shared_hits = stats.shared_hits + cache._shared_hits.load(std::memory_order_relaxed);
+        stats.misses      = stats.misses + cache._misses.load(std::memory_order_relaxed);
+        stats.frees       = stats.frees + cache._frees.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Pops a buffer from a non empty list
+     */
+    static char* Pop(CacheList& list) {
+        Block* block = list._head;
+
+        list._head  = block->_next;
+        list._count = list._count - 1;
+
+        return reinterpret_cast<char*>(block);
+    }
+
+    /**
+     * @brief Moves count buffers of list to the shared free list as one batch
+     */
+    static void Flush(CacheList& list, uint8_t exp, std::size_t count) {
+        if(count == 0) return;
+
+        Block* first = list._head;
+        Block* last  = first;
+
+        for(std::size_t i = 1; i < count; i++) {
+            last = last->_next;
+        }
+
+        list._head  = last->_next;
+        list._count = list._count - count;
+
+        Strazzle::StringPool::PushBatch(exp, first, last, count);
+    }
+
+    /**
+     * @brief Pushes the count buffers from first to last onto the shared free list as one batch, lock-free
+     */
+    static void PushBatch(uint8_t exp, Block* first, Block* last, std::size_t count) {
+        last->_next = nullptr;
+
+        first->_tail  = last;
+        first->_count = count;
+
+        std::atomic<Block*>& batches = Strazzle::StringPool::GetShared()._batches[exp];
+
+        first->_next_batch = batches.load(std::memory_order_relaxed);
+
+        while(!batches.compare_exchange_weak(first->_next_batch, first, std::memory_order_release, std::memory_order_relaxed)) {
+        }
+    }
+
+    /**
+     * @brief Takes one batch of the shared free list into list, the other batches are left for the other threads
+     * @return If any buffers were taken
+     */
+    static bool Refill(CacheList& list, uint8_t exp) {
+        Strazzle::StringPool::Shared& shared = Strazzle::StringPool::GetShared();
+
+        std::atomic<Block*>& batches = shared._batches[exp];
+
+        if(batches.load(std::memory_order_relaxed) == nullptr) return false;
+
+        std::lock_guard lock(shared._pop_mutexes[exp]);
+
+        Block* batch = batches.load(std::memory_order_acquire);
+
+        // Only pushes run concurrently, they leave batch and its next batch untouched
+        while(batch != nullptr &&
+              !batches.compare_exchange_weak(batch, batch->_next_batch, std::memory_order_acquire, std::memory_order_acquire)) {
+        }
+
+        if(batch == nullptr) return false;
+
+        batch->_tail->_next = list._head;
+
+        list._head  = batch;
+        list._count = list._count + batch->_count;
+
+        return true;
+    }
+};
+
+/**
+ * @brief Allocator for Strazzle::BasicString that uses the Strazzle::StringPool
+ */
+struct PoolAllocator {
+    char* Allocate(std::size_t size) {
+        return Strazzle::StringPool::Allocate(size);
+    }
+
+    void Deallocate(char* p, std::size_t size) {
+        Strazzle::StringPool::Deallocate(p, size);
+    }
+};
+
+using PooledString = Strazzle::BasicString<Strazzle::PoolAllocator>;
+
+} // namespace Strazzle